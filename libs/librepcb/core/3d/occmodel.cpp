@@ -96,6 +96,17 @@ struct OccModel::Data {
 
 #if USE_OPENCASCADE
 
+/**
+ * Mutex to serialize accesses to global OpenCascade state which is not
+ * thread-safe, i.e. creating or closing documents with the XCAF application,
+ * initializing STEP readers and writers (global Interface_Static parameters),
+ * writing STEP files and parsing STEP files with OpenCascade < 7.6.
+ */
+static QMutex& getGlobalMutex() noexcept {
+  static QMutex mutex;
+  return mutex;
+}
+
 static bool tryGetColor(Handle(XCAFDoc_ColorTool) colorTool,
                         const TopoDS_Shape& shape, Quantity_Color& color) {
   return colorTool->GetColor(shape, XCAFDoc_ColorSurf, color) ||
@@ -417,6 +428,7 @@ void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
 void OccModel::saveAsStep(const QString& name, const FilePath& fp) const {
 #if USE_OPENCASCADE
   try {
+    QMutexLocker lock(&getGlobalMutex());
     STEPCAFControl_Writer writer;
     writer.SetColorMode(Standard_True);
     writer.SetNameMode(Standard_True);
@@ -507,9 +519,12 @@ std::unique_ptr<OccModel> OccModel::createAssembly(const QString& name) {
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
     Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    {
+      QMutexLocker lock(&getGlobalMutex());
+      Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
+      app->NewDocument("MDTV-XCAF", doc);
+    }
     Handle(XCAFDoc_ShapeTool) shapeTool =
         XCAFDoc_DocumentTool::ShapeTool(doc->Main());
     TDF_Label label = shapeTool->NewShape();
@@ -541,9 +556,12 @@ std::unique_ptr<OccModel> OccModel::createBoard(const librepcb::Path& outline,
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
     Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    {
+      QMutexLocker lock(&getGlobalMutex());
+      Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
+      app->NewDocument("MDTV-XCAF", doc);
+    }
     Handle(XCAFDoc_ShapeTool) shapeTool =
         XCAFDoc_DocumentTool::ShapeTool(doc->Main());
 
@@ -617,6 +635,9 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
   try {
     initOpenCascade();
 
+    // Creating the document modifies the global XCAF application, and the
+    // reader constructor initializes the global STEP controller parameters.
+    QMutexLocker lock(&getGlobalMutex());
     Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
     Handle(TDocStd_Document) doc;
     app->NewDocument("MDTV-XCAF", doc);
@@ -624,6 +645,13 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
     stepReader.SetColorMode(Standard_True);
     stepReader.SetNameMode(Standard_False);
     stepReader.SetLayerMode(Standard_False);
+#if OCC_VERSION_HEX >= 0x070600
+    // Since OpenCascade 7.6, the STEP parser is reentrant and the transfer
+    // into our own document only reads global parameters, so the expensive
+    // part of loading runs in parallel. Older versions parse STEP files with
+    // global state, thus the lock is kept there.
+    lock.unlock();
+#endif
 
     STEPControl_Reader& reader = stepReader.ChangeReader();
 #if OCC_VERSION_HEX >= 0x070500
@@ -640,6 +668,7 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
     }
 
     if (!stepReader.Transfer(doc)) {
+      lock.relock();  // Closing modifies the global XCAF application.
       doc->Close();
       throw RuntimeError(__FILE__, __LINE__);
     }
@@ -47,6 +47,12 @@ class Transform;
 
 /**
  * @brief 3D model implemented with OpenCascade
+ *
+ * @note Creating, loading and saving models is thread-safe. Accesses to
+ *       global OpenCascade state (creating documents, saving STEP files and,
+ *       with OpenCascade < 7.6, parsing STEP files) are serialized internally.
+ *       Parsing (with OpenCascade >= 7.6), transferring and tesselating
+ *       different models runs in parallel.
  */
 class OccModel final {
   Q_DECLARE_TR_FUNCTIONS(OccModel)
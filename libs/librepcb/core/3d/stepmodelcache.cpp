@@ -0,0 +1,213 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "stepmodelcache.h"
+
+#include "../exceptions.h"
+#include "../fileio/fileutils.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+// Increment the version whenever the file format or the tesselation changes.
+static const quint32 sFileMagic = 0x4C50544D;  // "LPTM"
+static const quint32 sFileVersion = 1;
+
+// When pruning, remove files until the cache uses only this percentage of its
+// maximum size. Otherwise a full cache would be scanned on every store().
+static const qint64 sPruneTargetPercent = 75;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+StepModelCache::StepModelCache(const FilePath& dir, qint64 maxSize) noexcept
+  : mDir(dir), mMaxSize(maxSize), mMutex(), mTotalSize(-1) {
+}
+
+StepModelCache::~StepModelCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+tl::optional<StepModelCache::Model> StepModelCache::load(
+    const QByteArray& stepContent) const noexcept {
+  if (stepContent.isEmpty()) {
+    return tl::nullopt;
+  }
+  const FilePath fp = getFilePath(stepContent);
+  if (!fp.isExistingFile()) {
+    return tl::nullopt;
+  }
+  try {
+    if (tl::optional<Model> model =
+            deserialize(FileUtils::readFile(fp))) {  // can throw
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
+      // Mark the file as recently used, see prune().
+      QFile file(fp.toStr());
+      if (file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTime(),
+                         QFileDevice::FileModificationTime);
+      }
+#endif
+      return model;
+    }
+    qWarning() << "Ignoring invalid 3D model cache file:" << fp.toNative();
+  } catch (const Exception& e) {
+    qWarning() << "Failed to read 3D model cache file:" << e.getMsg();
+  }
+  return tl::nullopt;
+}
+
+void StepModelCache::store(const QByteArray& stepContent,
+                           const Model& model) noexcept {
+  if ((!mDir.isValid()) || stepContent.isEmpty()) {
+    return;
+  }
+  const FilePath fp = getFilePath(stepContent);
+  const QByteArray data = serialize(model);
+  const qint64 oldSize = QFileInfo(fp.toStr()).size();  // 0 if not existing
+  try {
+    FileUtils::writeFile(fp, data);  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to write 3D model cache file:" << e.getMsg();
+    return;
+  }
+
+  QMutexLocker lock(&mMutex);
+  if (mTotalSize >= 0) {
+    mTotalSize += data.size() - oldSize;
+  }
+  if ((mTotalSize < 0) || (mTotalSize > mMaxSize)) {
+    prune(fp);
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QByteArray StepModelCache::serialize(const Model& model) noexcept {
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_5);
+  stream << sFileMagic << sFileVersion << static_cast<quint32>(model.count());
+  for (auto it = model.begin(); it != model.end(); ++it) {
+    // Colors are stored with full precision since they are used as keys,
+    // vertices with single precision to keep the files small.
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    stream << std::get<0>(it.key()) << std::get<1>(it.key())
+           << std::get<2>(it.key()) << static_cast<quint32>(it.value().count());
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    foreach (const QVector3D& vertex, it.value()) {
+      stream << vertex.x() << vertex.y() << vertex.z();
+    }
+  }
+  return data;
+}
+
+tl::optional<StepModelCache::Model> StepModelCache::deserialize(
+    const QByteArray& data) noexcept {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_5_5);
+  quint32 magic = 0, version = 0, colorCount = 0;
+  stream >> magic >> version >> colorCount;
+  if ((magic != sFileMagic) || (version != sFileVersion)) {
+    return tl::nullopt;
+  }
+
+  Model model;
+  for (quint32 i = 0; (i < colorCount) && (stream.status() == QDataStream::Ok);
+       ++i) {
+    qreal r = 0, g = 0, b = 0;
+    quint32 vertexCount = 0;
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    stream >> r >> g >> b >> vertexCount;
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    // Avoid huge allocations if the file is corrupt.
+    if (vertexCount > (static_cast<quint32>(data.size()) / 12)) {
+      return tl::nullopt;
+    }
+    QVector<QVector3D> vertices;
+    vertices.reserve(vertexCount);
+    for (quint32 k = 0; k < vertexCount; ++k) {
+      float x = 0, y = 0, z = 0;
+      stream >> x >> y >> z;
+      vertices.append(QVector3D(x, y, z));
+    }
+    model.insert(OccModel::Color(r, g, b), vertices);
+  }
+  if ((stream.status() != QDataStream::Ok) || (!stream.atEnd())) {
+    return tl::nullopt;
+  }
+  return model;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+FilePath StepModelCache::getFilePath(
+    const QByteArray& stepContent) const noexcept {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(OccModel::getOccVersionString().toUtf8());
+  hash.addData(stepContent);
+  return mDir.getPathTo(QString::fromLatin1(hash.result().toHex()) % ".bin");
+}
+
+void StepModelCache::prune(const FilePath& keep) noexcept {
+  // Determine the real total size, since files might have been added or
+  // removed by other instances or processes. Then remove the least recently
+  // used files first, but never the file which was just written. Errors are
+  // ignored since the files might be removed by other processes concurrently.
+  // Note: Must be called with mMutex locked.
+  const QFileInfoList files =
+      QDir(mDir.toStr())
+          .entryInfoList({"*.bin"}, QDir::Files, QDir::Time | QDir::Reversed);
+  qint64 totalSize = 0;
+  foreach (const QFileInfo& file, files) {
+    totalSize += file.size();
+  }
+  if (totalSize > mMaxSize) {
+    const qint64 targetSize = (mMaxSize * sPruneTargetPercent) / 100;
+    for (int i = 0; (i < files.count()) && (totalSize > targetSize); ++i) {
+      const QFileInfo& file = files.at(i);
+      if ((FilePath(file.absoluteFilePath()) != keep) &&
+          QFile::remove(file.absoluteFilePath())) {
+        totalSize -= file.size();
+      }
+    }
+  }
+  mTotalSize = totalSize;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_STEPMODELCACHE_H
+#define LIBREPCB_CORE_STEPMODELCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+#include "occmodel.h"
+
+#include <optional/tl/optional.hpp>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class StepModelCache
+ ******************************************************************************/
+
+/**
+ * @brief Persistent cache of tesselated STEP models
+ *
+ * Loading and tesselating STEP models with OpenCascade is very slow, thus
+ * this class stores the result of ::librepcb::OccModel::tesselate() in a
+ * compact binary file per model. The files are identified by the SHA-256 hash
+ * of the STEP file content and the OpenCascade version (since the
+ * tesselation depends on it), so the same model is loaded only once, even
+ * across different projects and application restarts.
+ *
+ * To limit the disk usage, the least recently used files are removed as soon
+ * as the total size of the cache exceeds the maximum size passed to the
+ * constructor. The modification time of the files is used to determine the
+ * last usage (with Qt < 5.10, it is only the time when the file was written).
+ * The total size is determined only once by scanning the directory and then
+ * tracked in memory. When pruning, files are removed until only 75% of the
+ * maximum size is used, so the directory is not scanned on every store().
+ *
+ * @note This class is thread-safe. Every model is stored in its own file,
+ *       which is written atomically, and the tracked total size is protected
+ *       by a mutex. Files written by other instances or processes are taken
+ *       into account on the next directory scan.
+ */
+class StepModelCache final {
+public:
+  // Types
+  typedef QMap<OccModel::Color, QVector<QVector3D>> Model;
+
+  // Constructors / Destructor
+  StepModelCache() = delete;
+  StepModelCache(const StepModelCache& other) = delete;
+  StepModelCache(const FilePath& dir, qint64 maxSize) noexcept;
+  ~StepModelCache() noexcept;
+
+  // Getters
+  const FilePath& getDirectory() const noexcept { return mDir; }
+  qint64 getMaxSize() const noexcept { return mMaxSize; }
+
+  // General Methods
+
+  /**
+   * @brief Load a tesselated model from the cache
+   *
+   * @param stepContent   Content of the STEP file.
+   *
+   * @return The cached model, or `tl::nullopt` if the model is not cached
+   *         (or the cache file is invalid, or the STEP content is empty).
+   */
+  tl::optional<Model> load(const QByteArray& stepContent) const noexcept;
+
+  /**
+   * @brief Store a tesselated model in the cache
+   *
+   * @note Errors are only logged since a failed write is not critical.
+   *       Empty STEP content is not stored at all.
+   *
+   * @param stepContent   Content of the STEP file.
+   * @param model         The model tesselated from the STEP file.
+   */
+  void store(const QByteArray& stepContent, const Model& model) noexcept;
+
+  // Static Methods
+  static QByteArray serialize(const Model& model) noexcept;
+  static tl::optional<Model> deserialize(const QByteArray& data) noexcept;
+
+  // Operator Overloadings
+  StepModelCache& operator=(const StepModelCache& rhs) = delete;
+
+private:  // Methods
+  FilePath getFilePath(const QByteArray& stepContent) const noexcept;
+  void prune(const FilePath& keep) noexcept;
+
+private:  // Data
+  FilePath mDir;
+  qint64 mMaxSize;  ///< Maximum total size of all cache files [bytes]
+  QMutex mMutex;  ///< Protects #mTotalSize
+  qint64 mTotalSize;  ///< Total size of all cache files, -1 if not scanned yet
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
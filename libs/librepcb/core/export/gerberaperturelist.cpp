@@ -303,13 +303,17 @@ QString GerberApertureList::buildOutlineMacro(Path path,
 
 int GerberApertureList::addAperture(QString aperture,
                                     Function function) noexcept {
-  auto value = std::make_pair(function, aperture);
-  int number = mApertures.key(value, -1);
-  if (number < 0) {
-    number = mApertures.count() + 10;  // 10 is the number of the first aperture
-    Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, value);
+  QVector<int>& numbers = mApertureIndex[aperture];
+  foreach (int number, numbers) {
+    if (mApertures.value(number).first == function) {
+      return number;
+    }
   }
+  const int number =
+      mApertures.count() + 10;  // 10 is the number of the first aperture
+  Q_ASSERT(!mApertures.contains(number));
+  mApertures.insert(number, std::make_pair(function, aperture));
+  numbers.append(number);
   return number;
 }
 
@@ -225,6 +225,13 @@ private:  // Data
   ///           instead of the aperture number. Needs to be substituted by the
   ///           aperture number when serializing.
   QMap<int, std::pair<Function, QString>> mApertures;
+
+  /// Reverse index of #mApertures to quickly find existing apertures
+  ///
+  /// - key:    Aperture definition (same as in #mApertures).
+  /// - value:  Numbers of all apertures with this definition (i.e. with
+  ///           different functions).
+  QHash<QString, QVector<int>> mApertureIndex;
 };
 
 /*******************************************************************************
@@ -38,6 +38,27 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Helper Functions
+ ******************************************************************************/
+
+// Same output as QByteArray::number(), but appends the digits directly to the
+// output without allocating temporary strings.
+static void appendNumber(QByteArray& output, qint64 value) noexcept {
+  char buffer[24];
+  char* const end = buffer + sizeof(buffer);
+  char* p = end;
+  quint64 v = (value < 0) ? (quint64(0) - quint64(value)) : quint64(value);
+  do {
+    *--p = static_cast<char>('0' + (v % 10));
+    v /= 10;
+  } while (v != 0);
+  if (value < 0) {
+    *--p = '-';
+  }
+  output.append(p, static_cast<int>(end - p));
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -394,6 +415,7 @@ void GerberGenerator::flashComponentPin(
 
 void GerberGenerator::generate() {
   mOutput.clear();
+  mOutput.reserve(mContent.size() + 4096);
   printHeader();
   printApertureList();
   printContent();
@@ -404,7 +426,7 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const {
   // Note: Although we save it as UTF-8, usually it will still contain only
   // ASCII characters for maximum compatibility with legacy crappy readers.
   // Unicode is only required when exporting Gerber X3 assembly attributes.
-  FileUtils::writeFile(filepath, mOutput.toUtf8());  // can throw
+  FileUtils::writeFile(filepath, mOutput);  // can throw
 }
 
 /*******************************************************************************
@@ -452,12 +474,14 @@ void GerberGenerator::setCurrentAttributes(
   if (componentRotation) {
     attributes.append(GerberAttribute::componentRotation(*componentRotation));
   }
-  mContent.append(mAttributeWriter->setAttributes(attributes));
+  mContent.append(mAttributeWriter->setAttributes(attributes).toUtf8());
 }
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    mContent.append('D');
+    appendNumber(mContent, number);
+    mContent.append("*\n");
     mCurrentApertureNumber = number;
   }
 }
@@ -483,22 +507,25 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  printPosition(pos);
+  mContent.append("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  printPosition(pos);
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
                                                     const Point& center,
                                                     const Point& end) noexcept {
   Point diff = center - start;
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  printPosition(end);
+  mContent.append('I');
+  appendNumber(mContent, diff.getX().toNm());
+  mContent.append('J');
+  appendNumber(mContent, diff.getY().toNm());
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::interpolateBetween(const Vertex& from,
@@ -521,8 +548,16 @@ void GerberGenerator::interpolateBetween(const Vertex& from,
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  printPosition(pos);
+  mContent.append("D03*\n");
+}
+
+void GerberGenerator::printPosition(const Point& pos) noexcept {
+  // Coordinates are in nanometers thanks to the coordinate format "6.6".
+  mContent.append('X');
+  appendNumber(mContent, pos.getX().toNm());
+  mContent.append('Y');
+  appendNumber(mContent, pos.getY().toNm());
 }
 
 void GerberGenerator::printHeader() noexcept {
@@ -530,7 +565,7 @@ void GerberGenerator::printHeader() noexcept {
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toGerberString());
+    mOutput.append(a.toGerberString().toUtf8());
   }
 
   // coordinate format specification:
@@ -556,7 +591,7 @@ void GerberGenerator::printHeader() noexcept {
 
 void GerberGenerator::printApertureList() noexcept {
   mOutput.append("G04 --- APERTURE LIST BEGIN --- *\n");
-  mOutput.append(mApertureList->generateString());
+  mOutput.append(mApertureList->generateString().toUtf8());
   mOutput.append("G04 --- APERTURE LIST END --- *\n");
 }
 
@@ -568,8 +603,9 @@ void GerberGenerator::printContent() noexcept {
 
 void GerberGenerator::printFooter() noexcept {
   // MD5 checksum over content
-  mOutput.append(
-      GerberAttribute::fileMd5(calcOutputMd5Checksum()).toGerberString());
+  mOutput.append(GerberAttribute::fileMd5(calcOutputMd5Checksum())
+                     .toGerberString()
+                     .toUtf8());
 
   // end of file
   mOutput.append("M02*\n");
@@ -578,9 +614,17 @@ void GerberGenerator::printFooter() noexcept {
 QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
   // according to the RS-274C standard, linebreaks are not included in the
   // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  int pos = 0;
+  while (pos < mOutput.size()) {
+    int end = mOutput.indexOf('\n', pos);
+    if (end < 0) {
+      end = mOutput.size();
+    }
+    hash.addData(mOutput.constData() + pos, end - pos);
+    pos = end + 1;
+  }
+  return QString(hash.result().toHex());
 }
 
 /*******************************************************************************
@@ -67,7 +67,7 @@ public:
   ~GerberGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromUtf8(mOutput); }
 
   // Plot Methods
   void setFileFunctionOutlines(bool plated) noexcept;
@@ -157,6 +157,7 @@ private:
                                      const Point& end) noexcept;
   void interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void flashAtPosition(const Point& pos) noexcept;
+  void printPosition(const Point& pos) noexcept;
   void printHeader() noexcept;
   void printApertureList() noexcept;
   void printContent() noexcept;
@@ -166,9 +167,9 @@ private:
   // Metadata
   QVector<GerberAttribute> mFileAttributes;
 
-  // Gerber Data
-  QString mOutput;
-  QString mContent;
+  // Gerber Data (UTF-8 encoded)
+  QByteArray mOutput;
+  QByteArray mContent;
   QScopedPointer<GerberAttributeWriter> mAttributeWriter;
   QScopedPointer<GerberApertureList> mApertureList;
   int mCurrentApertureNumber;
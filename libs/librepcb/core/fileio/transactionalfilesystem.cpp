@@ -185,7 +185,9 @@ QByteArray TransactionalFileSystem::readIfExists(const QString& path) const {
   } else if (!isRemoved(cleanedPath)) {
     const FilePath fp = mFilePath.getPathTo(cleanedPath);
     if (fp.isExistingFile()) {
-      return FileUtils::readFile(fp);  // can throw
+      const QByteArray content = FileUtils::readFile(fp);  // can throw
+      rememberFileState(cleanedPath, content);
+      return content;
     }
   }
   return QByteArray();
@@ -195,7 +197,15 @@ void TransactionalFileSystem::write(const QString& path,
                                     const QByteArray& content) {
   const QString cleanedPath = cleanPath(path);
   QMutexLocker lock(&mMutex);
-  mModifiedFiles[cleanedPath] = content;
+  const tl::optional<FileState> state = getUnmodifiedFileState(cleanedPath);
+  if ((!isRemoved(cleanedPath)) && state && (state->size == content.size()) &&
+      (state->hash == hashContent(content))) {
+    // Content is identical to the file on the disk, so it's not a
+    // modification and there's no need to write the file when saving.
+    mModifiedFiles.remove(cleanedPath);
+  } else {
+    mModifiedFiles[cleanedPath] = content;
+  }
   mRemovedFiles.remove(cleanedPath);
 }
 
@@ -345,8 +355,15 @@ QStringList TransactionalFileSystem::checkForModifications() const {
   foreach (const QString& filepath, mModifiedFiles.keys()) {
     FilePath fp = mFilePath.getPathTo(filepath);
     QByteArray content = mModifiedFiles.value(filepath);
-    if ((!fp.isExistingFile()) ||
-        (FileUtils::readFile(fp) != content)) {  // can throw
+    if (const tl::optional<FileState> state =
+            getUnmodifiedFileState(filepath)) {
+      // The file was not modified on the disk since we have read or written
+      // it, so comparing the hash is enough.
+      if (state->hash != hashContent(content)) {
+        modifications.append(filepath);
+      }
+    } else if ((!fp.isExistingFile()) ||
+               (FileUtils::readFile(fp) != content)) {  // can throw
       modifications.append(filepath);
     }
   }
@@ -379,6 +396,11 @@ void TransactionalFileSystem::save() {
     if (fp.isExistingDir()) {
       FileUtils::removeDirRecursively(fp);  // can throw
     }
+    foreach (const QString& filepath, mFileStates.keys()) {
+      if (filepath.startsWith(dir)) {
+        mFileStates.remove(filepath);
+      }
+    }
   }
 
   // remove files
@@ -387,12 +409,14 @@ void TransactionalFileSystem::save() {
     if (fp.isExistingFile()) {
       FileUtils::removeFile(fp);  // can throw
     }
+    mFileStates.remove(filepath);
   }
 
   // save new or modified files
   foreach (const QString& filepath, mModifiedFiles.keys()) {
-    FileUtils::writeFile(mFilePath.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+    const QByteArray content = mModifiedFiles.value(filepath);
+    FileUtils::writeFile(mFilePath.getPathTo(filepath), content);  // can throw
+    rememberFileState(filepath, content);
   }
 
   // remove backup
@@ -437,6 +461,69 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
+void TransactionalFileSystem::rememberFileState(
+    const QString& path, const QByteArray& content) const noexcept {
+  const QFileInfo info(mFilePath.getPathTo(path).toStr());
+  if (info.exists()) {
+    mFileStates.insert(path,
+                       FileState{hashContent(content), info.size(),
+                                 info.lastModified(),
+                                 QDateTime::currentDateTimeUtc()});
+  } else {
+    mFileStates.remove(path);
+  }
+}
+
+tl::optional<TransactionalFileSystem::FileState>
+    TransactionalFileSystem::getUnmodifiedFileState(
+        const QString& path) const noexcept {
+  // Resolution of modification times on the coarsest supported file systems
+  // (2s on FAT, network shares may also round to full seconds).
+  static const qint64 timestampResolutionMs = 2000;
+
+  const auto it = mFileStates.find(path);
+  if (it == mFileStates.end()) {
+    return tl::nullopt;
+  }
+
+  // Only a cheap check of the file metadata, to detect if the file was
+  // modified by someone else in the meantime.
+  const FilePath fp = mFilePath.getPathTo(path);
+  const QFileInfo info(fp.toStr());
+  if ((!info.exists()) || (info.size() != it->size) ||
+      (info.lastModified() != it->lastModified)) {
+    mFileStates.remove(path);
+    return tl::nullopt;
+  }
+
+  // If the state was recorded within the timestamp resolution after the
+  // last modification, someone else might have modified the file without
+  // changing its modification time. Then only the content can tell, so the
+  // file needs to be read and hashed again. Once this succeeded later than
+  // the resolution after the modification, the metadata check is enough.
+  // Note: This does not detect modifications with the same file size if the
+  // clock of a network share is off by more than the resolution.
+  if (it->lastModified.msecsTo(it->recordedAt) < timestampResolutionMs) {
+    try {
+      const QByteArray content = FileUtils::readFile(fp);  // can throw
+      if (hashContent(content) != it->hash) {
+        mFileStates.remove(path);
+        return tl::nullopt;
+      }
+      it->recordedAt = QDateTime::currentDateTimeUtc();
+    } catch (const Exception&) {
+      mFileStates.remove(path);
+      return tl::nullopt;
+    }
+  }
+  return *it;
+}
+
+QByteArray TransactionalFileSystem::hashContent(
+    const QByteArray& content) noexcept {
+  return QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+}
+
 void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
                                              const FilePath& zipFp,
                                              const QString& dir,
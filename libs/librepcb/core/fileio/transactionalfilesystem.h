@@ -27,6 +27,8 @@
 #include "directorylock.h"
 #include "filesystem.h"
 
+#include <optional/tl/optional.hpp>
+
 #include <QtCore>
 
 #include <memory>
@@ -60,6 +62,10 @@ namespace librepcb {
  *  - Holds all file modifications in memory and allows to write those in an
  *    atomic way to the disk (see @ref doc_project_save).
  *  - Allows to export the whole file system to a ZIP file.
+ *  - Remembers a content hash of every file read from or written to the
+ *    disk, so writing unchanged content does not count as a modification
+ *    (i.e. unchanged files are not rewritten when saving) and checking for
+ *    modifications does not need to read the files again.
  *
  * In addition, all public methods of this class are thread-safe, i.e.
  * concurrent access to the file system from multiple threads is allowed.
@@ -206,8 +212,22 @@ public:
   }
   static QString cleanPath(QString path) noexcept;
 
+private:  // Types
+  /// State of a file on the disk, as last read or written by us
+  struct FileState {
+    QByteArray hash;
+    qint64 size;
+    QDateTime lastModified;
+    QDateTime recordedAt;  ///< When the state was (last) verified
+  };
+
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
+  void rememberFileState(const QString& path,
+                         const QByteArray& content) const noexcept;
+  tl::optional<FileState> getUnmodifiedFileState(
+      const QString& path) const noexcept;
+  static QByteArray hashContent(const QByteArray& content) noexcept;
   void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
                       const QString& dir, FilterFunction filter) const;
   void saveDiff(const QString& type) const;
@@ -225,6 +245,9 @@ private:  // Data
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString> mRemovedFiles;
   QSet<QString> mRemovedDirs;
+
+  /// Known states of files on the disk (see #rememberFileState())
+  mutable QHash<QString, FileState> mFileStates;
 };
 
 /*******************************************************************************
@@ -41,7 +41,11 @@ namespace fb = fontobene;
 
 StrokeFont::StrokeFont(const FilePath& fontFilePath,
                        const QByteArray& content) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
+  : QObject(nullptr),
+    mFilePath(fontFilePath),
+    mCacheMutex(),
+    mGlyphCache(sMaxCachedGlyphs),
+    mTextCache(sMaxCachedTexts) {
   // load the font in another thread because it takes some time to load it
   qDebug() << "Start loading stroke font " << mFilePath.toNative()
            << "in worker thread...";
@@ -83,6 +87,22 @@ QVector<Path> StrokeFont::stroke(const QString& text,
                                  Point& topRight) const noexcept {
   accessor();  // block until the font is loaded. TODO: abort instead of
                // waiting?
+
+  const QString key = QString("%1:%2:%3:%4:")
+                          .arg(height->toNm())
+                          .arg(letterSpacing.toNm())
+                          .arg(lineSpacing.toNm())
+                          .arg(static_cast<int>(align.toQtAlign())) %
+      text;
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const Text* cached = mTextCache.object(key)) {
+      bottomLeft = cached->bottomLeft;
+      topRight = cached->topRight;
+      return cached->paths;
+    }
+  }
+
   QVector<Path> paths;
   Length totalWidth;
   QVector<QPair<QVector<Path>, Length>> lines =
@@ -131,6 +151,8 @@ QVector<Path> StrokeFont::stroke(const QString& text,
     topRight.setY(totalHeight / 2);
   }
 
+  QMutexLocker lock(&mCacheMutex);
+  mTextCache.insert(key, new Text{paths, bottomLeft, topRight});
   return paths;
 }
 
@@ -155,22 +177,19 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
   Length offset = 0;
   width = 0;  // same as offset, but without last letter spacing
   for (int i = 0; i < text.length(); ++i) {
-    Length glyphSpacing;
-    QVector<Path> glyphPaths = strokeGlyph(text.at(i), height, glyphSpacing);
-    if (!glyphPaths.isEmpty()) {
-      Point bottomLeft, topRight;
-      computeBoundingRect(glyphPaths, bottomLeft, topRight);
-      Length shift =
-          (i == 0) ? -bottomLeft.getX() : 0;  // left-align first character
-      foreach (const Path& p, glyphPaths) {
+    const Glyph glyph = getGlyph(text.at(i), height);
+    if (!glyph.paths.isEmpty()) {
+      Length shift = (i == 0) ? -glyph.bottomLeft.getX()
+                              : 0;  // left-align first character
+      foreach (const Path& p, glyph.paths) {
         paths.append(p.translated(Point(offset + shift, Length(0))));
       }
-      width = offset + topRight.getX() +
+      width = offset + glyph.topRight.getX() +
           shift;  // do *not* count glyph spacing as width!
-      offset = width + glyphSpacing + letterSpacing;
-    } else if (glyphSpacing != 0) {
+      offset = width + glyph.spacing + letterSpacing;
+    } else if (glyph.spacing != 0) {
       // it's a whitespace-only glyph -> count additional glyph spacing as width
-      width = offset + glyphSpacing;
+      width = offset + glyph.spacing;
       offset = width + letterSpacing;
     }
   }
@@ -180,23 +199,46 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
 QVector<Path> StrokeFont::strokeGlyph(const QChar& glyph,
                                       const PositiveLength& height,
                                       Length& spacing) const noexcept {
+  const Glyph g = getGlyph(glyph, height);
+  spacing = g.spacing;
+  return g.paths;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+StrokeFont::Glyph StrokeFont::getGlyph(const QChar& glyph,
+                                       const PositiveLength& height) const
+    noexcept {
+  const QPair<uint, LengthBase_t> key(glyph.unicode(), height->toNm());
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const Glyph* cached = mGlyphCache.object(key)) {
+      return *cached;
+    }
+  }
+
+  Glyph data;
   try {
     qreal glyphSpacing = 0;
     QVector<fb::Polyline> polylines =
         accessor().getAllPolylinesOfGlyph(glyph.unicode(),
                                           &glyphSpacing);  // can throw
-    spacing = convertLength(height, glyphSpacing);
-    return polylines2paths(polylines, height);
+    data.spacing = convertLength(height, glyphSpacing);
+    data.paths = polylines2paths(polylines, height);
+    if (!data.paths.isEmpty()) {
+      computeBoundingRect(data.paths, data.bottomLeft, data.topRight);
+    }
   } catch (const fb::Exception& e) {
     qWarning().nospace() << "Failed to load stroke font glyph " << glyph << ".";
-    spacing = 0;
-    return QVector<Path>();
+    return Glyph{QVector<Path>(), Length(0), Point(), Point()};
   }
-}
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
+  QMutexLocker lock(&mCacheMutex);
+  mGlyphCache.insert(key, new Glyph(data));
+  return data;
+}
 
 void StrokeFont::fontLoaded() noexcept {
   accessor();  // trigger the message about loading succeeded or failed
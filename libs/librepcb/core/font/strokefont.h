@@ -50,6 +50,11 @@ namespace librepcb {
 
 /**
  * @brief The StrokeFont class
+ *
+ * Stroked glyphs (per glyph and height) as well as complete stroked texts are
+ * cached, so stroking the same texts again (e.g. after attributes have been
+ * modified, or when the same designator is used multiple times) is cheap.
+ * The caches are thread-safe, as texts may be stroked from worker threads.
  */
 class StrokeFont final : public QObject {
   Q_OBJECT
@@ -81,7 +86,22 @@ public:
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
-private:
+private:  // Types
+  struct Glyph {
+    QVector<Path> paths;
+    Length spacing;
+    Point bottomLeft;
+    Point topRight;
+  };
+  struct Text {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+  };
+
+private:  // Methods
+  Glyph getGlyph(const QChar& glyph, const PositiveLength& height) const
+      noexcept;
   void fontLoaded() noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
   static QVector<Path> polylines2paths(
@@ -103,6 +123,23 @@ private:  // Data
   mutable QScopedPointer<fontobene::Font> mFont;
   mutable QScopedPointer<fontobene::GlyphListCache> mGlyphListCache;
   mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+
+  // Cache
+  mutable QMutex mCacheMutex;
+  mutable QCache<QPair<uint, LengthBase_t>, Glyph> mGlyphCache;
+  mutable QCache<QString, Text> mTextCache;
+
+  // Constants
+
+  /// Maximum number of cached glyphs. Enough for all characters of a script
+  /// in some dozens of different heights, while each glyph takes only a few
+  /// hundred bytes.
+  static const int sMaxCachedGlyphs = 10000;
+
+  /// Maximum number of cached texts. Enough for every text (designators,
+  /// values, ...) of large boards and schematics, so stroking them again does
+  /// not evict each other. Each text takes about one kilobyte.
+  static const int sMaxCachedTexts = 20000;
 };
 
 /*******************************************************************************
@@ -408,6 +408,15 @@ Path Path::obround(const Point& p1, const Point& p2,
   return p;
 }
 
+Path Path::obround(const Point& p1, const Point& p2,
+                   const Length& width) noexcept {
+  if (width > 0) {
+    return obround(p1, p2, PositiveLength(width));
+  } else {
+    return Path();
+  }
+}
+
 Path Path::arcObround(const Point& p1, const Point& p2, const Angle& angle,
                       const PositiveLength& width) noexcept {
   if (p1 == p2) {
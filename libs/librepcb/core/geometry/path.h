@@ -144,6 +144,16 @@ public:
                       const PositiveLength& height) noexcept;
   static Path obround(const Point& p1, const Point& p2,
                       const PositiveLength& width) noexcept;
+
+  /**
+   * @brief Same as #obround(const Point&, const Point&, const PositiveLength&)
+   *        but returns an empty path if the width is not positive
+   *
+   * Used for outlines of traces expanded or shrunk by an offset, e.g.
+   * ::librepcb::BI_NetLine::getSceneOutline().
+   */
+  static Path obround(const Point& p1, const Point& p2,
+                      const Length& width) noexcept;
   static Path arcObround(const Point& p1, const Point& p2, const Angle& angle,
                          const PositiveLength& width) noexcept;
   static Path rect(const Point& p1, const Point& p2) noexcept;
@@ -35,9 +35,12 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-Vertex::Vertex(const SExpression& node)
-  : mPos(node.getChild("position")),
-    mAngle(deserialize<Angle>(node.getChild("angle/@0"))) {
+Vertex::Vertex(const SExpression& node) : mPos(), mAngle() {
+  // Note: Precompiled paths since this is called very often.
+  static const SExpression::ChildPath posPath("position");
+  static const SExpression::ChildPath anglePath("angle/@0");
+  mPos = Point(node.getChild(posPath));
+  mAngle = deserialize<Angle>(node.getChild(anglePath));
 }
 
 /*******************************************************************************
@@ -800,7 +800,8 @@ void Board::copyFrom(const Board& other) {
     copy->setThermalSpokeWidth(plane->getThermalSpokeWidth());
     copy->setLocked(plane->isLocked());
     copy->setVisible(plane->isVisible());
-    copy->setCalculatedFragments(plane->getFragments());
+    copy->setCalculatedFragments(plane->getFragments(),
+                                 plane->getFragmentsHash());
     addPlane(*copy);
   }
 
@@ -990,6 +991,20 @@ void Board::save() {
       SExpression node = SExpression::createList("plane");
       node.appendChild(plane->getUuid());
       node.appendChild("visible", plane->isVisible());
+      if (!plane->getFragmentsHash().isEmpty()) {
+        // Cache the calculated fragments to avoid rebuilding the plane after
+        // reopening the project.
+        node.ensureLineBreak();
+        SExpression& fragmentsNode = node.appendList("fragments");
+        fragmentsNode.appendChild(
+            QString(plane->getFragmentsHash().toHex()));
+        foreach (const Path& fragment, plane->getFragments()) {
+          fragmentsNode.ensureLineBreak();
+          fragment.serialize(fragmentsNode.appendList("fragment"));
+        }
+        fragmentsNode.ensureLineBreak();
+        node.ensureLineBreak();
+      }
       root.appendChild(node);
     }
     root.ensureLineBreak();
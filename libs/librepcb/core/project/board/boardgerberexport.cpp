@@ -51,6 +51,7 @@
 #include "items/bi_stroketext.h"
 #include "items/bi_via.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -76,9 +77,7 @@ BoardGerberExport::BoardGerberExport(const Board& board) noexcept
     mBeforeWriteCallback(),
     mCreationDateTime(QDateTime::currentDateTime()),
     mProjectName(*mProject.getName()),
-    mCurrentInnerCopperLayer(0),
-    mCurrentStartLayer(nullptr),
-    mCurrentEndLayer(nullptr) {
+    mWrittenFiles() {
   // If the project contains multiple boards, add the board name to the
   // Gerber file metadata as well to distinguish between the different boards.
   if (mProject.getBoards().count() > 1) {
@@ -119,20 +118,55 @@ void BoardGerberExport::exportPcbLayers(
     const BoardFabricationOutputSettings& settings) const {
   mWrittenFiles.clear();
 
-  exportDrillsMerged(settings);
-  exportDrillsNpth(settings);
-  exportDrillsPth(settings);
-  exportDrillsBlindBuried(settings);
-  exportLayerBoardOutlines(settings);
-  exportLayerTopCopper(settings);
-  exportLayerInnerCopper(settings);
-  exportLayerBottomCopper(settings);
-  exportLayerTopSolderMask(settings);
-  exportLayerBottomSolderMask(settings);
-  exportLayerTopSilkscreen(settings);
-  exportLayerBottomSilkscreen(settings);
-  exportLayerTopSolderPaste(settings);
-  exportLayerBottomSolderPaste(settings);
+  // The files are independent of each other, so generate them in parallel.
+  // Note that the order of the jobs matters since the files are written in
+  // the same order afterwards.
+  typedef std::function<OutputFiles()> Job;
+  QVector<Job> jobs = {
+      [&]() { return exportDrillsMerged(settings); },
+      [&]() { return exportDrillsNpth(settings); },
+      [&]() { return exportDrillsPth(settings); },
+      [&]() { return exportDrillsBlindBuried(settings); },
+      [&]() { return exportLayerBoardOutlines(settings); },
+      [&]() { return exportLayerTopCopper(settings); },
+  };
+  for (int i = 1; i <= mBoard.getInnerLayerCount(); ++i) {
+    jobs.append([&, i]() { return exportLayerInnerCopper(settings, i); });
+  }
+  jobs += QVector<Job>{
+      [&]() { return exportLayerBottomCopper(settings); },
+      [&]() { return exportLayerTopSolderMask(settings); },
+      [&]() { return exportLayerBottomSolderMask(settings); },
+      [&]() { return exportLayerTopSilkscreen(settings); },
+      [&]() { return exportLayerBottomSilkscreen(settings); },
+      [&]() { return exportLayerTopSolderPaste(settings); },
+      [&]() { return exportLayerBottomSolderPaste(settings); },
+  };
+
+  // Use a private thread pool since this method might be called within the
+  // global thread pool. Wait for all jobs to be finished before writing any
+  // file, to make sure no job is running anymore if an exception is thrown.
+  QThreadPool pool;
+  QVector<QFuture<OutputFiles>> futures;
+  foreach (const Job& job, jobs) {
+    futures.append(QtConcurrent::run(&pool, job));
+  }
+  pool.waitForDone();
+
+  // Write the files sequentially since the callback and the tracking of
+  // written files are not thread-safe. Exceptions thrown by a job are
+  // rethrown when accessing its result.
+  for (QFuture<OutputFiles>& future : futures) {
+    foreach (const OutputFile& file, future.result()) {  // can throw
+      if (file.write) {
+        trackFileBeforeWrite(file.path);  // can throw
+        file.write();  // can throw
+      } else if (mRemoveObsoleteFiles && file.path.isExistingFile() &&
+                 (!mWrittenFiles.contains(file.path))) {
+        FileUtils::removeFile(file.path);  // can throw
+      }
+    }
+  }
 }
 
 void BoardGerberExport::exportComponentLayer(BoardSide side,
@@ -297,31 +331,29 @@ void BoardGerberExport::exportComponentLayer(BoardSide side,
  *  Private Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportDrillsMerged(
+BoardGerberExport::OutputFiles BoardGerberExport::exportDrillsMerged(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrills());
   if (settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
+    std::shared_ptr<ExcellonGenerator> gen =
         BoardGerberExport::createExcellonGenerator(
             settings, ExcellonGenerator::Plating::Mixed);
     drawPthDrills(*gen);
     drawNpthDrills(*gen);
     gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportDrillsNpth(
+BoardGerberExport::OutputFiles BoardGerberExport::exportDrillsNpth(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsNpth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
+    std::shared_ptr<ExcellonGenerator> gen =
         BoardGerberExport::createExcellonGenerator(
             settings, ExcellonGenerator::Plating::No);
     drawNpthDrills(*gen);
@@ -334,41 +366,37 @@ void BoardGerberExport::exportDrillsNpth(
     // doesn't support a separate NPTH file, the user shall enable the
     // "merge PTH and NPTH drills"  option.
     gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportDrillsPth(
+BoardGerberExport::OutputFiles BoardGerberExport::exportDrillsPth(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsPth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
+    std::shared_ptr<ExcellonGenerator> gen =
         BoardGerberExport::createExcellonGenerator(
             settings, ExcellonGenerator::Plating::Yes);
     drawPthDrills(*gen);
     gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportDrillsBlindBuried(
+BoardGerberExport::OutputFiles BoardGerberExport::exportDrillsBlindBuried(
     const BoardFabricationOutputSettings& settings) const {
+  OutputFiles files;
   auto vias = getBlindBuriedVias();
   for (auto it = vias.begin(); it != vias.end(); it++) {
-    mCurrentStartLayer = it.key().first;
-    mCurrentEndLayer = it.key().second;
     const FilePath fp = getOutputFilePath(
-        settings.getOutputBasePath() % settings.getSuffixDrillsBlindBuried());
-    std::unique_ptr<ExcellonGenerator> gen =
+        settings.getOutputBasePath() % settings.getSuffixDrillsBlindBuried(), 0,
+        it.key().first, it.key().second);
+    std::shared_ptr<ExcellonGenerator> gen =
         BoardGerberExport::createExcellonGenerator(
             settings, ExcellonGenerator::Plating::Yes);
     foreach (const BI_Via* via, it.value()) {
@@ -376,197 +404,187 @@ void BoardGerberExport::exportDrillsBlindBuried(
                  ExcellonGenerator::Function::ViaDrill);
     }
     gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
+    files.append(generatedFile(fp, gen));
   }
+  return files;
 }
 
-void BoardGerberExport::exportLayerBoardOutlines(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerBoardOutlines(
     const BoardFabricationOutputSettings& settings) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixOutlines());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionOutlines(false);
-  drawLayer(gen, Layer::boardOutlines());
-  drawLayer(gen, Layer::boardCutouts());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto gen = std::make_shared<GerberGenerator>(
+      mCreationDateTime, mProjectName, mBoard.getUuid(),
+      *mProject.getVersion());
+  gen->setFileFunctionOutlines(false);
+  drawLayer(*gen, Layer::boardOutlines());
+  drawLayer(*gen, Layer::boardCutouts());
+  gen->generate();
+  return {generatedFile(fp, gen)};
 }
 
-void BoardGerberExport::exportLayerTopCopper(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerTopCopper(
     const BoardFabricationOutputSettings& settings) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperTop());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::topCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto gen = std::make_shared<GerberGenerator>(
+      mCreationDateTime, mProjectName, mBoard.getUuid(),
+      *mProject.getVersion());
+  gen->setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                             GerberGenerator::Polarity::Positive);
+  drawLayer(*gen, Layer::topCopper());
+  gen->generate();
+  return {generatedFile(fp, gen)};
 }
 
-void BoardGerberExport::exportLayerBottomCopper(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerBottomCopper(
     const BoardFabricationOutputSettings& settings) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperBot());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
-                            GerberGenerator::CopperSide::Bottom,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::botCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto gen = std::make_shared<GerberGenerator>(
+      mCreationDateTime, mProjectName, mBoard.getUuid(),
+      *mProject.getVersion());
+  gen->setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
+                             GerberGenerator::CopperSide::Bottom,
+                             GerberGenerator::Polarity::Positive);
+  drawLayer(*gen, Layer::botCopper());
+  gen->generate();
+  return {generatedFile(fp, gen)};
 }
 
-void BoardGerberExport::exportLayerInnerCopper(
-    const BoardFabricationOutputSettings& settings) const {
-  for (int i = 1; i <= mBoard.getInnerLayerCount(); ++i) {
-    mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                    settings.getSuffixCopperInner());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
-                              GerberGenerator::Polarity::Positive);
-    if (const Layer* layer = Layer::innerCopper(i)) {
-      drawLayer(gen, *layer);
-    } else {
-      throw LogicError(__FILE__, __LINE__, "Unknown inner copper layer.");
-    }
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerInnerCopper(
+    const BoardFabricationOutputSettings& settings, int number) const {
+  FilePath fp = getOutputFilePath(
+      settings.getOutputBasePath() % settings.getSuffixCopperInner(), number);
+  auto gen = std::make_shared<GerberGenerator>(
+      mCreationDateTime, mProjectName, mBoard.getUuid(),
+      *mProject.getVersion());
+  gen->setFileFunctionCopper(number + 1, GerberGenerator::CopperSide::Inner,
+                             GerberGenerator::Polarity::Positive);
+  if (const Layer* layer = Layer::innerCopper(number)) {
+    drawLayer(*gen, *layer);
+  } else {
+    throw LogicError(__FILE__, __LINE__, "Unknown inner copper layer.");
   }
-  mCurrentInnerCopperLayer = 0;
+  gen->generate();
+  return {generatedFile(fp, gen)};
 }
 
-void BoardGerberExport::exportLayerTopSolderMask(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerTopSolderMask(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskTop());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto gen = std::make_shared<GerberGenerator>(
+        mCreationDateTime, mProjectName, mBoard.getUuid(),
+        *mProject.getVersion());
+    gen->setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
+                                   GerberGenerator::Polarity::Negative);
+    drawLayer(*gen, Layer::topStopMask());
+    gen->generate();
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerBottomSolderMask(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskBot());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto gen = std::make_shared<GerberGenerator>(
+        mCreationDateTime, mProjectName, mBoard.getUuid(),
+        *mProject.getVersion());
+    gen->setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
+                                   GerberGenerator::Polarity::Negative);
+    drawLayer(*gen, Layer::botStopMask());
+    gen->generate();
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportLayerTopSilkscreen(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerTopSilkscreen(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSilkscreenTop());
   const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersTop();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
-                              GerberGenerator::Polarity::Positive);
+    auto gen = std::make_shared<GerberGenerator>(
+        mCreationDateTime, mProjectName, mBoard.getUuid(),
+        *mProject.getVersion());
+    gen->setFileFunctionLegend(GerberGenerator::BoardSide::Top,
+                               GerberGenerator::Polarity::Positive);
     foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
+      drawLayer(*gen, *layer);
     }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    gen->setLayerPolarity(GerberGenerator::Polarity::Negative);
+    drawLayer(*gen, Layer::topStopMask());
+    gen->generate();
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerBottomSilkscreen(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSilkscreenBot());
   const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersBot();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
-                              GerberGenerator::Polarity::Positive);
+    auto gen = std::make_shared<GerberGenerator>(
+        mCreationDateTime, mProjectName, mBoard.getUuid(),
+        *mProject.getVersion());
+    gen->setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
+                               GerberGenerator::Polarity::Positive);
     foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
+      drawLayer(*gen, *layer);
     }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    gen->setLayerPolarity(GerberGenerator::Polarity::Negative);
+    drawLayer(*gen, Layer::botStopMask());
+    gen->generate();
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportLayerTopSolderPaste(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerTopSolderPaste(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteTop());
   if (settings.getEnableSolderPasteTop()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::topSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto gen = std::make_shared<GerberGenerator>(
+        mCreationDateTime, mProjectName, mBoard.getUuid(),
+        *mProject.getVersion());
+    gen->setFileFunctionPaste(GerberGenerator::BoardSide::Top,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(*gen, Layer::topSolderPaste());
+    gen->generate();
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
-void BoardGerberExport::exportLayerBottomSolderPaste(
+BoardGerberExport::OutputFiles BoardGerberExport::exportLayerBottomSolderPaste(
     const BoardFabricationOutputSettings& settings) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteBot());
   if (settings.getEnableSolderPasteBot()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::botSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto gen = std::make_shared<GerberGenerator>(
+        mCreationDateTime, mProjectName, mBoard.getUuid(),
+        *mProject.getVersion());
+    gen->setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(*gen, Layer::botSolderPaste());
+    gen->generate();
+    return {generatedFile(fp, gen)};
+  } else {
+    return {obsoleteFile(fp)};
   }
 }
 
@@ -1045,9 +1063,14 @@ std::unique_ptr<ExcellonGenerator> BoardGerberExport::createExcellonGenerator(
   return gen;
 }
 
-FilePath BoardGerberExport::getOutputFilePath(QString path) const noexcept {
+FilePath BoardGerberExport::getOutputFilePath(
+    QString path, int innerCopperLayer, const Layer* startLayer,
+    const Layer* endLayer) const noexcept {
   path = AttributeSubstitutor::substitute(
-      path, [this](const QString& key) { return getAttributeValue(key); },
+      path,
+      [&](const QString& key) {
+        return getAttributeValue(key, innerCopperLayer, startLayer, endLayer);
+      },
       [&](const QString& str) {
         return FilePath::cleanFileName(
             str, FilePath::ReplaceSpaces | FilePath::KeepCase);
@@ -1061,7 +1084,8 @@ FilePath BoardGerberExport::getOutputFilePath(QString path) const noexcept {
 }
 
 QString BoardGerberExport::getAttributeValue(
-    const QString& key) const noexcept {
+    const QString& key, int innerCopperLayer, const Layer* startLayer,
+    const Layer* endLayer) const noexcept {
   auto getLayerName = [](const Layer* layer) {
     Q_ASSERT(layer && layer->isCopper());
     if (layer->isTop()) {
@@ -1073,16 +1097,16 @@ QString BoardGerberExport::getAttributeValue(
     }
   };
 
-  if ((key == QLatin1String("CU_LAYER")) && (mCurrentInnerCopperLayer > 0)) {
-    return QString::number(mCurrentInnerCopperLayer);
-  } else if ((mCurrentStartLayer) && (key == QLatin1String("START_LAYER"))) {
-    return getLayerName(mCurrentStartLayer);
-  } else if ((mCurrentEndLayer) && (key == QLatin1String("END_LAYER"))) {
-    return getLayerName(mCurrentEndLayer);
-  } else if ((mCurrentStartLayer) && (key == QLatin1String("START_NUMBER"))) {
-    return QString::number(mCurrentStartLayer->getCopperNumber() + 1);
-  } else if ((mCurrentEndLayer) && (key == QLatin1String("END_NUMBER"))) {
-    return QString::number(mCurrentEndLayer->getCopperNumber() + 1);
+  if ((key == QLatin1String("CU_LAYER")) && (innerCopperLayer > 0)) {
+    return QString::number(innerCopperLayer);
+  } else if ((startLayer) && (key == QLatin1String("START_LAYER"))) {
+    return getLayerName(startLayer);
+  } else if ((endLayer) && (key == QLatin1String("END_LAYER"))) {
+    return getLayerName(endLayer);
+  } else if ((startLayer) && (key == QLatin1String("START_NUMBER"))) {
+    return QString::number(startLayer->getCopperNumber() + 1);
+  } else if ((endLayer) && (key == QLatin1String("END_NUMBER"))) {
+    return QString::number(endLayer->getCopperNumber() + 1);
   } else {
     const ProjectAttributeLookup lookup(mBoard, nullptr);
     return lookup(key);
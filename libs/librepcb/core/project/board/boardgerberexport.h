@@ -92,31 +92,45 @@ public:
   BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
 
 private:
+  // Types
+
+  /// A generated file which is written to disk after all files have been
+  /// generated. If #write is not set, the file is obsolete and will be
+  /// removed (if enabled and not written by another output).
+  struct OutputFile {
+    FilePath path;
+    std::function<void()> write;
+  };
+  typedef QVector<OutputFile> OutputFiles;
+
   // Private Methods
-  void exportDrillsMerged(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsNpth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsPth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsBlindBuried(
+  OutputFiles exportDrillsMerged(
+      const BoardFabricationOutputSettings& settings) const;
+  OutputFiles exportDrillsNpth(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBoardOutlines(
+  OutputFiles exportDrillsPth(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopCopper(
+  OutputFiles exportDrillsBlindBuried(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerInnerCopper(
+  OutputFiles exportLayerBoardOutlines(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomCopper(
+  OutputFiles exportLayerTopCopper(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderMask(
+  OutputFiles exportLayerInnerCopper(
+      const BoardFabricationOutputSettings& settings, int number) const;
+  OutputFiles exportLayerBottomCopper(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomSolderMask(
+  OutputFiles exportLayerTopSolderMask(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSilkscreen(
+  OutputFiles exportLayerBottomSolderMask(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomSilkscreen(
+  OutputFiles exportLayerTopSilkscreen(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderPaste(
+  OutputFiles exportLayerBottomSilkscreen(
       const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomSolderPaste(
+  OutputFiles exportLayerTopSolderPaste(
+      const BoardFabricationOutputSettings& settings) const;
+  OutputFiles exportLayerBottomSolderPaste(
       const BoardFabricationOutputSettings& settings) const;
 
   int drawNpthDrills(ExcellonGenerator& gen) const;
@@ -140,11 +154,23 @@ private:
   std::unique_ptr<ExcellonGenerator> createExcellonGenerator(
       const BoardFabricationOutputSettings& settings,
       ExcellonGenerator::Plating plating) const;
-  FilePath getOutputFilePath(QString path) const noexcept;
-  QString getAttributeValue(const QString& key) const noexcept;
+  FilePath getOutputFilePath(QString path, int innerCopperLayer = 0,
+                             const Layer* startLayer = nullptr,
+                             const Layer* endLayer = nullptr) const noexcept;
+  QString getAttributeValue(const QString& key, int innerCopperLayer,
+                            const Layer* startLayer,
+                            const Layer* endLayer) const noexcept;
   void trackFileBeforeWrite(const FilePath& fp) const;
 
   // Static Methods
+  template <typename T>
+  static OutputFile generatedFile(const FilePath& fp,
+                                  std::shared_ptr<T> gen) noexcept {
+    return OutputFile{fp, [fp, gen]() { gen->saveToFile(fp); }};
+  }
+  static OutputFile obsoleteFile(const FilePath& fp) noexcept {
+    return OutputFile{fp, nullptr};
+  }
   static UnsignedLength calcWidthOfLayer(const UnsignedLength& width,
                                          const Layer& layer) noexcept;
 
@@ -155,9 +181,6 @@ private:
   BeforeWriteCallback mBeforeWriteCallback;
   QDateTime mCreationDateTime;
   QString mProjectName;
-  mutable int mCurrentInnerCopperLayer;
-  mutable const Layer* mCurrentStartLayer;
-  mutable const Layer* mCurrentEndLayer;
   mutable QVector<FilePath> mWrittenFiles;
 };
 
@@ -25,6 +25,7 @@
 #include "../../library/pkg/footprint.h"
 #include "../../library/pkg/footprintpad.h"
 #include "../../utils/clipperhelpers.h"
+#include "../../utils/spatialindex.h"
 #include "../../utils/transform.h"
 #include "../circuit/netsignal.h"
 #include "board.h"
@@ -45,6 +46,7 @@
 #include <QtCore>
 
 #include <algorithm>
+#include <limits>
 
 /*******************************************************************************
  *  Namespace
@@ -197,7 +199,8 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
                     plane->getOutline(), plane->getMinWidth(),
                     plane->getMinClearance(), plane->getKeepIslands(),
                     plane->getPriority(), plane->getConnectStyle(),
-                    plane->getThermalGap(), plane->getThermalSpokeWidth()});
+                    plane->getThermalGap(), plane->getThermalSpokeWidth(),
+                    plane->getFragments(), plane->getFragmentsHash()});
     }
   }
   foreach (const BI_Zone* zone, board.getZones()) {
@@ -309,6 +312,15 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
   ClipperHelpers::subtract(
       boardArea, ClipperHelpers::convert(boardCutouts, maxArcTolerance()),
       ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+  QCryptographicHash boardAreaHasher(QCryptographicHash::Sha256);
+  for (const ClipperLib::Path& path : boardArea) {
+    for (const ClipperLib::IntPoint& point : path) {
+      boardAreaHasher.addData(QByteArray::number(point.X).append(','));
+      boardAreaHasher.addData(QByteArray::number(point.Y).append(';'));
+    }
+    boardAreaHasher.addData("|");
+  }
+  const QByteArray boardAreaHash = boardAreaHasher.result();
 
   // Sort planes: First by priority, then by uuid to get a really unique
   // priority order over all existing planes. This way we can ensure that even
@@ -323,395 +335,787 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               }
             });
 
-  // Build all planes.
-  for (auto it = data->planes.begin(); it != data->planes.end(); it++) {
+  // Put all obstacles into a spatial index per layer, so each plane only
+  // needs to process the obstacles located close to it.
+  const QHash<const Layer*, LayerObstacles> obstacles =
+      buildObstacleIndex(*data);
+
+  // Determine the dependencies between the planes: A plane needs the
+  // fragments of all planes with higher priority on the same layer but with
+  // a different net, if they are close enough to affect each other. Planes
+  // without dependencies between each other are built in parallel.
+  const PlaneGraph graph = buildPlaneGraph(data->planes);
+
+  // Build all planes. Use a private thread pool since this method itself is
+  // usually run within the global thread pool.
+  QThreadPool pool;
+  QMutex mutex;
+  QWaitCondition planeFinishedCondition;
+  QVector<bool> startedPlanes(data->planes.count(), false);
+  QVector<bool> finishedPlanes(data->planes.count(), false);
+  int runningPlanes = 0;
+  int errorPlane = -1;
+  std::shared_ptr<Exception> error;
+  auto buildPlaneTask = [&](int index) {
+    const PlaneData& plane = data->planes.at(index);
+    QList<std::pair<const PlaneData*, QVector<Path>>> otherPlanes;
+    {
+      QMutexLocker lock(&mutex);
+      foreach (int dependency, graph.dependencies.at(index)) {
+        const PlaneData& otherPlane = data->planes.at(dependency);
+        otherPlanes.append(
+            std::make_pair(&otherPlane, data->result.value(otherPlane.uuid)));
+      }
+    }
+    // Note: The obstacles need to be searched within the maximum distance
+    // they could affect the plane, considering all the offsets applied to
+    // them in buildPlane().
+    const Length maxDistance =
+        std::max(*plane.minClearance, *plane.thermalGap) + *plane.minWidth +
+        *maxArcTolerance() + Length(1);
+    const PlaneObstacles planeObstacles = findObstacles(
+        obstacles.value(plane.layer),
+        SpatialIndex::grown(graph.rects.at(index), maxDistance.toNm()));
+    const QByteArray hash =
+        calculatePlaneHash(*data, plane, boardAreaHash, otherPlanes,
+                           planeObstacles);
+    tl::optional<QVector<Path>> fragments;
+    std::shared_ptr<Exception> planeError;
     try {
-      ClipperLib::Paths removedAreas;
-      ClipperLib::Paths connectedNetSignalAreas;
-
-      // Start with board outline shrinked by the given clearance.
-      ClipperLib::Paths fragments = boardArea;
-      ClipperHelpers::offset(fragments, -it->minClearance,
-                             maxArcTolerance());  // can throw
-      if (mAbort) {
-        break;
+      if (hash == plane.fragmentsHash) {
+        // Nothing relevant has changed since the last build, no need to
+        // calculate the same fragments again.
+        fragments = plane.fragments;
+      } else {
+        fragments =
+            buildPlane(*data, plane, boardArea, graph.outlines.at(index),
+                       otherPlanes, planeObstacles);  // can throw
       }
+    } catch (const Exception& e) {
+      planeError.reset(e.clone());
+    } catch (const std::exception& e) {
+      planeError = std::make_shared<RuntimeError>(__FILE__, __LINE__,
+                                                  QString(e.what()));
+    }
+    if (planeError) {
+      qCritical() << "Failed to calculate plane areas, leaving empty:"
+                  << planeError->getMsg();
+    }
+    QMutexLocker lock(&mutex);
+    if (fragments) {
+      data->result.insert(plane.uuid, *fragments);
+      data->resultHashes.insert(plane.uuid, hash);
+    }
+    if (planeError && exceptionOnError &&
+        ((errorPlane < 0) || (index < errorPlane))) {
+      errorPlane = index;
+      error = planeError;
+    }
+    finishedPlanes[index] = true;
+    --runningPlanes;
+    planeFinishedCondition.wakeAll();
+  };
+  {
+    QMutexLocker lock(&mutex);
+    while (true) {
+      // Start all planes whose dependencies are built. Stop starting planes
+      // on abort. On errors, only planes with higher priority than the failed
+      // one are still built, so the reported error is the one of the first
+      // failing plane in priority order, like in a sequential build.
+      for (int i = 0; (i < data->planes.count()) && (!mAbort) &&
+           ((errorPlane < 0) || (i < errorPlane));
+           ++i) {
+        if ((!startedPlanes.at(i)) &&
+            std::all_of(graph.dependencies.at(i).begin(),
+                        graph.dependencies.at(i).end(),
+                        [&](int k) { return finishedPlanes.at(k); })) {
+          startedPlanes[i] = true;
+          ++runningPlanes;
+          QtConcurrent::run(&pool, [&buildPlaneTask, i]() {
+            buildPlaneTask(i);
+          });
+        }
+      }
+      if (runningPlanes == 0) {
+        break;  // All planes finished, or aborted.
+      }
+      planeFinishedCondition.wait(&mutex);
+    }
+  }
+  pool.waitForDone();
+  if (error) {
+    error->raise();
+  }
 
-      // Clip to plane outline.
-      const ClipperLib::Path planeOutline = ClipperHelpers::convert(
-          it->outline.toClosedPath(), maxArcTolerance());
-      ClipperHelpers::intersect(fragments, {planeOutline},
-                                ClipperLib::pftEvenOdd,
-                                ClipperLib::pftEvenOdd);  // can throw
-      const ClipperLib::Paths fullPlaneArea = fragments;
-      if (mAbort) {
-        break;
+  if (mAbort) {
+    qDebug() << "Aborted calculating plane areas after" << timer.elapsed()
+             << "ms.";
+  } else {
+    data->finished = true;
+    qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
+  }
+
+  emit finished();
+  return data;
+}
+
+BoardPlaneFragmentsBuilder::PlaneGraph
+    BoardPlaneFragmentsBuilder::buildPlaneGraph(
+        const QList<PlaneData>& planes) noexcept {
+  PlaneGraph graph;
+  for (const PlaneData& plane : planes) {
+    graph.outlines.append(ClipperHelpers::convert(plane.outline.toClosedPath(),
+                                                  maxArcTolerance()));
+    graph.rects.append(SpatialIndex::boundingRect(graph.outlines.last()));
+  }
+  for (int i = 0; i < planes.count(); ++i) {
+    QVector<int> dependencies;
+    for (int k = 0; k < i; ++k) {
+      const PlaneData& plane = planes.at(i);
+      const PlaneData& other = planes.at(k);
+      if ((other.layer == plane.layer) &&
+          (other.netSignal != plane.netSignal)) {
+        // The fragments of the other plane are located within its outline and
+        // are grown by the clearance, so they can only affect this plane if
+        // the grown outline intersects this plane. Add some margin to be
+        // robust against inaccuracies of the offset operation.
+        const Length clearance = std::max(*plane.minClearance,
+                                          *other.minClearance) +
+            *maxArcTolerance() + Length(1);
+        if (SpatialIndex::intersects(
+                graph.rects.at(i),
+                SpatialIndex::grown(graph.rects.at(k), clearance.toNm()))) {
+          dependencies.append(k);
+        }
       }
+    }
+    graph.dependencies.append(dependencies);
+  }
+  return graph;
+}
 
-      // Collect other planes.
-      for (auto otherIt = data->planes.begin(); otherIt != it; otherIt++) {
-        if ((otherIt->layer == it->layer) &&
-            (otherIt->netSignal != it->netSignal)) {
-          const UnsignedLength clearance =
-              std::max(it->minClearance, otherIt->minClearance);
-          ClipperLib::Paths clipperPaths = ClipperHelpers::convert(
-              data->result.value(otherIt->uuid), maxArcTolerance());
-          ClipperHelpers::offset(clipperPaths, *clearance,
-                                 maxArcTolerance());  // can throw
-          removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                              clipperPaths.end());
+QHash<const Layer*, BoardPlaneFragmentsBuilder::LayerObstacles>
+    BoardPlaneFragmentsBuilder::buildObstacleIndex(
+        const JobData& data) noexcept {
+  QHash<const Layer*, QVector<std::pair<ObstacleType, int>>> items;
+  QHash<const Layer*, QVector<SpatialIndex::Rect>> rects;
+  auto add = [&](const Layer* layer, ObstacleType type, int index,
+                 const SpatialIndex::Rect& rect) {
+    if (data.layers.contains(layer)) {
+      items[layer].append(std::make_pair(type, index));
+      rects[layer].append(rect);
+    }
+  };
+  auto pathsRect = [](const QVector<Path>& paths) {
+    return SpatialIndex::boundingRect(
+        ClipperHelpers::convert(paths, maxArcTolerance()));
+  };
+
+  // Note: Obstacles must be added ordered by type and index to keep the
+  // order of processing them the same as without the spatial index.
+  for (int i = 0; i < data.keepoutZones.count(); ++i) {
+    const KeepoutZoneData& zone = data.keepoutZones.at(i);
+    const SpatialIndex::Rect rect = pathsRect({zone.outline});
+    foreach (const Layer* layer, zone.boardLayers) {
+      add(layer, ObstacleType::KeepoutZone, i, rect);
+    }
+  }
+  for (int i = 0; i < data.holes.count(); ++i) {
+    const auto& tuple = data.holes.at(i);
+    const SpatialIndex::Rect rect =
+        pathsRect(std::get<2>(tuple)->toOutlineStrokes(std::get<1>(tuple)));
+    foreach (const Layer* layer, data.layers) {
+      add(layer, ObstacleType::Hole, i, rect);
+    }
+  }
+  for (int i = 0; i < data.vias.count(); ++i) {
+    const ViaData& via = data.vias.at(i);
+    const ClipperLib::cInt radius = (via.diameter->toNm() / 2) + 1;
+    const ClipperLib::IntPoint center = ClipperHelpers::convert(via.position);
+    const SpatialIndex::Rect rect{center.X - radius, center.Y - radius,
+                                  center.X + radius, center.Y + radius};
+    foreach (const Layer* layer, data.layers) {
+      if ((via.startLayer->getCopperNumber() <= layer->getCopperNumber()) &&
+          (via.endLayer->getCopperNumber() >= layer->getCopperNumber())) {
+        add(layer, ObstacleType::Via, i, rect);
+      }
+    }
+  }
+  for (int i = 0; i < data.polygons.count(); ++i) {
+    const PolygonData& polygon = data.polygons.at(i);
+    const SpatialIndex::Rect rect = SpatialIndex::grown(
+        pathsRect({polygon.path}), (polygon.width->toNm() / 2) + 1);
+    add(polygon.layer, ObstacleType::Polygon, i, rect);
+  }
+  for (int i = 0; i < data.pads.count(); ++i) {
+    const PadData& pad = data.pads.at(i);
+    for (auto it = pad.geometries.begin(); it != pad.geometries.end(); it++) {
+      SpatialIndex::Rect rect = SpatialIndex::emptyRect();
+      try {
+        foreach (const PadGeometry& geometry, it.value()) {
+          rect = SpatialIndex::united(
+              rect, pathsRect(pad.transform.map(geometry.toOutlines())));
+          for (const PadHole& hole : geometry.getHoles()) {
+            rect = SpatialIndex::united(
+                rect,
+                pathsRect(pad.transform.map(
+                    hole.getPath()->toOutlineStrokes(hole.getDiameter()))));
+          }
         }
+        rect = SpatialIndex::grown(rect, pad.clearance->toNm());
+      } catch (const Exception&) {
+        // Make sure the pad is not skipped, the error will be handled when
+        // building the planes.
+        const ClipperLib::cInt max =
+            std::numeric_limits<ClipperLib::cInt>::max();
+        rect = SpatialIndex::Rect{-max, -max, max, max};
       }
-      if (mAbort) {
+      add(it.key(), ObstacleType::Pad, i, rect);
+    }
+  }
+
+  QHash<const Layer*, LayerObstacles> obstacles;
+  for (auto it = items.begin(); it != items.end(); it++) {
+    obstacles.insert(it.key(),
+                     LayerObstacles{it.value(), SpatialIndex(rects[it.key()])});
+  }
+  return obstacles;
+}
+
+BoardPlaneFragmentsBuilder::PlaneObstacles
+    BoardPlaneFragmentsBuilder::findObstacles(
+        const LayerObstacles& obstacles,
+        const SpatialIndex::Rect& rect) noexcept {
+  PlaneObstacles result;
+  foreach (int i, obstacles.index.find(rect)) {
+    const std::pair<ObstacleType, int>& item = obstacles.items.at(i);
+    switch (item.first) {
+      case ObstacleType::KeepoutZone:
+        result.keepoutZones.append(item.second);
+        break;
+      case ObstacleType::Hole:
+        result.holes.append(item.second);
+        break;
+      case ObstacleType::Via:
+        result.vias.append(item.second);
+        break;
+      case ObstacleType::Polygon:
+        result.polygons.append(item.second);
         break;
+      case ObstacleType::Pad:
+        result.pads.append(item.second);
+        break;
+    }
+  }
+  return result;
+}
+
+QByteArray BoardPlaneFragmentsBuilder::calculatePlaneHash(
+    const JobData& data, const PlaneData& plane,
+    const QByteArray& boardAreaHash,
+    const QList<std::pair<const PlaneData*, QVector<Path>>>& otherPlanes,
+    const PlaneObstacles& obstacles) noexcept {
+  // Note: This method is called from different threads in parallel, thus be
+  //       careful to only call thread-safe methods!
+  //
+  // All data used by buildPlane() must be taken into account here, otherwise
+  // outdated fragments would be reused. But only the obstacles actually
+  // affecting the plane are added, to avoid rebuilding planes if unrelated
+  // objects (e.g. on a different layer) were modified.
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  auto addNumber = [&hash](qint64 value) {
+    hash.addData(QByteArray::number(value).append(';'));
+  };
+  auto addString = [&hash, &addNumber](const QString& value) {
+    const QByteArray utf8 = value.toUtf8();
+    addNumber(utf8.length());
+    hash.addData(utf8);
+  };
+  auto addPoint = [&addNumber](const Point& point) {
+    addNumber(point.getX().toNm());
+    addNumber(point.getY().toNm());
+  };
+  auto addPath = [&addNumber, &addPoint](const Path& path) {
+    addNumber(path.getVertices().count());
+    for (const Vertex& vertex : path.getVertices()) {
+      addPoint(vertex.getPos());
+      addNumber(vertex.getAngle().toMicroDeg());
+    }
+  };
+  auto addTransform = [&addNumber, &addPoint](const Transform& transform) {
+    addPoint(transform.getPosition());
+    addNumber(transform.getRotation().toMicroDeg());
+    addNumber(transform.getMirrored());
+  };
+
+  // Algorithm version, to be incremented whenever buildPlane() is modified
+  // in a way leading to different results.
+  addString("plane_v1");
+  addNumber(maxArcTolerance()->toNm());
+
+  // Plane properties.
+  addString(plane.layer->getId());
+  addNumber(plane.netSignal.has_value());
+  addPath(plane.outline);
+  addNumber(plane.minWidth->toNm());
+  addNumber(plane.minClearance->toNm());
+  addNumber(plane.keepIslands);
+  addNumber(static_cast<int>(plane.connectStyle));
+  addNumber(plane.thermalGap->toNm());
+  addNumber(plane.thermalSpokeWidth->toNm());
+  hash.addData(boardAreaHash);
+
+  // Other planes.
+  for (const auto& otherPlane : otherPlanes) {
+    addNumber(otherPlane.first->minClearance->toNm());
+    addNumber(otherPlane.second.count());
+    foreach (const Path& fragment, otherPlane.second) {
+      addPath(fragment);
+    }
+  }
+
+  // Keepout zones.
+  addString("zones");
+  foreach (int index, obstacles.keepoutZones) {
+    const KeepoutZoneData& zone = data.keepoutZones.at(index);
+    if (zone.boardLayers.contains(plane.layer)) {
+      addPath(zone.outline);
+    }
+  }
+
+  // Holes.
+  addString("holes");
+  foreach (int index, obstacles.holes) {
+    const auto& tuple = data.holes.at(index);
+    addNumber(std::get<1>(tuple)->toNm());
+    addPath(*std::get<2>(tuple));
+  }
+
+  // Vias.
+  addString("vias");
+  foreach (int index, obstacles.vias) {
+    const ViaData& via = data.vias.at(index);
+    if ((via.startLayer->getCopperNumber() <=
+         plane.layer->getCopperNumber()) &&
+        (via.endLayer->getCopperNumber() >= plane.layer->getCopperNumber())) {
+      addNumber(plane.netSignal && (via.netSignal == plane.netSignal));
+      addPoint(via.position);
+      addNumber(via.diameter->toNm());
+    }
+  }
+
+  // Polygons & traces.
+  addString("polygons");
+  foreach (int index, obstacles.polygons) {
+    const PolygonData& polygon = data.polygons.at(index);
+    if (polygon.layer == plane.layer) {
+      addNumber(plane.netSignal && (polygon.netSignal == plane.netSignal));
+      addPath(polygon.path);
+      addNumber(polygon.width->toNm());
+      addNumber(polygon.filled);
+    }
+  }
+
+  // Pads.
+  addString("pads");
+  foreach (int index, obstacles.pads) {
+    const PadData& pad = data.pads.at(index);
+    addNumber(plane.netSignal && (pad.netSignal == plane.netSignal));
+    addTransform(pad.transform);
+    addNumber(pad.clearance->toNm());
+    const QList<PadGeometry> geometries = pad.geometries.value(plane.layer);
+    addNumber(geometries.count());
+    foreach (const PadGeometry& geometry, geometries) {
+      addNumber(static_cast<int>(geometry.getShape()));
+      addNumber(geometry.getWidth().toNm());
+      addNumber(geometry.getHeight().toNm());
+      addNumber(geometry.getCornerRadius()->toNm());
+      addPath(geometry.getPath());
+      addNumber(geometry.getHoles().count());
+      for (const PadHole& hole : geometry.getHoles()) {
+        addNumber(hole.getDiameter()->toNm());
+        addPath(*hole.getPath());
       }
+    }
+  }
+
+  return hash.result();
+}
+
+tl::optional<QVector<Path>> BoardPlaneFragmentsBuilder::buildPlane(
+    const JobData& data, const PlaneData& plane,
+    const ClipperLib::Paths& boardArea, const ClipperLib::Path& planeOutline,
+    const QList<std::pair<const PlaneData*, QVector<Path>>>& otherPlanes,
+    const PlaneObstacles& obstacles) const {
+  // Note: This method is called from different threads in parallel, thus be
+  //       careful to only call thread-safe methods!
+
+  ClipperLib::Paths removedAreas;
+  ClipperLib::Paths connectedNetSignalAreas;
+
+  // Start with board outline shrinked by the given clearance.
+  ClipperLib::Paths fragments = boardArea;
+  ClipperHelpers::offset(fragments, -plane.minClearance,
+                         maxArcTolerance());  // can throw
+  if (mAbort) {
+    return tl::nullopt;
+  }
+
+  // Clip to plane outline.
+  ClipperHelpers::intersect(fragments, {planeOutline},
+                            ClipperLib::pftEvenOdd,
+                            ClipperLib::pftEvenOdd);  // can throw
+  const ClipperLib::Paths fullPlaneArea = fragments;
+  if (mAbort) {
+    return tl::nullopt;
+  }
+
+  // Collect other planes.
+  for (const auto& otherPlane : otherPlanes) {
+    const UnsignedLength clearance =
+        std::max(plane.minClearance, otherPlane.first->minClearance);
+    ClipperLib::Paths clipperPaths =
+        ClipperHelpers::convert(otherPlane.second, maxArcTolerance());
+    ClipperHelpers::offset(clipperPaths, *clearance,
+                           maxArcTolerance());  // can throw
+    removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
+                        clipperPaths.end());
+  }
+  if (mAbort) {
+    return tl::nullopt;
+  }
+
+  // Collect keepout zones.
+  foreach (int index, obstacles.keepoutZones) {
+    const KeepoutZoneData& zone = data.keepoutZones.at(index);
+    if (zone.boardLayers.contains(plane.layer)) {
+      const ClipperLib::Path clipperPath =
+          ClipperHelpers::convert(zone.outline, maxArcTolerance());
+      removedAreas.push_back(clipperPath);
+    }
+  }
+
+  // Collect holes.
+  foreach (int index, obstacles.holes) {
+    const auto& tuple = data.holes.at(index);
+    const PositiveLength diameter(std::get<1>(tuple) +
+                                  plane.minClearance * 2);
+    const QVector<Path> paths =
+        std::get<2>(tuple)->toOutlineStrokes(diameter);
+    const ClipperLib::Paths clipperPaths =
+        ClipperHelpers::convert(paths, maxArcTolerance());
+    removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
+                        clipperPaths.end());
+  }
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Collect keepout zones.
-      foreach (const KeepoutZoneData& zone, data->keepoutZones) {
-        if (zone.boardLayers.contains(it->layer)) {
+  // Collect vias.
+  foreach (int index, obstacles.vias) {
+    const ViaData& via = data.vias.at(index);
+    if ((via.startLayer->getCopperNumber() >
+         plane.layer->getCopperNumber()) ||
+        (via.endLayer->getCopperNumber() < plane.layer->getCopperNumber())) {
+      continue;
+    }
+    if (plane.netSignal && (via.netSignal == plane.netSignal)) {
+      // Via has same net as plane -> no cut-out.
+      // Note: Do not respect the plane connect style for vias, but always
+      // connect them with solid style. Since vias are not soldered, heat
+      // dissipation is not an issue or often even desired. See discussion
+      // https://github.com/LibrePCB/LibrePCB/issues/454#issuecomment-1373402172
+      const Path path = Path::circle(via.diameter).translated(via.position);
+      connectedNetSignalAreas.push_back(
+          ClipperHelpers::convert(path, maxArcTolerance()));
+    } else {
+      // Vias has different net than plane -> subtract with clearance.
+      const Path path =
+          Path::circle(PositiveLength(via.diameter + plane.minClearance * 2))
+              .translated(via.position);
+      const ClipperLib::Path clipperPath =
+          ClipperHelpers::convert(path, maxArcTolerance());
+      removedAreas.push_back(clipperPath);
+    }
+  }
+  if (mAbort) {
+    return tl::nullopt;
+  }
+
+  // Collect traces & other strokes.
+  foreach (int index, obstacles.polygons) {
+    const PolygonData& polygon = data.polygons.at(index);
+    if (polygon.layer == plane.layer) {
+      if (plane.netSignal && (polygon.netSignal == plane.netSignal)) {
+        // Same net signal -> memorize as connected area.
+        if (polygon.filled) {
+          // Area.
           const ClipperLib::Path clipperPath =
-              ClipperHelpers::convert(zone.outline, maxArcTolerance());
-          removedAreas.push_back(clipperPath);
+              ClipperHelpers::convert(polygon.path, maxArcTolerance());
+          connectedNetSignalAreas.push_back(clipperPath);
+        }
+        if ((!polygon.filled) || (polygon.width > 0)) {
+          // Outline strokes.
+          const QVector<Path> paths = polygon.path.toOutlineStrokes(
+              PositiveLength(std::max(*polygon.width, Length(1))));
+          const ClipperLib::Paths clipperPaths =
+              ClipperHelpers::convert(paths, maxArcTolerance());
+          connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
+                                         clipperPaths.begin(),
+                                         clipperPaths.end());
+        }
+      } else {
+        // Different net signal -> subtract with clearance.
+        if (polygon.filled) {
+          // Area.
+          ClipperLib::Paths clipperPaths{
+              ClipperHelpers::convert(polygon.path, maxArcTolerance())};
+          ClipperHelpers::offset(clipperPaths, *plane.minClearance,
+                                 maxArcTolerance());  // can throw
+          removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
+                              clipperPaths.end());
+        }
+        if ((!polygon.filled) || (polygon.width > 0)) {
+          // Outline strokes.
+          const QVector<Path> paths =
+              polygon.path.toOutlineStrokes(PositiveLength(std::max(
+                  *polygon.width + plane.minClearance * 2, Length(1))));
+          const ClipperLib::Paths clipperPaths =
+              ClipperHelpers::convert(paths, maxArcTolerance());
+          removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
+                              clipperPaths.end());
         }
       }
+    }
+  }
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Collect holes.
-      foreach (const auto& tuple, data->holes) {
-        const PositiveLength diameter(std::get<1>(tuple) +
-                                      it->minClearance * 2);
+  // Collect pads.
+  ClipperLib::Paths thermalPadAreas;
+  ClipperLib::Paths thermalPadAreasShrinked;
+  ClipperLib::Paths thermalPadClearanceAreas;
+  foreach (int index, obstacles.pads) {
+    const PadData& pad = data.pads.at(index);
+    const bool sameNet = plane.netSignal && (pad.netSignal == plane.netSignal);
+    foreach (const PadGeometry& geometry, pad.geometries.value(plane.layer)) {
+      if (sameNet) {
+        // Same net signal -> memorize as connected area.
         const QVector<Path> paths =
-            std::get<2>(tuple)->toOutlineStrokes(diameter);
+            pad.transform.map(geometry.toOutlines());
         const ClipperLib::Paths clipperPaths =
             ClipperHelpers::convert(paths, maxArcTolerance());
-        removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                            clipperPaths.end());
-      }
-      if (mAbort) {
-        break;
-      }
-
-      // Collect vias.
-      foreach (const ViaData& via, data->vias) {
-        if ((via.startLayer->getCopperNumber() >
-             it->layer->getCopperNumber()) ||
-            (via.endLayer->getCopperNumber() < it->layer->getCopperNumber())) {
-          continue;
-        }
-        if (it->netSignal && (via.netSignal == it->netSignal)) {
-          // Via has same net as plane -> no cut-out.
-          // Note: Do not respect the plane connect style for vias, but always
-          // connect them with solid style. Since vias are not soldered, heat
-          // dissipation is not an issue or often even desired. See discussion
-          // https://github.com/LibrePCB/LibrePCB/issues/454#issuecomment-1373402172
-          const Path path = Path::circle(via.diameter).translated(via.position);
-          connectedNetSignalAreas.push_back(
-              ClipperHelpers::convert(path, maxArcTolerance()));
-        } else {
-          // Vias has different net than plane -> subtract with clearance.
-          const Path path =
-              Path::circle(PositiveLength(via.diameter + it->minClearance * 2))
-                  .translated(via.position);
-          const ClipperLib::Path clipperPath =
-              ClipperHelpers::convert(path, maxArcTolerance());
-          removedAreas.push_back(clipperPath);
-        }
-      }
-      if (mAbort) {
-        break;
+        connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
+                                       clipperPaths.begin(),
+                                       clipperPaths.end());
       }
+      if ((!sameNet) ||
+          (plane.connectStyle != BI_Plane::ConnectStyle::Solid)) {
+        // Determine required clearance. For connection style 'none' for
+        // pads of the same net, use the thermal gap clearance since usually
+        // it is smaller than the planes clearance, so it leads to a higher
+        // plane area.
+        const Length clearance = std::max(
+            sameNet ? *plane.thermalGap : *plane.minClearance, *pad.clearance);
+        QVector<Path> paths =
+            pad.transform.map(geometry.withOffset(clearance).toOutlines());
+        ClipperLib::Paths clipperPaths =
+            ClipperHelpers::convert(paths, maxArcTolerance());
 
-      // Collect traces & other strokes.
-      foreach (const PolygonData& polygon, data->polygons) {
-        if (polygon.layer == it->layer) {
-          if (it->netSignal && (polygon.netSignal == it->netSignal)) {
-            // Same net signal -> memorize as connected area.
-            if (polygon.filled) {
-              // Area.
-              const ClipperLib::Path clipperPath =
-                  ClipperHelpers::convert(polygon.path, maxArcTolerance());
-              connectedNetSignalAreas.push_back(clipperPath);
-            }
-            if ((!polygon.filled) || (polygon.width > 0)) {
-              // Outline strokes.
-              const QVector<Path> paths = polygon.path.toOutlineStrokes(
-                  PositiveLength(std::max(*polygon.width, Length(1))));
-              const ClipperLib::Paths clipperPaths =
-                  ClipperHelpers::convert(paths, maxArcTolerance());
-              connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
-                                             clipperPaths.begin(),
-                                             clipperPaths.end());
-            }
-          } else {
-            // Different net signal -> subtract with clearance.
-            if (polygon.filled) {
-              // Area.
-              ClipperLib::Paths clipperPaths{
-                  ClipperHelpers::convert(polygon.path, maxArcTolerance())};
-              ClipperHelpers::offset(clipperPaths, *it->minClearance,
-                                     maxArcTolerance());  // can throw
-              removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                  clipperPaths.end());
-            }
-            if ((!polygon.filled) || (polygon.width > 0)) {
-              // Outline strokes.
-              const QVector<Path> paths =
-                  polygon.path.toOutlineStrokes(PositiveLength(std::max(
-                      *polygon.width + it->minClearance * 2, Length(1))));
-              const ClipperLib::Paths clipperPaths =
-                  ClipperHelpers::convert(paths, maxArcTolerance());
-              removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                  clipperPaths.end());
-            }
+        // For thermal relief connection, subtract the spokes from the
+        // cutout.
+        if (sameNet &&
+            (plane.connectStyle == BI_Plane::ConnectStyle::ThermalRelief) &&
+            ClipperHelpers::anyPointsInside(clipperPaths, planeOutline)) {
+          // Note: Make spokes *slightly* thicker to avoid them to be
+          // removed due to numerical inaccuary of minimum width procedure.
+          const PositiveLength spokeWidth(plane.thermalSpokeWidth + 10);
+          const Length spokeLength(100000000);  // Maximum spoke length.
+          foreach (const auto& spokeConfig,
+                   determineThermalSpokes(geometry)) {
+            const Point p1 =
+                spokeConfig.first.rotated(pad.transform.getRotation()) +
+                pad.transform.getPosition();
+            const Point p2 =
+                (Point(spokeLength, 0).rotated(spokeConfig.second) +
+                 spokeConfig.first)
+                    .rotated(pad.transform.getRotation()) +
+                pad.transform.getPosition();
+            const ClipperLib::Paths spokePaths{ClipperHelpers::convert(
+                Path::obround(p1, p2, spokeWidth), maxArcTolerance())};
+            ClipperHelpers::subtract(clipperPaths, spokePaths,
+                                     ClipperLib::pftEvenOdd,
+                                     ClipperLib::pftNonZero);  // can throw
           }
+          // Memorize copper area for later removal of unconnected
+          // thermal spokes,
+          ClipperLib::Paths tmp = ClipperHelpers::convert(
+              pad.transform.map(geometry.toOutlines()), maxArcTolerance());
+          if (tmp.size() > 1) {
+            ClipperHelpers::unite(tmp,
+                                  ClipperLib::pftNonZero);  // can throw
+          }
+          thermalPadAreas.insert(thermalPadAreas.end(), tmp.begin(),
+                                 tmp.end());
+          // Memorize clearance area for later removal of unconnected
+          // thermal spokes,
+          Length offset = clearance + plane.minWidth - maxArcTolerance() - 10;
+          tmp = ClipperHelpers::convert(
+              pad.transform.map(geometry.withOffset(offset).toOutlines()),
+              maxArcTolerance());
+          if (tmp.size() > 1) {
+            ClipperHelpers::unite(tmp,
+                                  ClipperLib::pftNonZero);  // can throw
+          }
+          thermalPadClearanceAreas.insert(thermalPadClearanceAreas.end(),
+                                          tmp.begin(), tmp.end());
+          // Memorize slightly shrinked copper area for later removal of
+          // unconnected thermal spokes,
+          offset = -maxArcTolerance() - 10;
+          tmp = ClipperHelpers::convert(
+              pad.transform.map(geometry.withOffset(offset).toOutlines()),
+              maxArcTolerance());
+          thermalPadAreasShrinked.insert(thermalPadAreasShrinked.end(),
+                                         tmp.begin(), tmp.end());
         }
-      }
-      if (mAbort) {
-        break;
-      }
+        removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
+                            clipperPaths.end());
 
-      // Collect pads.
-      ClipperLib::Paths thermalPadAreas;
-      ClipperLib::Paths thermalPadAreasShrinked;
-      ClipperLib::Paths thermalPadClearanceAreas;
-      foreach (const PadData& pad, data->pads) {
-        const bool sameNet = it->netSignal && (pad.netSignal == it->netSignal);
-        foreach (const PadGeometry& geometry, pad.geometries.value(it->layer)) {
-          if (sameNet) {
-            // Same net signal -> memorize as connected area.
-            const QVector<Path> paths =
-                pad.transform.map(geometry.toOutlines());
-            const ClipperLib::Paths clipperPaths =
-                ClipperHelpers::convert(paths, maxArcTolerance());
-            connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
-                                           clipperPaths.begin(),
-                                           clipperPaths.end());
-          }
-          if ((!sameNet) ||
-              (it->connectStyle != BI_Plane::ConnectStyle::Solid)) {
-            // Determine required clearance. For connection style 'none' for
-            // pads of the same net, use the thermal gap clearance since usually
-            // it is smaller than the planes clearance, so it leads to a higher
-            // plane area.
-            const Length clearance = std::max(
-                sameNet ? *it->thermalGap : *it->minClearance, *pad.clearance);
-            QVector<Path> paths =
-                pad.transform.map(geometry.withOffset(clearance).toOutlines());
-            ClipperLib::Paths clipperPaths =
+        // Also create cut-outs for each hole to ensure correct clearance
+        // even if the pad outline is too small or invalid.
+        if (!sameNet) {
+          for (const PadHole& hole : geometry.getHoles()) {
+            const PositiveLength width(hole.getDiameter() +
+                                       (clearance * 2));
+            paths =
+                pad.transform.map(hole.getPath()->toOutlineStrokes(width));
+            clipperPaths =
                 ClipperHelpers::convert(paths, maxArcTolerance());
-
-            // For thermal relief connection, subtract the spokes from the
-            // cutout.
-            if (sameNet &&
-                (it->connectStyle == BI_Plane::ConnectStyle::ThermalRelief) &&
-                ClipperHelpers::anyPointsInside(clipperPaths, planeOutline)) {
-              // Note: Make spokes *slightly* thicker to avoid them to be
-              // removed due to numerical inaccuary of minimum width procedure.
-              const PositiveLength spokeWidth(it->thermalSpokeWidth + 10);
-              const Length spokeLength(100000000);  // Maximum spoke length.
-              foreach (const auto& spokeConfig,
-                       determineThermalSpokes(geometry)) {
-                const Point p1 =
-                    spokeConfig.first.rotated(pad.transform.getRotation()) +
-                    pad.transform.getPosition();
-                const Point p2 =
-                    (Point(spokeLength, 0).rotated(spokeConfig.second) +
-                     spokeConfig.first)
-                        .rotated(pad.transform.getRotation()) +
-                    pad.transform.getPosition();
-                const ClipperLib::Paths spokePaths{ClipperHelpers::convert(
-                    Path::obround(p1, p2, spokeWidth), maxArcTolerance())};
-                ClipperHelpers::subtract(clipperPaths, spokePaths,
-                                         ClipperLib::pftEvenOdd,
-                                         ClipperLib::pftNonZero);  // can throw
-              }
-              // Memorize copper area for later removal of unconnected
-              // thermal spokes,
-              ClipperLib::Paths tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.toOutlines()), maxArcTolerance());
-              if (tmp.size() > 1) {
-                ClipperHelpers::unite(tmp,
-                                      ClipperLib::pftNonZero);  // can throw
-              }
-              thermalPadAreas.insert(thermalPadAreas.end(), tmp.begin(),
-                                     tmp.end());
-              // Memorize clearance area for later removal of unconnected
-              // thermal spokes,
-              Length offset = clearance + it->minWidth - maxArcTolerance() - 10;
-              tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.withOffset(offset).toOutlines()),
-                  maxArcTolerance());
-              if (tmp.size() > 1) {
-                ClipperHelpers::unite(tmp,
-                                      ClipperLib::pftNonZero);  // can throw
-              }
-              thermalPadClearanceAreas.insert(thermalPadClearanceAreas.end(),
-                                              tmp.begin(), tmp.end());
-              // Memorize slightly shrinked copper area for later removal of
-              // unconnected thermal spokes,
-              offset = -maxArcTolerance() - 10;
-              tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.withOffset(offset).toOutlines()),
-                  maxArcTolerance());
-              thermalPadAreasShrinked.insert(thermalPadAreasShrinked.end(),
-                                             tmp.begin(), tmp.end());
-            }
             removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
                                 clipperPaths.end());
-
-            // Also create cut-outs for each hole to ensure correct clearance
-            // even if the pad outline is too small or invalid.
-            if (!sameNet) {
-              for (const PadHole& hole : geometry.getHoles()) {
-                const PositiveLength width(hole.getDiameter() +
-                                           (clearance * 2));
-                paths =
-                    pad.transform.map(hole.getPath()->toOutlineStrokes(width));
-                clipperPaths =
-                    ClipperHelpers::convert(paths, maxArcTolerance());
-                removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                    clipperPaths.end());
-              }
-            }
           }
         }
-        if (mAbort) {
-          break;
-        }
-      }
-      if (mAbort) {
-        break;
       }
+    }
+    if (mAbort) {
+      break;
+    }
+  }
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Subtract all the collected areas to remove.
-      ClipperHelpers::subtract(fragments, removedAreas, ClipperLib::pftEvenOdd,
-                               ClipperLib::pftNonZero);
-      if (mAbort) {
-        break;
-      }
+  // Subtract all the collected areas to remove.
+  ClipperHelpers::subtract(fragments, removedAreas, ClipperLib::pftEvenOdd,
+                           ClipperLib::pftNonZero);
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Ensure minimum width. Reduce minWidth by 1nm to ensure plane areas
-      // do not disappear between two objects with a distance of *exactly*
-      // 2*minClearance+minWidth (e.g. two 0.5mm traces on a 1.0mm grid).
-      const Length minWidthOffset = (it->minWidth / 2) - 1;
-      if (minWidthOffset > 0) {
-        ClipperHelpers::offset(fragments, -minWidthOffset,
-                               maxArcTolerance());  // can throw
-        ClipperHelpers::offset(fragments, minWidthOffset,
-                               maxArcTolerance());  // can throw
-      }
-      if (mAbort) {
-        break;
-      }
+  // Ensure minimum width. Reduce minWidth by 1nm to ensure plane areas
+  // do not disappear between two objects with a distance of *exactly*
+  // 2*minClearance+minWidth (e.g. two 0.5mm traces on a 1.0mm grid).
+  const Length minWidthOffset = (plane.minWidth / 2) - 1;
+  if (minWidthOffset > 0) {
+    ClipperHelpers::offset(fragments, -minWidthOffset,
+                           maxArcTolerance());  // can throw
+    ClipperHelpers::offset(fragments, minWidthOffset,
+                           maxArcTolerance());  // can throw
+  }
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Split thermal spokes and flatten result for detecting unconnected
-      // thermal spokes.
-      std::unique_ptr<ClipperLib::PolyTree> tree =
-          ClipperHelpers::subtractToTree(fragments, thermalPadAreasShrinked,
-                                         ClipperLib::pftEvenOdd,
-                                         ClipperLib::pftNonZero);  // can throw
-      fragments = ClipperHelpers::flattenTree(*tree);  // can throw
-      if (mAbort) {
-        break;
-      }
+  // Split thermal spokes and flatten result for detecting unconnected
+  // thermal spokes.
+  std::unique_ptr<ClipperLib::PolyTree> tree =
+      ClipperHelpers::subtractToTree(fragments, thermalPadAreasShrinked,
+                                     ClipperLib::pftEvenOdd,
+                                     ClipperLib::pftNonZero);  // can throw
+  fragments = ClipperHelpers::flattenTree(*tree);  // can throw
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Remove unconnected thermal spokes.
-      if (thermalPadAreas.size() != thermalPadClearanceAreas.size()) {
-        throw LogicError(
-            __FILE__, __LINE__,
-            "Thermal pads inconsistency, please open a bug report.");
-      }
-      auto isUnconnectedSpoke = [&](const ClipperLib::Path& fragment) {
-        tl::optional<std::size_t> padIndex;
-        for (std::size_t i = 0; i < thermalPadAreas.size(); ++i) {
-          if (ClipperHelpers::anyPointsInside(fragment,
-                                              thermalPadAreas.at(i))) {
-            if (padIndex) {
-              return false;
-            } else {
-              padIndex = i;
-            }
-          }
+  // Remove unconnected thermal spokes.
+  if (thermalPadAreas.size() != thermalPadClearanceAreas.size()) {
+    throw LogicError(
+        __FILE__, __LINE__,
+        "Thermal pads inconsistency, please open a bug report.");
+  }
+  auto isUnconnectedSpoke = [&](const ClipperLib::Path& fragment) {
+    tl::optional<std::size_t> padIndex;
+    for (std::size_t i = 0; i < thermalPadAreas.size(); ++i) {
+      if (ClipperHelpers::anyPointsInside(fragment,
+                                          thermalPadAreas.at(i))) {
+        if (padIndex) {
+          return false;
+        } else {
+          padIndex = i;
         }
-        return padIndex &&
-            ClipperHelpers::allPointsInside(
-                   fragment, thermalPadClearanceAreas.at(*padIndex));
-      };
-      fragments.erase(std::remove_if(fragments.begin(), fragments.end(),
-                                     isUnconnectedSpoke),
-                      fragments.end());
-      if (mAbort) {
-        break;
-      }
-
-      // Fill thermal pads.
-      ClipperHelpers::intersect(thermalPadAreas, fullPlaneArea,
-                                ClipperLib::pftNonZero,
-                                ClipperLib::pftEvenOdd);  // can throw
-      tree = ClipperHelpers::uniteToTree(fragments, thermalPadAreas,
-                                         ClipperLib::pftEvenOdd,
-                                         ClipperLib::pftNonZero);  // can throw
-      fragments = ClipperHelpers::flattenTree(*tree);  // can throw
-      if (mAbort) {
-        break;
-      }
-
-      // If requested, remove unconnected fragments (islands).
-      if (it->netSignal && (!it->keepIslands)) {
-        auto isIsland = [&](const ClipperLib::Path& p) {
-          ClipperLib::Paths intersections{p};
-          ClipperHelpers::intersect(intersections, connectedNetSignalAreas,
-                                    ClipperLib::pftNonZero,
-                                    ClipperLib::pftNonZero);  // can throw
-          return intersections.empty();
-        };
-        fragments.erase(
-            std::remove_if(fragments.begin(), fragments.end(), isIsland),
-            fragments.end());
-      }
-      if (mAbort) {
-        break;
       }
+    }
+    return padIndex &&
+        ClipperHelpers::allPointsInside(
+               fragment, thermalPadClearanceAreas.at(*padIndex));
+  };
+  fragments.erase(std::remove_if(fragments.begin(), fragments.end(),
+                                 isUnconnectedSpoke),
+                  fragments.end());
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Make result canonical for a reproducible output by rotating and
-      // sorting the fragments.
-      auto cmp = [](const ClipperLib::IntPoint& a,
-                    const ClipperLib::IntPoint& b) {
-        return (a.X < b.X) || ((a.X == b.X) && (a.Y < b.Y));
-      };
-      for (ClipperLib::Path& path : fragments) {
-        Q_ASSERT(!path.empty());
-        auto minIt = std::min_element(path.begin(), path.end(), cmp);
-        std::rotate(path.begin(), minIt, path.end());
-      }
-      std::sort(fragments.begin(), fragments.end(),
-                [&cmp](const ClipperLib::Path& a, const ClipperLib::Path& b) {
-                  return cmp(a.front(), b.front());
-                });
-      if (mAbort) {
-        break;
-      }
+  // Fill thermal pads.
+  ClipperHelpers::intersect(thermalPadAreas, fullPlaneArea,
+                            ClipperLib::pftNonZero,
+                            ClipperLib::pftEvenOdd);  // can throw
+  tree = ClipperHelpers::uniteToTree(fragments, thermalPadAreas,
+                                     ClipperLib::pftEvenOdd,
+                                     ClipperLib::pftNonZero);  // can throw
+  fragments = ClipperHelpers::flattenTree(*tree);  // can throw
+  if (mAbort) {
+    return tl::nullopt;
+  }
 
-      // Memorize fragments for this plane.
-      data->result[it->uuid] = ClipperHelpers::convert(fragments);
-    } catch (const Exception& e) {
-      qCritical() << "Failed to calculate plane areas, leaving empty:"
-                  << e.getMsg();
-      if (exceptionOnError) {
-        throw;
-      }
-    }
+  // If requested, remove unconnected fragments (islands).
+  if (plane.netSignal && (!plane.keepIslands)) {
+    auto isIsland = [&](const ClipperLib::Path& p) {
+      ClipperLib::Paths intersections{p};
+      ClipperHelpers::intersect(intersections, connectedNetSignalAreas,
+                                ClipperLib::pftNonZero,
+                                ClipperLib::pftNonZero);  // can throw
+      return intersections.empty();
+    };
+    fragments.erase(
+        std::remove_if(fragments.begin(), fragments.end(), isIsland),
+        fragments.end());
+  }
+  if (mAbort) {
+    return tl::nullopt;
   }
 
+  // Make result canonical for a reproducible output by rotating and
+  // sorting the fragments.
+  auto cmp = [](const ClipperLib::IntPoint& a,
+                const ClipperLib::IntPoint& b) {
+    return (a.X < b.X) || ((a.X == b.X) && (a.Y < b.Y));
+  };
+  for (ClipperLib::Path& path : fragments) {
+    Q_ASSERT(!path.empty());
+    auto minIt = std::min_element(path.begin(), path.end(), cmp);
+    std::rotate(path.begin(), minIt, path.end());
+  }
+  std::sort(fragments.begin(), fragments.end(),
+            [&cmp](const ClipperLib::Path& a, const ClipperLib::Path& b) {
+              return cmp(a.front(), b.front());
+            });
   if (mAbort) {
-    qDebug() << "Aborted calculating plane areas after" << timer.elapsed()
-             << "ms.";
-  } else {
-    data->finished = true;
-    qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
+    return tl::nullopt;
   }
 
-  emit finished();
-  return data;
+  return ClipperHelpers::convert(fragments);
 }
 
 QVector<std::pair<Point, Angle>>
@@ -788,7 +1192,8 @@ bool BoardPlaneFragmentsBuilder::applyToBoard(
     for (auto it = data->result.begin(); it != data->result.end(); it++) {
       if (BI_Plane* plane = data->board->getPlanes().value(it.key())) {
         modified = modified || (plane->getFragments() != it.value());
-        plane->setCalculatedFragments(it.value());
+        plane->setCalculatedFragments(it.value(),
+                                      data->resultHashes.value(it.key()));
       }
     }
     if (!data->finished) {
@@ -26,9 +26,13 @@
 #include "../../geometry/path.h"
 #include "../../geometry/zone.h"
 #include "../../types/uuid.h"
+#include "../../utils/spatialindex.h"
 #include "../../utils/transform.h"
 #include "items/bi_plane.h"
 
+#include <optional/tl/optional.hpp>
+#include <polyclipping/clipper.hpp>
+
 #include <QtCore>
 
 #include <memory>
@@ -49,6 +53,12 @@ class PadGeometry;
 
 /**
  * @brief Plane fragments builder working on a ::librepcb::Board
+ *
+ * To avoid expensive rebuilds of planes which are not affected by a board
+ * modification, a hash of all the input data of each plane is calculated and
+ * stored in the ::librepcb::BI_Plane together with the fragments. If the
+ * hash did not change since the last build, the fragments of the last build
+ * are reused instead of calculating them again.
  */
 class BoardPlaneFragmentsBuilder final : public QObject {
   Q_OBJECT
@@ -130,6 +140,8 @@ private:  // Methods
     BI_Plane::ConnectStyle connectStyle;
     PositiveLength thermalGap;
     PositiveLength thermalSpokeWidth;
+    QVector<Path> fragments;  ///< Fragments of the previous build
+    QByteArray fragmentsHash;  ///< Input hash of the previous build
   };
 
   struct KeepoutZoneData {
@@ -182,13 +194,51 @@ private:  // Methods
     QList<std::tuple<Transform, PositiveLength, NonEmptyPath>> holes;
     QList<TraceData> traces;  // Converted to polygons after preprocessing.
     QHash<Uuid, QVector<Path>> result;
+    QHash<Uuid, QByteArray> resultHashes;  ///< Input hashes of the results
     bool finished = false;
   };
 
+  struct PlaneGraph {
+    QVector<ClipperLib::Path> outlines;  ///< Indexed like JobData::planes
+    QVector<SpatialIndex::Rect> rects;  ///< Bounding rects of outlines
+    QVector<QVector<int>> dependencies;  ///< Planes which must be built before
+  };
+
+  enum class ObstacleType { KeepoutZone, Hole, Via, Polygon, Pad };
+
+  struct LayerObstacles {
+    QVector<std::pair<ObstacleType, int>> items;  ///< Sorted by type & index
+    SpatialIndex index;  ///< Bounding rects, indexed like items
+  };
+
+  /// Indices of the obstacles in JobData located close to a plane
+  struct PlaneObstacles {
+    QVector<int> keepoutZones;
+    QVector<int> holes;
+    QVector<int> vias;
+    QVector<int> polygons;
+    QVector<int> pads;
+  };
+
   std::shared_ptr<JobData> createJob(Board& board,
                                      const QSet<const Layer*>* filter) noexcept;
   std::shared_ptr<JobData> run(std::shared_ptr<JobData> data,
                                bool exceptionOnError);
+  static PlaneGraph buildPlaneGraph(const QList<PlaneData>& planes) noexcept;
+  static QHash<const Layer*, LayerObstacles> buildObstacleIndex(
+      const JobData& data) noexcept;
+  static PlaneObstacles findObstacles(const LayerObstacles& obstacles,
+                                      const SpatialIndex::Rect& rect) noexcept;
+  static QByteArray calculatePlaneHash(
+      const JobData& data, const PlaneData& plane,
+      const QByteArray& boardAreaHash,
+      const QList<std::pair<const PlaneData*, QVector<Path>>>& otherPlanes,
+      const PlaneObstacles& obstacles) noexcept;
+  tl::optional<QVector<Path>> buildPlane(
+      const JobData& data, const PlaneData& plane,
+      const ClipperLib::Paths& boardArea, const ClipperLib::Path& planeOutline,
+      const QList<std::pair<const PlaneData*, QVector<Path>>>& otherPlanes,
+      const PlaneObstacles& obstacles) const;
   static QVector<std::pair<Point, Angle>> determineThermalSpokes(
       const PadGeometry& geometry) noexcept;
   bool applyToBoard(std::shared_ptr<JobData> data) noexcept;
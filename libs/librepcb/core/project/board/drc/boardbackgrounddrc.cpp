@@ -0,0 +1,296 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardbackgrounddrc.h"
+
+#include "../../../exceptions.h"
+#include "../board.h"
+#include "boarddesignrulechecksettings.h"
+
+#include <QtConcurrent>
+#include <QtCore>
+
+#include <algorithm>
+#include <tuple>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardBackgroundDrc::BoardBackgroundDrc(QObject* parent) noexcept
+  : QObject(parent),
+    mFuture(),
+    mWatcher(),
+    mPreviousJob(),
+    mGeneration(0),
+    mJobPending(false),
+    mAbort(false) {
+  connect(&mWatcher, &QFutureWatcherBase::finished, this,
+          &BoardBackgroundDrc::jobFinished, Qt::QueuedConnection);
+}
+
+BoardBackgroundDrc::~BoardBackgroundDrc() noexcept {
+  cancel();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardBackgroundDrc::start(Board& board) {
+  cancel();
+
+  const UnsignedLength clearance =
+      board.getDrcSettings().getMinCopperCopperClearance();
+  if (clearance == 0) {
+    // Check is disabled, no need to start a thread.
+    mPreviousJob.reset();
+    emit messagesUpdated(board, RuleCheckMessageList());
+    return;
+  }
+
+  // Take the snapshot. This only copies the geometry of the items, all Clipper
+  // paths are generated in the worker thread. Planes are taken into account
+  // as their fragments are kept up to date by the plane builder (in contrast
+  // to the quick check).
+  std::shared_ptr<JobData> data = std::make_shared<JobData>(JobData{
+      &board, mGeneration,
+      BoardCopperClearanceCheck(board, clearance, false,
+                                maxArcTolerance()),  // can throw
+      {}, false});
+
+  // The previous result can only be reused if it was created with the same
+  // settings, for the same board.
+  std::shared_ptr<const JobData> previous;
+  if (mPreviousJob && (mPreviousJob->board == &board) &&
+      (mPreviousJob->check.getClearance() == data->check.getClearance()) &&
+      (mPreviousJob->check.getCopperLayers() ==
+       data->check.getCopperLayers())) {
+    previous = mPreviousJob;
+  }
+
+  mFuture =
+      QtConcurrent::run(this, &BoardBackgroundDrc::run, data, previous);
+  mWatcher.setFuture(mFuture);
+  mJobPending = true;
+}
+
+bool BoardBackgroundDrc::isBusy() const noexcept {
+  return (mFuture.isStarted() || mFuture.isRunning()) &&
+      (!mFuture.isFinished()) && (!mFuture.isCanceled());
+}
+
+void BoardBackgroundDrc::invalidate() noexcept {
+  ++mGeneration;
+}
+
+void BoardBackgroundDrc::reset() noexcept {
+  cancel();
+  invalidate();
+  mPreviousJob.reset();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<BoardBackgroundDrc::JobData> BoardBackgroundDrc::run(
+    std::shared_ptr<JobData> data,
+    std::shared_ptr<const JobData> previous) noexcept {
+  // Note: This method is called from a different thread, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+
+  typedef BoardCopperClearanceCheck::Item Item;
+  typedef BoardCopperClearanceCheck::Violation Violation;
+  typedef std::tuple<const void*, const void*, const void*, const Layer*> Key;
+  auto getKey = [](const Item& item) {
+    return Key(item.item, item.polygon, item.circle, item.startLayer);
+  };
+
+  QElapsedTimer timer;
+  timer.start();
+  try {
+    BoardCopperClearanceCheck& check = data->check;
+    const QVector<Item>& items = check.getItems();
+
+    // Generate the copper areas of all items, as they are needed to detect
+    // modified items.
+    for (int i = 0; i < items.count(); ++i) {
+      if (mAbort) {
+        return data;
+      }
+      check.prepareCopperArea(i);
+    }
+
+    // Determine the corresponding item of the previous run for each item
+    // which has not been modified since then.
+    QVector<int> previousIndices(items.count(), -1);
+    if (previous) {
+      const QVector<Item>& previousItems = previous->check.getItems();
+      QMap<Key, int> indices;
+      for (int i = 0; i < previousItems.count(); ++i) {
+        indices.insert(getKey(previousItems.at(i)), i);
+      }
+      for (int i = 0; i < items.count(); ++i) {
+        const int index = indices.value(getKey(items.at(i)), -1);
+        if ((index >= 0) && items.at(i).isSameAs(previousItems.at(index))) {
+          previousIndices[i] = index;
+        }
+      }
+    }
+
+    // Prepare all items, reusing the clearance areas of unmodified items.
+    for (int i = 0; i < items.count(); ++i) {
+      if (mAbort) {
+        return data;
+      }
+      const int index = previousIndices.at(i);
+      check.prepareItem(
+          i, (index >= 0) ? &previous->check.getItems().at(index) : nullptr);
+    }
+    check.buildIndex();
+
+    // Determine which item pairs need to be checked.
+    QVector<std::pair<int, int>> pairs;
+    int modifiedItems = items.count();
+    if (previous) {
+      // Take over violations between unmodified items.
+      QVector<int> newIndices(previous->check.getItems().count(), -1);
+      for (int i = 0; i < items.count(); ++i) {
+        if (previousIndices.at(i) >= 0) {
+          newIndices[previousIndices.at(i)] = i;
+          --modifiedItems;
+        }
+      }
+      foreach (const Violation& violation, previous->violations) {
+        const int index1 = newIndices.at(violation.item1);
+        const int index2 = newIndices.at(violation.item2);
+        if ((index1 >= 0) && (index2 >= 0) && (index1 < index2)) {
+          Violation v = violation;
+          v.item1 = index1;
+          v.item2 = index2;
+          data->violations.append(v);
+        } else if ((index1 >= 0) && (index2 >= 0)) {
+          // Item order changed, check again to get the same result as a full
+          // check would.
+          pairs.append(std::make_pair(index2, index1));
+        }
+      }
+
+      // Check all pairs where at least one item is located in the modified
+      // region, i.e. where at least one item was added or modified.
+      for (int i = 0; i < items.count(); ++i) {
+        if (previousIndices.at(i) < 0) {
+          foreach (int k, check.getIndex().find(items.at(i).rect)) {
+            if ((k != i) && ((previousIndices.at(k) >= 0) || (i < k))) {
+              pairs.append(std::make_pair(std::min(i, k), std::max(i, k)));
+            }
+          }
+        }
+      }
+    } else {
+      pairs = check.getIndex().findIntersectingPairs();
+    }
+
+    // Run the checks.
+    for (const auto& pair : pairs) {
+      if (mAbort) {
+        return data;
+      }
+      if (auto violation = check.check(pair.first, pair.second)) {
+        data->violations.append(*violation);
+      }
+    }
+
+    // Use the same order as a full check would.
+    std::sort(data->violations.begin(), data->violations.end(),
+              [](const Violation& a, const Violation& b) {
+                return std::make_pair(a.item1, a.item2) <
+                    std::make_pair(b.item1, b.item2);
+              });
+    data->finished = true;
+    qDebug() << "Checked copper clearances of" << modifiedItems << "of"
+             << items.count() << "item(s) in" << timer.elapsed() << "ms.";
+  } catch (const Exception& e) {
+    qCritical() << "Failed to check copper clearances:" << e.getMsg();
+  }
+  return data;
+}
+
+void BoardBackgroundDrc::jobFinished() noexcept {
+  // A queued signal of a previous job may arrive after #start() has already
+  // replaced the future, so ignore it unless the current job is really done.
+  // Otherwise result() would block until the new job is finished and the
+  // messages would be reported twice.
+  if ((!mJobPending) || (!mFuture.isFinished())) {
+    return;
+  }
+  mJobPending = false;
+
+  std::shared_ptr<JobData> data = mFuture.result();
+  if ((!data) || (!data->finished)) {
+    return;  // Aborted or failed.
+  }
+  mPreviousJob = data;
+
+  // Board items are only accessed if the board was not modified in the
+  // meantime, otherwise they might not exist anymore.
+  if (data->board && (data->generation == mGeneration)) {
+    try {
+      RuleCheckMessageList messages;
+      foreach (const auto& violation, data->violations) {
+        messages.append(data->check.createMessage(violation));  // can throw
+      }
+      emit messagesUpdated(*data->board, messages);
+    } catch (const Exception& e) {
+      qCritical() << "Failed to create copper clearance messages:"
+                  << e.getMsg();
+    }
+  }
+}
+
+void BoardBackgroundDrc::cancel() noexcept {
+  mAbort = true;
+  mFuture.waitForFinished();
+  mAbort = false;
+
+  // Keep the result of a job which completed before it got aborted, to
+  // still benefit from it in the next run.
+  if (mJobPending) {
+    mJobPending = false;
+    std::shared_ptr<JobData> data = mFuture.result();
+    if (data && data->finished) {
+      mPreviousJob = data;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,150 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDBACKGROUNDDRC_H
+#define LIBREPCB_CORE_BOARDBACKGROUNDDRC_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../rulecheck/rulecheckmessage.h"
+#include "boardcopperclearancecheck.h"
+
+#include <QtCore>
+
+#include <atomic>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Board;
+
+/*******************************************************************************
+ *  Class BoardBackgroundDrc
+ ******************************************************************************/
+
+/**
+ * @brief Non-blocking, incremental copper clearance check of a
+ *        ::librepcb::Board
+ *
+ * Takes a snapshot of the copper objects of a board and checks them for
+ * copper clearance violations in a worker thread, so the board can still be
+ * edited while the check is running. The result of the previous run is
+ * remembered and used to check only the modified region of the board in the
+ * next run: Only pairs of objects where at least one of them was added or
+ * modified since the previous run are checked again, violations between
+ * unmodified objects are taken over from the previous run.
+ *
+ * As the messages reference board items, they are only created (and
+ * #messagesUpdated() emitted) if the board was not modified while the check
+ * was running. Thus the owner has to call #invalidate() whenever the board
+ * gets modified, and start the check again later.
+ */
+class BoardBackgroundDrc final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  explicit BoardBackgroundDrc(QObject* parent = nullptr) noexcept;
+  BoardBackgroundDrc(const BoardBackgroundDrc& other) = delete;
+  ~BoardBackgroundDrc() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Start checking a board asynchronously
+   *
+   * @param board   The board to check. If it is not the same board as in
+   *                the previous run, the whole board is checked.
+   *
+   * @throws Exception if the snapshot could not be created.
+   */
+  void start(Board& board);
+
+  /**
+   * @brief Check if there is currently a check in progress
+   *
+   * @retval true if a check is in progress.
+   * @retval false if idle.
+   */
+  bool isBusy() const noexcept;
+
+  /**
+   * @brief Notify that the board was modified
+   *
+   * Results of currently running checks will be discarded.
+   */
+  void invalidate() noexcept;
+
+  /**
+   * @brief Cancel the current check and forget the previous result
+   *
+   * The next run will check the whole board again.
+   */
+  void reset() noexcept;
+
+  // Operator Overloadings
+  BoardBackgroundDrc& operator=(const BoardBackgroundDrc& rhs) = delete;
+
+signals:
+  void messagesUpdated(Board& board, const RuleCheckMessageList& messages);
+
+private:  // Types
+  struct JobData {
+    QPointer<Board> board;
+    int generation;
+    BoardCopperClearanceCheck check;
+    QVector<BoardCopperClearanceCheck::Violation> violations;
+    bool finished;
+  };
+
+private:  // Methods
+  std::shared_ptr<JobData> run(
+      std::shared_ptr<JobData> data,
+      std::shared_ptr<const JobData> previous) noexcept;
+  void jobFinished() noexcept;
+  void cancel() noexcept;
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. Must be
+   * the same as in ::librepcb::BoardDesignRuleCheck to get the same results.
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
+private:  // Data
+  QFuture<std::shared_ptr<JobData>> mFuture;
+  QFutureWatcher<std::shared_ptr<JobData>> mWatcher;
+  std::shared_ptr<const JobData> mPreviousJob;  ///< Last finished job
+  int mGeneration;  ///< Incremented on every board modification
+  bool mJobPending;  ///< Whether the result of #mFuture is not handled yet
+  std::atomic<bool> mAbort;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
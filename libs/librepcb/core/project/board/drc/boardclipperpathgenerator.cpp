@@ -48,7 +48,12 @@ namespace librepcb {
 
 BoardClipperPathGenerator::BoardClipperPathGenerator(
     Board& board, const PositiveLength& maxArcTolerance) noexcept
-  : mBoard(board), mMaxArcTolerance(maxArcTolerance), mPaths() {
+  : mBoard(&board), mMaxArcTolerance(maxArcTolerance), mPaths() {
+}
+
+BoardClipperPathGenerator::BoardClipperPathGenerator(
+    const PositiveLength& maxArcTolerance) noexcept
+  : mBoard(nullptr), mMaxArcTolerance(maxArcTolerance), mPaths() {
 }
 
 BoardClipperPathGenerator::~BoardClipperPathGenerator() noexcept {
@@ -70,8 +75,10 @@ void BoardClipperPathGenerator::takePathsTo(ClipperLib::Paths& out) noexcept {
 void BoardClipperPathGenerator::addCopper(
     const Layer& layer, const QSet<const NetSignal*>& netsignals,
     bool ignorePlanes) {
+  Q_ASSERT(mBoard);
+
   // Board polygons.
-  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+  foreach (const BI_Polygon* polygon, mBoard->getPolygons()) {
     if ((polygon->getData().getLayer() == layer) &&
         (netsignals.isEmpty() || (netsignals.contains(nullptr)))) {
       addPolygon(polygon->getData().getPath(),
@@ -81,7 +88,7 @@ void BoardClipperPathGenerator::addCopper(
   }
 
   // Stroke texts.
-  foreach (const BI_StrokeText* strokeText, mBoard.getStrokeTexts()) {
+  foreach (const BI_StrokeText* strokeText, mBoard->getStrokeTexts()) {
     if ((strokeText->getData().getLayer() == layer) &&
         (netsignals.isEmpty() || (netsignals.contains(nullptr)))) {
       addStrokeText(*strokeText);
@@ -90,7 +97,7 @@ void BoardClipperPathGenerator::addCopper(
 
   // Planes.
   if (!ignorePlanes) {
-    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+    foreach (const BI_Plane* plane, mBoard->getPlanes()) {
       if ((plane->getLayer() == layer) &&
           (netsignals.isEmpty() ||
            netsignals.contains(plane->getNetSignal()))) {
@@ -100,7 +107,7 @@ void BoardClipperPathGenerator::addCopper(
   }
 
   // Devices.
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+  foreach (const BI_Device* device, mBoard->getDeviceInstances()) {
     Transform transform(*device);
 
     // Polygons.
@@ -142,7 +149,7 @@ void BoardClipperPathGenerator::addCopper(
   }
 
   // Net segment items.
-  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+  foreach (const BI_NetSegment* netsegment, mBoard->getNetSegments()) {
     if (netsignals.isEmpty() ||
         netsignals.contains(netsegment->getNetSignal())) {
       // Vias.
@@ -164,8 +171,10 @@ void BoardClipperPathGenerator::addCopper(
 
 void BoardClipperPathGenerator::addStopMaskOpenings(const Layer& layer,
                                                     const Length& offset) {
+  Q_ASSERT(mBoard);
+
   // Board polygons.
-  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+  foreach (const BI_Polygon* polygon, mBoard->getPolygons()) {
     if (polygon->getData().getLayer() == layer) {
       addPolygon(polygon->getData().getPath(),
                  polygon->getData().getLineWidth(),
@@ -174,14 +183,14 @@ void BoardClipperPathGenerator::addStopMaskOpenings(const Layer& layer,
   }
 
   // Stroke texts.
-  foreach (const BI_StrokeText* strokeText, mBoard.getStrokeTexts()) {
+  foreach (const BI_StrokeText* strokeText, mBoard->getStrokeTexts()) {
     if (strokeText->getData().getLayer() == layer) {
       addStrokeText(*strokeText, offset);
     }
   }
 
   // Holes.
-  foreach (const BI_Hole* hole, mBoard.getHoles()) {
+  foreach (const BI_Hole* hole, mBoard->getHoles()) {
     if (auto maskOffset = hole->getStopMaskOffset()) {
       const Length maskDia = hole->getData().getDiameter() + (*maskOffset) * 2;
       addHole(PositiveLength(maskDia), hole->getData().getPath(), Transform(),
@@ -190,7 +199,7 @@ void BoardClipperPathGenerator::addStopMaskOpenings(const Layer& layer,
   }
 
   // Devices.
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+  foreach (const BI_Device* device, mBoard->getDeviceInstances()) {
     Transform transform(*device);
 
     // Polygons.
@@ -243,7 +252,7 @@ void BoardClipperPathGenerator::addStopMaskOpenings(const Layer& layer,
   }
 
   // Vias.
-  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+  foreach (const BI_NetSegment* netsegment, mBoard->getNetSegments()) {
     foreach (const BI_Via* via, netsegment->getVias()) {
       const tl::optional<PositiveLength> stopMaskDia = layer.isTop()
           ? via->getStopMaskDiameterTop()
@@ -258,23 +267,39 @@ void BoardClipperPathGenerator::addStopMaskOpenings(const Layer& layer,
 
 void BoardClipperPathGenerator::addVia(const BI_Via& via,
                                        const Length& offset) {
+  addVia(via.getVia(), offset);
+}
+
+void BoardClipperPathGenerator::addVia(const Via& via, const Length& offset) {
   ClipperHelpers::unite(
       mPaths,
-      {ClipperHelpers::convert(via.getVia().getSceneOutline(offset),
-                               mMaxArcTolerance)},
+      {ClipperHelpers::convert(via.getSceneOutline(offset), mMaxArcTolerance)},
       ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
 }
 
 void BoardClipperPathGenerator::addNetLine(const BI_NetLine& netLine,
                                            const Length& offset) {
-  ClipperHelpers::unite(mPaths,
-                        {ClipperHelpers::convert(
-                            netLine.getSceneOutline(offset), mMaxArcTolerance)},
-                        ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+  addNetLine(netLine.getStartPoint().getPosition(),
+             netLine.getEndPoint().getPosition(), netLine.getWidth(), offset);
+}
+
+void BoardClipperPathGenerator::addNetLine(const Point& startPos,
+                                           const Point& endPos,
+                                           const PositiveLength& width,
+                                           const Length& offset) {
+  // Same outline as BI_NetLine::getSceneOutline().
+  const Path outline = Path::obround(startPos, endPos, width + (offset * 2));
+  ClipperHelpers::unite(
+      mPaths, {ClipperHelpers::convert(outline, mMaxArcTolerance)},
+      ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
 }
 
 void BoardClipperPathGenerator::addPlane(const BI_Plane& plane) {
-  foreach (const Path& p, plane.getFragments()) {
+  addPlane(plane.getFragments());
+}
+
+void BoardClipperPathGenerator::addPlane(const QVector<Path>& fragments) {
+  foreach (const Path& p, fragments) {
     ClipperHelpers::unite(mPaths,
                           {ClipperHelpers::convert(p, mMaxArcTolerance)},
                           ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
@@ -332,13 +357,19 @@ void BoardClipperPathGenerator::addCircle(const Circle& circle,
 
 void BoardClipperPathGenerator::addStrokeText(const BI_StrokeText& strokeText,
                                               const Length& offset) {
-  const PositiveLength width(
-      qMax(*strokeText.getData().getStrokeWidth() + (offset * 2), Length(1)));
-  const Transform transform(strokeText.getData());
-  foreach (const Path path, transform.map(strokeText.getPaths())) {
-    QVector<Path> paths = path.toOutlineStrokes(width);
+  addStrokeText(Transform(strokeText.getData()), strokeText.getPaths(),
+                strokeText.getData().getStrokeWidth(), offset);
+}
+
+void BoardClipperPathGenerator::addStrokeText(const Transform& transform,
+                                              const QVector<Path>& paths,
+                                              const UnsignedLength& strokeWidth,
+                                              const Length& offset) {
+  const PositiveLength width(qMax(*strokeWidth + (offset * 2), Length(1)));
+  foreach (const Path path, transform.map(paths)) {
+    QVector<Path> outlines = path.toOutlineStrokes(width);
     ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
+                          ClipperHelpers::convert(outlines, mMaxArcTolerance),
                           ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
   }
 }
@@ -358,8 +389,13 @@ void BoardClipperPathGenerator::addHole(const PositiveLength& diameter,
 void BoardClipperPathGenerator::addPad(const BI_FootprintPad& pad,
                                        const Layer& layer,
                                        const Length& offset) {
-  const Transform transform(pad);
-  foreach (PadGeometry geometry, pad.getGeometries().value(&layer)) {
+  addPad(Transform(pad), pad.getGeometries().value(&layer), offset);
+}
+
+void BoardClipperPathGenerator::addPad(const Transform& transform,
+                                       const QList<PadGeometry>& geometries,
+                                       const Length& offset) {
+  foreach (PadGeometry geometry, geometries) {
     if (offset != 0) {
       geometry = geometry.withOffset(offset);
     }
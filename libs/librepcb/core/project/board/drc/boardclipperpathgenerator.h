@@ -46,6 +46,8 @@ class Circle;
 class Hole;
 class Layer;
 class NetSignal;
+class PadGeometry;
+class Via;
 
 /*******************************************************************************
  *  Class BoardClipperPathGenerator
@@ -54,12 +56,18 @@ class NetSignal;
 /**
  * @brief The BoardClipperPathGenerator class creates a Clipper path from
  *        a ::librepcb::Board
+ *
+ * The methods taking plain geometry values instead of board items don't
+ * access the board, thus they may also be used from a worker thread, or
+ * with a generator constructed without a board.
  */
 class BoardClipperPathGenerator final {
 public:
   // Constructors / Destructor
   explicit BoardClipperPathGenerator(
       Board& board, const PositiveLength& maxArcTolerance) noexcept;
+  explicit BoardClipperPathGenerator(
+      const PositiveLength& maxArcTolerance) noexcept;
   ~BoardClipperPathGenerator() noexcept;
 
   // Getters
@@ -72,22 +80,32 @@ public:
   void addStopMaskOpenings(const Layer& layer,
                            const Length& offset = Length(0));
   void addVia(const BI_Via& via, const Length& offset = Length(0));
+  void addVia(const Via& via, const Length& offset = Length(0));
   void addNetLine(const BI_NetLine& netLine, const Length& offset = Length(0));
+  void addNetLine(const Point& startPos, const Point& endPos,
+                  const PositiveLength& width,
+                  const Length& offset = Length(0));
   void addPlane(const BI_Plane& plane);
+  void addPlane(const QVector<Path>& fragments);
   void addPolygon(const Path& path, const UnsignedLength& lineWidth,
                   bool filled, const Length& offset = Length(0));
   void addCircle(const Circle& circle, const Transform& transform,
                  const Length& offset = Length(0));
   void addStrokeText(const BI_StrokeText& strokeText,
                      const Length& offset = Length(0));
+  void addStrokeText(const Transform& transform, const QVector<Path>& paths,
+                     const UnsignedLength& strokeWidth,
+                     const Length& offset = Length(0));
   void addHole(const PositiveLength& diameter, const NonEmptyPath& path,
                const Transform& transform = Transform(),
                const Length& offset = Length(0));
   void addPad(const BI_FootprintPad& pad, const Layer& layer,
               const Length& offset = Length(0));
+  void addPad(const Transform& transform, const QList<PadGeometry>& geometries,
+              const Length& offset = Length(0));
 
 private:  // Data
-  Board& mBoard;
+  Board* mBoard;  ///< `nullptr` if constructed without board
   PositiveLength mMaxArcTolerance;
   ClipperLib::Paths mPaths;
 };
@@ -0,0 +1,353 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardcopperclearancecheck.h"
+
+#include "../../../geometry/circle.h"
+#include "../../../geometry/polygon.h"
+#include "../../../geometry/stroketext.h"
+#include "../../../library/pkg/footprint.h"
+#include "../../../library/pkg/footprintpad.h"
+#include "../../../types/layer.h"
+#include "../../../utils/clipperhelpers.h"
+#include "../../../utils/transform.h"
+#include "../board.h"
+#include "../items/bi_device.h"
+#include "../items/bi_footprintpad.h"
+#include "../items/bi_netline.h"
+#include "../items/bi_netsegment.h"
+#include "../items/bi_plane.h"
+#include "../items/bi_polygon.h"
+#include "../items/bi_stroketext.h"
+#include "../items/bi_via.h"
+#include "boardclipperpathgenerator.h"
+#include "boarddesignrulecheckmessages.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Struct Item
+ ******************************************************************************/
+
+bool BoardCopperClearanceCheck::Item::isSameAs(const Item& rhs) const noexcept {
+  return (item == rhs.item) && (polygon == rhs.polygon) &&
+      (circle == rhs.circle) && (startLayer == rhs.startLayer) &&
+      (endLayer == rhs.endLayer) && (netSignal == rhs.netSignal) &&
+      (clearance == rhs.clearance) &&
+      (clearanceFromCopperArea == rhs.clearanceFromCopperArea) &&
+      (copperArea == rhs.copperArea);
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardCopperClearanceCheck::BoardCopperClearanceCheck(
+    Board& board, const UnsignedLength& clearance, bool ignorePlanes,
+    const PositiveLength& maxArcTolerance)
+  : mClearance(clearance),
+    mIgnorePlanes(ignorePlanes),
+    mMaxArcTolerance(maxArcTolerance),
+    // Subtract a tolerance to avoid false-positives due to inaccuracies.
+    mTolerance(*maxArcTolerance + Length(1)),
+    mCopperLayers(board.getCopperLayers()),
+    mItems(),
+    mIndex() {
+  // Note: Only copy plain values into the geometry functions since they are
+  // called from a worker thread!
+  auto addItem = [this](const BI_Base* item, const Polygon* polygon,
+                        const Circle* circle, const Layer* startLayer,
+                        const Layer* endLayer, const NetSignal* netSignal,
+                        const Length& itemClearance,
+                        const GeometryFunction& geometry,
+                        bool clearanceFromCopperArea) {
+    mItems.append(Item{item, polygon, circle, startLayer, endLayer, netSignal,
+                       itemClearance, geometry, clearanceFromCopperArea, {},
+                       {}, SpatialIndex::emptyRect()});
+  };
+
+  // Net segments.
+  foreach (const BI_NetSegment* netSegment, board.getNetSegments()) {
+    // vias.
+    foreach (const BI_Via* via, netSegment->getVias()) {
+      const Via data = via->getVia();
+      addItem(via, nullptr, nullptr, &via->getVia().getStartLayer(),
+              &via->getVia().getEndLayer(), via->getNetSegment().getNetSignal(),
+              *clearance,
+              [data](BoardClipperPathGenerator& gen, const Length& offset) {
+                gen.addVia(data, offset);
+              },
+              false);
+    }
+
+    // Net lines.
+    foreach (const BI_NetLine* netLine, netSegment->getNetLines()) {
+      if (mCopperLayers.contains(&netLine->getLayer())) {
+        const Point startPos = netLine->getStartPoint().getPosition();
+        const Point endPos = netLine->getEndPoint().getPosition();
+        const PositiveLength width = netLine->getWidth();
+        addItem(netLine, nullptr, nullptr, &netLine->getLayer(),
+                &netLine->getLayer(), netLine->getNetSegment().getNetSignal(),
+                *clearance,
+                [startPos, endPos, width](BoardClipperPathGenerator& gen,
+                                          const Length& offset) {
+                  gen.addNetLine(startPos, endPos, width, offset);
+                },
+                false);
+      }
+    }
+  }
+
+  // Planes.
+  if (!mIgnorePlanes) {
+    foreach (const BI_Plane* plane, board.getPlanes()) {
+      if (mCopperLayers.contains(&plane->getLayer())) {
+        const QVector<Path> fragments = plane->getFragments();
+        addItem(plane, nullptr, nullptr, &plane->getLayer(), &plane->getLayer(),
+                plane->getNetSignal(), *clearance,
+                [fragments](BoardClipperPathGenerator& gen, const Length&) {
+                  gen.addPlane(fragments);
+                },
+                true);
+      }
+    }
+  }
+
+  // Polygons, either from the board or from a device footprint.
+  auto addPolygon = [&](const BI_Base* item, const Polygon* libPolygon,
+                        const Layer& layer, const Path& path,
+                        const UnsignedLength& lineWidth, bool filled) {
+    addItem(item, libPolygon, nullptr, &layer, &layer, nullptr, *clearance,
+            [path, lineWidth, filled](BoardClipperPathGenerator& gen,
+                                      const Length& offset) {
+              gen.addPolygon(path, lineWidth, filled, offset);
+            },
+            true);
+  };
+
+  // Stroke texts, either from the board or from a device.
+  auto addStrokeText = [&](const BI_StrokeText& strokeText) {
+    const Transform transform(strokeText.getData());
+    const QVector<Path> paths = strokeText.getPaths();
+    const UnsignedLength strokeWidth = strokeText.getData().getStrokeWidth();
+    addItem(&strokeText, nullptr, nullptr, &strokeText.getData().getLayer(),
+            &strokeText.getData().getLayer(), nullptr, *clearance,
+            [transform, paths, strokeWidth](BoardClipperPathGenerator& gen,
+                                            const Length& offset) {
+              gen.addStrokeText(transform, paths, strokeWidth, offset);
+            },
+            false);
+  };
+
+  // Board polygons.
+  foreach (const BI_Polygon* polygon, board.getPolygons()) {
+    if (mCopperLayers.contains(&polygon->getData().getLayer())) {
+      addPolygon(polygon, nullptr, polygon->getData().getLayer(),
+                 polygon->getData().getPath(),
+                 polygon->getData().getLineWidth(),
+                 polygon->getData().isFilled());
+    }
+  }
+
+  // Board stroke texts.
+  foreach (const BI_StrokeText* strokeText, board.getStrokeTexts()) {
+    if (mCopperLayers.contains(&strokeText->getData().getLayer())) {
+      addStrokeText(*strokeText);
+    }
+  }
+
+  // Devices.
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    const Transform transform(*device);
+
+    // Pads.
+    foreach (const BI_FootprintPad* pad, device->getPads()) {
+      const UnsignedLength padClearance =
+          std::max(clearance, pad->getLibPad().getCopperClearance());
+      const Transform padTransform(*pad);
+      foreach (const Layer* layer, board.getCopperLayers()) {
+        if (pad->isOnLayer(*layer)) {
+          const QList<PadGeometry> geometries =
+              pad->getGeometries().value(layer);
+          addItem(pad, nullptr, nullptr, layer, layer,
+                  pad->getCompSigInstNetSignal(), *padClearance,
+                  [padTransform, geometries](BoardClipperPathGenerator& gen,
+                                             const Length& offset) {
+                    gen.addPad(padTransform, geometries, offset);
+                  },
+                  false);
+        }
+      }
+    }
+
+    // Polygons.
+    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+      if (mCopperLayers.contains(&transform.map(polygon.getLayer()))) {
+        addPolygon(device, &polygon, polygon.getLayer(),
+                   transform.map(polygon.getPath()), polygon.getLineWidth(),
+                   polygon.isFilled());
+      }
+    }
+
+    // Circles.
+    for (const Circle& circle : device->getLibFootprint().getCircles()) {
+      if (mCopperLayers.contains(&transform.map(circle.getLayer()))) {
+        const Circle data = circle;
+        addItem(device, nullptr, &circle, &circle.getLayer(),
+                &circle.getLayer(), nullptr, *clearance,
+                [data, transform](BoardClipperPathGenerator& gen,
+                                  const Length& offset) {
+                  gen.addCircle(data, transform, offset);
+                },
+                false);
+      }
+    }
+
+    // Stroke texts.
+    foreach (const BI_StrokeText* strokeText, device->getStrokeTexts()) {
+      // Layer does not need to be transformed!
+      if (mCopperLayers.contains(&strokeText->getData().getLayer())) {
+        addStrokeText(*strokeText);
+      }
+    }
+  }
+}
+
+BoardCopperClearanceCheck::~BoardCopperClearanceCheck() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardCopperClearanceCheck::prepareCopperArea(int index) {
+  Item& item = mItems[index];
+  BoardClipperPathGenerator gen(mMaxArcTolerance);
+  item.geometry(gen, Length(0));  // can throw
+  gen.takePathsTo(item.copperArea);
+}
+
+void BoardCopperClearanceCheck::prepareItem(int index, const Item* previous) {
+  Item& item = mItems[index];
+  if (previous) {
+    item.clearanceArea = previous->clearanceArea;
+  } else if (item.clearanceFromCopperArea) {
+    item.clearanceArea = item.copperArea;
+    ClipperHelpers::offset(item.clearanceArea, *mClearance - mTolerance,
+                           mMaxArcTolerance);  // can throw
+  } else {
+    BoardClipperPathGenerator gen(mMaxArcTolerance);
+    item.geometry(gen, item.clearance - mTolerance);  // can throw
+    gen.takePathsTo(item.clearanceArea);
+  }
+
+  // Note: The clearance area might be smaller than the copper area if the
+  // clearance is smaller than the tolerance, thus take both into account.
+  item.rect =
+      SpatialIndex::united(SpatialIndex::boundingRect(item.copperArea),
+                           SpatialIndex::boundingRect(item.clearanceArea));
+}
+
+void BoardCopperClearanceCheck::buildIndex() noexcept {
+  QVector<SpatialIndex::Rect> rects;
+  rects.reserve(mItems.count());
+  for (const Item& item : mItems) {
+    rects.append(item.rect);
+  }
+  mIndex = SpatialIndex(rects);
+}
+
+tl::optional<BoardCopperClearanceCheck::Violation>
+    BoardCopperClearanceCheck::check(int index1, int index2) const {
+  const Item& item1 = mItems.at(index1);
+  const Item& item2 = mItems.at(index2);
+  QVector<const Layer*> layers;
+  if (((item1.netSignal != item2.netSignal) || (!item1.netSignal) ||
+       (!item2.netSignal)) &&
+      layersOverlap(item1, item2, layers)) {
+    QVector<Path> locations;
+    checkForIntersections(item1, item2, locations);  // can throw
+    // Perform the check the other way around only if:
+    //  - Either the two items have individual clearances
+    //  - Or there are any intersections -> show both violations in UI
+    if ((item1.clearance != item2.clearance) || (!locations.isEmpty())) {
+      checkForIntersections(item2, item1, locations);  // can throw
+    }
+    if (!locations.isEmpty()) {
+      return Violation{index1, index2, layers, locations};
+    }
+  }
+  return tl::nullopt;
+}
+
+std::shared_ptr<const RuleCheckMessage>
+    BoardCopperClearanceCheck::createMessage(const Violation& violation) const {
+  const Item& item1 = mItems.at(violation.item1);
+  const Item& item2 = mItems.at(violation.item2);
+  return std::make_shared<DrcMsgCopperCopperClearanceViolation>(
+      item1.netSignal, *item1.item, item1.polygon, item1.circle,
+      item2.netSignal, *item2.item, item2.polygon, item2.circle,
+      violation.layers, std::max(item1.clearance, item2.clearance),
+      violation.locations);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool BoardCopperClearanceCheck::layersOverlap(
+    const Item& item1, const Item& item2,
+    QVector<const Layer*>& layers) const noexcept {
+  layers.clear();
+  const int first = std::max(item1.startLayer->getCopperNumber(),
+                             item2.startLayer->getCopperNumber());
+  const int last = std::min(item1.endLayer->getCopperNumber(),
+                            item2.endLayer->getCopperNumber());
+  for (int i = first; i <= last; ++i) {
+    const Layer* layer = Layer::copper(i);
+    if (mCopperLayers.contains(layer) && (!layers.contains(layer))) {
+      layers.append(layer);
+    }
+  }
+  return !layers.isEmpty();
+}
+
+void BoardCopperClearanceCheck::checkForIntersections(
+    const Item& item1, const Item& item2, QVector<Path>& locations) {
+  const std::unique_ptr<ClipperLib::PolyTree> intersections =
+      ClipperHelpers::intersectToTree(item1.copperArea, item2.clearanceArea,
+                                      ClipperLib::pftEvenOdd,
+                                      ClipperLib::pftEvenOdd);
+  locations.append(
+      ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
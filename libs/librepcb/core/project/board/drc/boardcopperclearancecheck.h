@@ -0,0 +1,216 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDCOPPERCLEARANCECHECK_H
+#define LIBREPCB_CORE_BOARDCOPPERCLEARANCECHECK_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../geometry/path.h"
+#include "../../../rulecheck/rulecheckmessage.h"
+#include "../../../types/length.h"
+#include "../../../utils/spatialindex.h"
+
+#include <optional/tl/optional.hpp>
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+#include <functional>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class BI_Base;
+class Board;
+class BoardClipperPathGenerator;
+class Circle;
+class Layer;
+class NetSignal;
+class Polygon;
+
+/*******************************************************************************
+ *  Class BoardCopperClearanceCheck
+ ******************************************************************************/
+
+/**
+ * @brief Copper to copper clearance check of a ::librepcb::Board
+ *
+ * The check is split into several steps to allow running the expensive parts
+ * in a worker thread:
+ *
+ *  1. The constructor takes a snapshot of all copper objects of the board.
+ *     It must be called in the thread the board belongs to. To keep this step
+ *     cheap, only the plain geometry values (e.g. paths, pad geometries and
+ *     widths) are copied, no Clipper paths are generated yet.
+ *  2. #prepareCopperArea(), #prepareItem() and #buildIndex() calculate the
+ *     copper areas, clearance areas and the spatial index. These methods only
+ *     work on the snapshot, thus they may be called in any thread.
+ *  3. #check() compares two items with each other and is thread-safe too.
+ *  4. #createMessage() converts a found violation into a DRC message. This
+ *     accesses the board items again, thus it must be called in the thread
+ *     the board belongs to, and only as long as the board was not modified
+ *     since taking the snapshot.
+ */
+class BoardCopperClearanceCheck final {
+public:
+  // Types
+
+  /**
+   * Adds the copper area of an item to a generator, expanded by the given
+   * offset. Captures only plain geometry values, thus it is thread-safe.
+   */
+  typedef std::function<void(BoardClipperPathGenerator& gen,
+                             const Length& offset)>
+      GeometryFunction;
+
+  struct Item {
+    const BI_Base* item;
+    const Polygon* polygon;  ///< Only relevant if item is a BI_Device
+    const Circle* circle;  ///< Only relevant if item is a BI_Device
+    const Layer* startLayer;
+    const Layer* endLayer;
+    const NetSignal* netSignal;  ///< `nullptr` = no net
+    Length clearance;
+    GeometryFunction geometry;
+    bool clearanceFromCopperArea;  ///< Offset copper area instead of geometry
+    ClipperLib::Paths copperArea;  ///< Set by #prepareCopperArea()
+    ClipperLib::Paths clearanceArea;  ///< Copper + clearance - tolerance
+    SpatialIndex::Rect rect;  ///< Bounding box set by #prepareItem()
+
+    /**
+     * @brief Check if this item represents the same object with the same
+     *        geometry as another item (usually from an older snapshot)
+     *
+     * @note The copper area of both items must already be prepared. The
+     *       clearance area is not compared as it is derived from the same
+     *       geometry as the copper area.
+     *
+     * @param rhs   Other item.
+     *
+     * @return Whether both items would lead to the same check results.
+     */
+    bool isSameAs(const Item& rhs) const noexcept;
+  };
+
+  struct Violation {
+    int item1;  ///< Index of the first item
+    int item2;  ///< Index of the second item
+    QVector<const Layer*> layers;
+    QVector<Path> locations;
+  };
+
+  // Constructors / Destructor
+  BoardCopperClearanceCheck() = delete;
+  BoardCopperClearanceCheck(const BoardCopperClearanceCheck& other) = default;
+  BoardCopperClearanceCheck(Board& board, const UnsignedLength& clearance,
+                            bool ignorePlanes,
+                            const PositiveLength& maxArcTolerance);
+  ~BoardCopperClearanceCheck() noexcept;
+
+  // Getters
+  const UnsignedLength& getClearance() const noexcept { return mClearance; }
+  bool getIgnorePlanes() const noexcept { return mIgnorePlanes; }
+  const QSet<const Layer*>& getCopperLayers() const noexcept {
+    return mCopperLayers;
+  }
+  const QVector<Item>& getItems() const noexcept { return mItems; }
+  const SpatialIndex& getIndex() const noexcept { return mIndex; }
+
+  // General Methods
+
+  /**
+   * @brief Calculate the copper area of an item
+   *
+   * Must be called for each item before #prepareItem().
+   *
+   * @param index     Index of the item to prepare.
+   *
+   * @throws Exception if any error occurred.
+   */
+  void prepareCopperArea(int index);
+
+  /**
+   * @brief Calculate the clearance area and bounding box of an item
+   *
+   * @param index     Index of the item to prepare.
+   * @param previous  If not `nullptr`, the (already prepared) item to copy
+   *                  the clearance area from. Only allowed if
+   *                  Item::isSameAs() returned `true` for it.
+   *
+   * @throws Exception if any error occurred.
+   */
+  void prepareItem(int index, const Item* previous = nullptr);
+
+  /**
+   * @brief Build the spatial index, after all items were prepared
+   */
+  void buildIndex() noexcept;
+
+  /**
+   * @brief Check two (prepared) items for a clearance violation
+   *
+   * @param index1    Index of the first item.
+   * @param index2    Index of the second item.
+   *
+   * @return The violation, or `tl::nullopt` if there is none.
+   */
+  tl::optional<Violation> check(int index1, int index2) const;
+
+  /**
+   * @brief Create the DRC message for a violation
+   *
+   * @param violation   The violation as returned by #check().
+   *
+   * @return The DRC message.
+   */
+  std::shared_ptr<const RuleCheckMessage> createMessage(
+      const Violation& violation) const;
+
+  // Operator Overloadings
+  BoardCopperClearanceCheck& operator=(const BoardCopperClearanceCheck& rhs) =
+      default;
+
+private:  // Methods
+  bool layersOverlap(const Item& item1, const Item& item2,
+                     QVector<const Layer*>& layers) const noexcept;
+  static void checkForIntersections(const Item& item1, const Item& item2,
+                                    QVector<Path>& locations);
+
+private:  // Data
+  UnsignedLength mClearance;
+  bool mIgnorePlanes;
+  PositiveLength mMaxArcTolerance;
+  Length mTolerance;
+  QSet<const Layer*> mCopperLayers;
+  QVector<Item> mItems;
+  SpatialIndex mIndex;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
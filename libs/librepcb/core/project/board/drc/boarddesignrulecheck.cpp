@@ -30,6 +30,7 @@
 #include "../../../library/pkg/footprintpad.h"
 #include "../../../library/pkg/packagepad.h"
 #include "../../../utils/clipperhelpers.h"
+#include "../../../utils/spatialindex.h"
 #include "../../../utils/toolbox.h"
 #include "../../../utils/transform.h"
 #include "../../circuit/circuit.h"
@@ -51,23 +52,19 @@
 #include "../items/bi_via.h"
 #include "../items/bi_zone.h"
 #include "boardclipperpathgenerator.h"
+#include "boardcopperclearancecheck.h"
 
+#include <QtConcurrent>
 #include <QtCore>
-#include <thread>
-#include <mutex>
-
 
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
-
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
-std::mutex messagemutex;
-volatile int progressTotal;
 
 BoardDesignRuleCheck::BoardDesignRuleCheck(
     Board& board, const BoardDesignRuleCheckSettings& settings,
@@ -89,73 +86,63 @@ BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
  ******************************************************************************/
 
 void BoardDesignRuleCheck::execute(bool quick) {
-  progressTotal = 0;
   emit started();
   emitProgress(2);
 
   mIgnorePlanes = quick;
   mProgressStatus.clear();
   mMessages.clear();
+  mCachedPaths.clear();
 
+  // Steps which modify the board must be completed before any check is
+  // started since the checks are running concurrently and rely on the board
+  // not being modified.
   if (!quick) {
-    rebuildPlanes(10);  // 10%
-  }
- //create a pool of four threads for a quick check. Start each of them, then join after the slow check conditional block
-  std::thread quickpool [4] = {};
-
-  //12
-  quickpool[0] = std::thread(&BoardDesignRuleCheck::checkMinimumCopperWidth,this,2);
-  quickpool[1] = std::thread(&BoardDesignRuleCheck::checkCopperCopperClearances,this,10);
-  quickpool[2] = std::thread(&BoardDesignRuleCheck::checkCopperBoardClearances,this,10);
-  quickpool[3] = std::thread(&BoardDesignRuleCheck::checkCopperHoleClearances,this,10);
-  //42
-  
-  /*checkMinimumCopperWidth(14);  // 2%
-  checkCopperCopperClearances(24);  // 10%
-  checkCopperBoardClearances(34);  // 10%
-  checkCopperHoleClearances(44);  // 10%
-  */
-
+    rebuildPlanes();  // can throw
+    emitProgress(10);
+    rebuildAirWires();
+    emitProgress(12);
+  }
+
+  // All checks only read from the board and are independent of each other,
+  // so they can be run in parallel. The order of this list defines the order
+  // of the resulting messages.
+  QVector<Check> checks = {
+      {&BoardDesignRuleCheck::checkMinimumCopperWidth, 2},
+      {&BoardDesignRuleCheck::checkCopperCopperClearances, 10},
+      {&BoardDesignRuleCheck::checkCopperBoardClearances, 10},
+      {&BoardDesignRuleCheck::checkCopperHoleClearances, 10},
+  };
   if (!quick) {
-    std::thread threadpool [20] = {};  
-      
-      
-    threadpool[0] = std::thread(&BoardDesignRuleCheck::checkDrillDrillClearances,this,4);//4%
-    threadpool[1] = std::thread(&BoardDesignRuleCheck::checkDrillBoardClearances,this,4);  // 4%
-    threadpool[2] = std::thread(&BoardDesignRuleCheck::checkSilkscreenStopmaskClearances,this,3);  // 4%
-    threadpool[3] = std::thread(&BoardDesignRuleCheck::checkMinimumPthAnnularRing,this,2);  // 3%
-    threadpool[4] = std::thread(&BoardDesignRuleCheck::checkMinimumNpthDrillDiameter,this,2);  // 2%
-    threadpool[5] = std::thread(&BoardDesignRuleCheck::checkMinimumNpthSlotWidth,this,2);  // 2%
-    threadpool[6] = std::thread(&BoardDesignRuleCheck::checkMinimumPthDrillDiameter,this,2);  // 2%
-    threadpool[7] = std::thread(&BoardDesignRuleCheck::checkMinimumPthSlotWidth,this,2);  // 2%
-    //63
-    threadpool[8] = std::thread(&BoardDesignRuleCheck::checkMinimumSilkscreenWidth,this,1);  // 1%
-    threadpool[9] = std::thread(&BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight,this,1);  // 1%
-    threadpool[10] = std::thread(&BoardDesignRuleCheck::checkZones,this,3);  // 3%
-    threadpool[11] = std::thread(&BoardDesignRuleCheck::checkVias,this,2);  // 2%
-    threadpool[12] = std::thread(&BoardDesignRuleCheck::checkAllowedNpthSlots,this,1);  // 1%
-    threadpool[13] = std::thread(&BoardDesignRuleCheck::checkAllowedPthSlots,this,1);  // 1%
-    threadpool[14] = std::thread(&BoardDesignRuleCheck::checkInvalidPadConnections,this,2);  // 2%
-    threadpool[15] = std::thread(&BoardDesignRuleCheck::checkDeviceClearances,this,10);  // 10%
-    threadpool[16] = std::thread(&BoardDesignRuleCheck::checkBoardOutline,this,3);  // 3%
-    threadpool[17] = std::thread(&BoardDesignRuleCheck::checkForUnplacedComponents,this,2);  // 2%
-    threadpool[18] = std::thread(&BoardDesignRuleCheck::checkForMissingConnections,this,2);  // 2%
-    threadpool[19] = std::thread(&BoardDesignRuleCheck::checkForStaleObjects,this,2);
-    
-    for(int i=0;i<20;i++){
-      threadpool[i].join();
-    }
-  }
-
-  for(int i=0;i<4;i++){
-    quickpool[i].join();
+    checks += QVector<Check>{
+        {&BoardDesignRuleCheck::checkDrillDrillClearances, 4},
+        {&BoardDesignRuleCheck::checkDrillBoardClearances, 4},
+        {&BoardDesignRuleCheck::checkSilkscreenStopmaskClearances, 4},
+        {&BoardDesignRuleCheck::checkMinimumPthAnnularRing, 3},
+        {&BoardDesignRuleCheck::checkMinimumNpthDrillDiameter, 2},
+        {&BoardDesignRuleCheck::checkMinimumNpthSlotWidth, 2},
+        {&BoardDesignRuleCheck::checkMinimumPthDrillDiameter, 2},
+        {&BoardDesignRuleCheck::checkMinimumPthSlotWidth, 2},
+        {&BoardDesignRuleCheck::checkMinimumSilkscreenWidth, 2},
+        {&BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight, 2},
+        {&BoardDesignRuleCheck::checkZones, 3},
+        {&BoardDesignRuleCheck::checkVias, 2},
+        {&BoardDesignRuleCheck::checkAllowedNpthSlots, 1},
+        {&BoardDesignRuleCheck::checkAllowedPthSlots, 1},
+        {&BoardDesignRuleCheck::checkInvalidPadConnections, 2},
+        {&BoardDesignRuleCheck::checkDeviceClearances, 10},
+        {&BoardDesignRuleCheck::checkBoardOutline, 3},
+        {&BoardDesignRuleCheck::checkForUnplacedComponents, 2},
+        {&BoardDesignRuleCheck::checkForMissingConnections, 2},
+        {&BoardDesignRuleCheck::checkForStaleObjects, 2},
+    };
   }
-
+  runChecks(checks);  // can throw
 
   emitStatus(
       tr("Finished with %1 message(s)!", "Count of messages", mMessages.count())
           .arg(mMessages.count()));
-  emitProgress(8);
+  emitProgress(100);
   emit finished();
 }
 
@@ -163,299 +150,119 @@ void BoardDesignRuleCheck::execute(bool quick) {
  *  Private Methods
  ******************************************************************************/
 
-void BoardDesignRuleCheck::rebuildPlanes(int progressEnd) {
-  emitStatus(tr("Rebuild planes..."));
-  BoardPlaneFragmentsBuilder builder;
-  builder.runSynchronously(mBoard);  // can throw
-  emitProgress(progressEnd);
-}
-
-void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
-  const UnsignedLength clearance = mSettings.getMinCopperCopperClearance();
-  if (clearance == 0) {
-    return;
+void BoardDesignRuleCheck::runChecks(const QVector<Check>& checks) {
+  {
+    QMutexLocker lock(&mMutex);
+    mResults = QVector<CheckResult>(checks.count());
+    mFinishedChecks.clear();
   }
 
-  emitStatus(tr("Check copper clearances..."));
-
-  // Subtract a tolerance to avoid false-positives due to inaccuracies.
-  const Length tolerance = maxArcTolerance() + Length(1);
-
-  // Determine the area of each copper object.
-  struct Item {
-    const BI_Base* item;
-    const Polygon* polygon;  // Only relevant if item is a BI_Device
-    const Circle* circle;  // Only relevant if item is a BI_Device
-    const Layer* startLayer;
-    const Layer* endLayer;
-    const NetSignal* netSignal;  // nullptr = no net
-    Length clearance;
-    ClipperLib::Paths copperArea;  // Exact copper outlines
-    ClipperLib::Paths clearanceArea;  // Copper outlines + clearance - tolerance
-  };
-  typedef QVector<Item> Items;
-  Items items;
+  // Use a private thread pool to avoid a deadlock if the DRC itself is run
+  // within the global thread pool, and to not be blocked by other tasks.
+  QThreadPool pool;
+  for (int i = 0; i < checks.count(); ++i) {
+    const Check check = checks.at(i);
+    QtConcurrent::run(&pool, [this, i, check]() { runCheck(i, check); });
+  }
 
-  // Net segments.
-  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-  foreach (const BI_NetSegment* netSegment, mBoard.getNetSegments()) {
-    // vias.
-    foreach (const BI_Via* via, netSegment->getVias()) {
-      auto it = items.insert(items.end(),
-                             Item{via,
-                                  nullptr,
-                                  nullptr,
-                                  &via->getVia().getStartLayer(),
-                                  &via->getVia().getEndLayer(),
-                                  via->getNetSegment().getNetSignal(),
-                                  *clearance,
-                                  {},
-                                  {}});
-      gen.addVia(*via);
-      gen.takePathsTo(it->copperArea);
-      gen.addVia(*via, clearance - tolerance);
-      gen.takePathsTo(it->clearanceArea);
+  // Report the progress on the calling thread as the checks finish.
+  for (int remaining = checks.count(); remaining > 0;) {
+    QVector<std::pair<int, CheckResult>> finishedChecks;
+    {
+      QMutexLocker lock(&mMutex);
+      while (mFinishedChecks.isEmpty()) {
+        mCheckFinishedCondition.wait(&mMutex);
+      }
+      foreach (int index, mFinishedChecks) {
+        finishedChecks.append(std::make_pair(index, mResults.at(index)));
+      }
+      mFinishedChecks.clear();
     }
-
-    // Net lines.
-    foreach (const BI_NetLine* netLine, netSegment->getNetLines()) {
-      if (mBoard.getCopperLayers().contains(&netLine->getLayer())) {
-        auto it = items.insert(items.end(),
-                               Item{netLine,
-                                    nullptr,
-                                    nullptr,
-                                    &netLine->getLayer(),
-                                    &netLine->getLayer(),
-                                    netLine->getNetSegment().getNetSignal(),
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addNetLine(*netLine);
-        gen.takePathsTo(it->copperArea);
-        gen.addNetLine(*netLine, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+    foreach (const auto& pair, finishedChecks) {
+      foreach (const QString& status, pair.second.status) {
+        emitStatus(status);
+      }
+      foreach (const auto& msg, pair.second.messages) {
+        emit progressMessage(msg->getMessage());
       }
+      emitProgress(mProgressPercent + checks.at(pair.first).progress);
+      --remaining;
     }
   }
+  pool.waitForDone();
 
-  // Planes.
-  if (!mIgnorePlanes) {
-    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
-      if (mBoard.getCopperLayers().contains(&plane->getLayer())) {
-        auto it = items.insert(items.end(),
-                               Item{plane,
-                                    nullptr,
-                                    nullptr,
-                                    &plane->getLayer(),
-                                    &plane->getLayer(),
-                                    plane->getNetSignal(),
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addPlane(*plane);
-        gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                               maxArcTolerance());
-      }
-    }
-  }
-
-  // Board polygons.
-  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
-    if (mBoard.getCopperLayers().contains(&polygon->getData().getLayer())) {
-      auto it = items.insert(items.end(),
-                             Item{polygon,
-                                  nullptr,
-                                  nullptr,
-                                  &polygon->getData().getLayer(),
-                                  &polygon->getData().getLayer(),
-                                  nullptr,
-                                  *clearance,
-                                  {},
-                                  {}});
-      gen.addPolygon(polygon->getData().getPath(),
-                     polygon->getData().getLineWidth(),
-                     polygon->getData().isFilled());
-      gen.takePathsTo(it->copperArea);
-      it->clearanceArea = it->copperArea;
-      ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                             maxArcTolerance());
-    }
+  // Merge the results in the order of the checks to get a deterministic
+  // output, independent of the order in which the checks have finished.
+  for (const CheckResult& result : mResults) {
+    mMessages += result.messages;
   }
-
-  // Board stroke texts.
-  foreach (const BI_StrokeText* strokeText, mBoard.getStrokeTexts()) {
-    if (mBoard.getCopperLayers().contains(&strokeText->getData().getLayer())) {
-      auto it = items.insert(items.end(),
-                             Item{strokeText,
-                                  nullptr,
-                                  nullptr,
-                                  &strokeText->getData().getLayer(),
-                                  &strokeText->getData().getLayer(),
-                                  nullptr,
-                                  *clearance,
-                                  {},
-                                  {}});
-      gen.addStrokeText(*strokeText);
-      gen.takePathsTo(it->copperArea);
-      gen.addStrokeText(*strokeText, clearance - tolerance);
-      gen.takePathsTo(it->clearanceArea);
+  for (const CheckResult& result : mResults) {
+    if (result.error) {
+      result.error->raise();
     }
   }
+}
 
-  // Devices.
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const Transform transform(*device);
+void BoardDesignRuleCheck::runCheck(int index, const Check& check) noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    mRunningChecks.insert(QThread::currentThread(), index);
+  }
+  std::shared_ptr<Exception> error;
+  try {
+    (this->*check.function)();  // can throw
+  } catch (const Exception& e) {
+    error.reset(e.clone());
+  } catch (const std::exception& e) {
+    error = std::make_shared<RuntimeError>(__FILE__, __LINE__,
+                                           QString::fromUtf8(e.what()));
+  }
+  QMutexLocker lock(&mMutex);
+  mRunningChecks.remove(QThread::currentThread());
+  mResults[index].error = error;
+  mFinishedChecks.append(index);
+  mCheckFinishedCondition.wakeAll();
+}
 
-    // Pads.
-    foreach (const BI_FootprintPad* pad, device->getPads()) {
-      const UnsignedLength padClearance =
-          std::max(clearance, pad->getLibPad().getCopperClearance());
-      foreach (const Layer* layer, mBoard.getCopperLayers()) {
-        if (pad->isOnLayer(*layer)) {
-          auto it = items.insert(items.end(),
-                                 Item{pad,
-                                      nullptr,
-                                      nullptr,
-                                      layer,
-                                      layer,
-                                      pad->getCompSigInstNetSignal(),
-                                      *padClearance,
-                                      {},
-                                      {}});
-          gen.addPad(*pad, *layer);
-          gen.takePathsTo(it->copperArea);
-          gen.addPad(*pad, *layer, padClearance - tolerance);
-          gen.takePathsTo(it->clearanceArea);
-        }
-      }
-    }
+void BoardDesignRuleCheck::rebuildPlanes() {
+  emitStatus(tr("Rebuild planes..."));
+  BoardPlaneFragmentsBuilder builder;
+  builder.runSynchronously(mBoard);  // can throw
+}
 
-    // Polygons.
-    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
-      if (mBoard.getCopperLayers().contains(
-              &transform.map(polygon.getLayer()))) {
-        auto it = items.insert(items.end(),
-                               Item{device,
-                                    &polygon,
-                                    nullptr,
-                                    &polygon.getLayer(),
-                                    &polygon.getLayer(),
-                                    nullptr,
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addPolygon(transform.map(polygon.getPath()), polygon.getLineWidth(),
-                       polygon.isFilled());
-        gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                               maxArcTolerance());
-      }
-    }
+void BoardDesignRuleCheck::rebuildAirWires() {
+  emitStatus(tr("Rebuild airwires..."));
+  mBoard.forceAirWiresRebuild();
+}
 
-    // Circles.
-    for (const Circle& circle : device->getLibFootprint().getCircles()) {
-      if (mBoard.getCopperLayers().contains(
-              &transform.map(circle.getLayer()))) {
-        auto it = items.insert(items.end(),
-                               Item{device,
-                                    nullptr,
-                                    &circle,
-                                    &circle.getLayer(),
-                                    &circle.getLayer(),
-                                    nullptr,
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addCircle(circle, transform);
-        gen.takePathsTo(it->copperArea);
-        gen.addCircle(circle, transform, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
-      }
-    }
+void BoardDesignRuleCheck::checkCopperCopperClearances() {
+  const UnsignedLength clearance = mSettings.getMinCopperCopperClearance();
+  if (clearance == 0) {
+    return;
+  }
 
-    // Stroke texts.
-    foreach (const BI_StrokeText* strokeText, device->getStrokeTexts()) {
-      // Layer does not need to be transformed!
-      if (mBoard.getCopperLayers().contains(
-              &strokeText->getData().getLayer())) {
-        auto it = items.insert(items.end(),
-                               Item{strokeText,
-                                    nullptr,
-                                    nullptr,
-                                    &strokeText->getData().getLayer(),
-                                    &strokeText->getData().getLayer(),
-                                    nullptr,
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addStrokeText(*strokeText);
-        gen.takePathsTo(it->copperArea);
-        gen.addStrokeText(*strokeText, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
-      }
-    }
+  emitStatus(tr("Check copper clearances..."));
+
+  // Determine the area of each copper object.
+  BoardCopperClearanceCheck check(mBoard, clearance, mIgnorePlanes,
+                                  maxArcTolerance());  // can throw
+  for (int i = 0; i < check.getItems().count(); ++i) {
+    check.prepareCopperArea(i);  // can throw
+    check.prepareItem(i);  // can throw
   }
 
-  // Now check for intersections.
-  QVector<const Layer*> overlappingLayers;
-  auto layersOverlap = [this, &overlappingLayers](
-                           const Layer* start1, const Layer* end1,
-                           const Layer* start2, const Layer* end2) {
-    overlappingLayers.clear();
-    const int first =
-        std::max(start1->getCopperNumber(), start2->getCopperNumber());
-    const int last = std::min(end1->getCopperNumber(), end2->getCopperNumber());
-    for (int i = first; i <= last; ++i) {
-      const Layer* layer = Layer::copper(i);
-      if (mBoard.getCopperLayers().contains(layer) &&
-          (!overlappingLayers.contains(layer))) {
-        overlappingLayers.append(layer);
-      }
-    }
-    return !overlappingLayers.isEmpty();
-  };
-  auto checkForIntersections = [](Items::Iterator& it1, Items::Iterator& it2,
-                                  QVector<Path>& locations) {
-    const std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersectToTree(it1->copperArea, it2->clearanceArea,
-                                        ClipperLib::pftEvenOdd,
-                                        ClipperLib::pftEvenOdd);
-    locations.append(
-        ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections)));
-  };
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      if (((it1->netSignal != it2->netSignal) || (!it1->netSignal) ||
-           (!it2->netSignal)) &&
-          layersOverlap(it1->startLayer, it1->endLayer, it2->startLayer,
-                        it2->endLayer)) {
-        QVector<Path> locations;
-        checkForIntersections(it1, it2, locations);
-        // Perform the check the other way around only if:
-        //  - Either the two items have individual clearances
-        //  - Or there are any intersections -> show both violations in UI
-        if ((it1->clearance != it2->clearance) || (!locations.isEmpty())) {
-          checkForIntersections(it2, it1, locations);
-        }
-        if (!locations.isEmpty()) {
-          emitMessage(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
-              it1->netSignal, *it1->item, it1->polygon, it1->circle,
-              it2->netSignal, *it2->item, it2->polygon, it2->circle,
-              overlappingLayers, std::max(it1->clearance, it2->clearance),
-              locations));
-        }
-      }
+  // Now check for intersections. Only item pairs with overlapping bounding
+  // boxes can intersect, so use a spatial index to avoid comparing every item
+  // with every other item.
+  check.buildIndex();
+  for (const auto& pair : check.getIndex().findIntersectingPairs()) {
+    if (auto violation = check.check(pair.first, pair.second)) {  // can throw
+      emitMessage(check.createMessage(*violation));
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkCopperBoardClearances(int progressEnd) {
+void BoardDesignRuleCheck::checkCopperBoardClearances() {
   const UnsignedLength clearance = mSettings.getMinCopperBoardClearance();
   if (clearance == 0) {
     return;
@@ -599,11 +406,9 @@ void BoardDesignRuleCheck::checkCopperBoardClearances(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkCopperHoleClearances(int progressEnd) {
+void BoardDesignRuleCheck::checkCopperHoleClearances() {
   const UnsignedLength clearance = mSettings.getMinCopperNpthClearance();
   if (clearance == 0) {
     return;
@@ -654,11 +459,9 @@ void BoardDesignRuleCheck::checkCopperHoleClearances(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
+void BoardDesignRuleCheck::checkDrillDrillClearances() {
   const UnsignedLength clearance = mSettings.getMinDrillDrillClearance();
   if (clearance == 0) {
     return;
@@ -723,30 +526,32 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
     }
   }
 
-  // Now check for intersections.
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      const std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersectToTree(it1->areas, it2->areas,
-                                          ClipperLib::pftEvenOdd,
-                                          ClipperLib::pftEvenOdd);
-      const ClipperLib::Paths paths =
-          ClipperHelpers::flattenTree(*intersections);
-      if ((!paths.empty()) && it1->item && it1->hole && it2->item &&
-          it2->hole) {
-        const QVector<Path> locations = ClipperHelpers::convert(paths);
-        emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
-            *it1->item, *it1->hole, *it2->item, *it2->hole, clearance,
-            locations));
-      }
+  // Now check for intersections of items with overlapping bounding boxes.
+  QVector<SpatialIndex::Rect> rects;
+  rects.reserve(items.count());
+  for (const Item& item : items) {
+    rects.append(SpatialIndex::boundingRect(item.areas));
+  }
+  const SpatialIndex index(rects);
+  for (const auto& pair : index.findIntersectingPairs()) {
+    const Item& item1 = items.at(pair.first);
+    const Item& item2 = items.at(pair.second);
+    const std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersectToTree(item1.areas, item2.areas,
+                                        ClipperLib::pftEvenOdd,
+                                        ClipperLib::pftEvenOdd);
+    const ClipperLib::Paths paths = ClipperHelpers::flattenTree(*intersections);
+    if ((!paths.empty()) && item1.item && item1.hole && item2.item &&
+        item2.hole) {
+      const QVector<Path> locations = ClipperHelpers::convert(paths);
+      emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
+          *item1.item, *item1.hole, *item2.item, *item2.hole, clearance,
+          locations));
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkDrillBoardClearances(int progressEnd) {
+void BoardDesignRuleCheck::checkDrillBoardClearances() {
   const UnsignedLength clearance = mSettings.getMinDrillBoardClearance();
   if (clearance == 0) {
     return;
@@ -816,11 +621,9 @@ void BoardDesignRuleCheck::checkDrillBoardClearances(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkSilkscreenStopmaskClearances(int progressEnd) {
+void BoardDesignRuleCheck::checkSilkscreenStopmaskClearances() {
   const UnsignedLength clearance =
       mSettings.getMinSilkscreenStopmaskClearance();
   const QVector<const Layer*> layersTop = mBoard.getSilkscreenLayersTop();
@@ -904,11 +707,9 @@ void BoardDesignRuleCheck::checkSilkscreenStopmaskClearances(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumCopperWidth() {
   const UnsignedLength minWidth = mSettings.getMinCopperWidth();
   if (minWidth == 0) {
     return;
@@ -918,10 +719,9 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressEnd) {
   checkMinimumWidth(minWidth, [this](const Layer& layer) {
     return mBoard.getCopperLayers().contains(&layer);
   });
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumPthAnnularRing(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumPthAnnularRing() {
   const UnsignedLength annularWidth = mSettings.getMinPthAnnularRing();
   if (annularWidth == 0) {
     return;
@@ -984,11 +784,9 @@ void BoardDesignRuleCheck::checkMinimumPthAnnularRing(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter() {
   const UnsignedLength minDiameter = mSettings.getMinNpthDrillDiameter();
   if (minDiameter == 0) {
     return;
@@ -1015,11 +813,9 @@ void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumNpthSlotWidth(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumNpthSlotWidth() {
   const UnsignedLength minWidth = mSettings.getMinNpthSlotWidth();
   if (minWidth == 0) {
     return;
@@ -1046,11 +842,9 @@ void BoardDesignRuleCheck::checkMinimumNpthSlotWidth(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumPthDrillDiameter() {
   const UnsignedLength minDiameter = mSettings.getMinPthDrillDiameter();
   if (minDiameter == 0) {
     return;
@@ -1084,11 +878,9 @@ void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumPthSlotWidth(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumPthSlotWidth() {
   const UnsignedLength minWidth = mSettings.getMinPthSlotWidth();
   if (minWidth == 0) {
     return;
@@ -1108,11 +900,9 @@ void BoardDesignRuleCheck::checkMinimumPthSlotWidth(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumSilkscreenWidth(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumSilkscreenWidth() {
   const UnsignedLength minWidth = mSettings.getMinSilkscreenWidth();
   const QVector<const Layer*> layers =
       mBoard.getSilkscreenLayersTop() + mBoard.getSilkscreenLayersBot();
@@ -1124,10 +914,9 @@ void BoardDesignRuleCheck::checkMinimumSilkscreenWidth(int progressEnd) {
   checkMinimumWidth(minWidth, [&layers](const Layer& layer) {
     return layers.contains(&layer);
   });
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight(int progressEnd) {
+void BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight() {
   const UnsignedLength minHeight = mSettings.getMinSilkscreenTextHeight();
   const QVector<const Layer*> layers =
       mBoard.getSilkscreenLayersTop() + mBoard.getSilkscreenLayersBot();
@@ -1151,10 +940,9 @@ void BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight(int progressEnd) {
           *text, minHeight, locations));
     }
   }
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkZones(int progressEnd) {
+void BoardDesignRuleCheck::checkZones() {
   emitStatus(tr("Check keepout zones..."));
 
   // Collect all zones.
@@ -1413,11 +1201,9 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkVias(int progressEnd) {
+void BoardDesignRuleCheck::checkVias() {
   emitStatus(tr("Check for useless or disallowed vias..."));
 
   foreach (const BI_NetSegment* segment, mBoard.getNetSegments()) {
@@ -1434,11 +1220,9 @@ void BoardDesignRuleCheck::checkVias(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkAllowedNpthSlots(int progressEnd) {
+void BoardDesignRuleCheck::checkAllowedNpthSlots() {
   const BoardDesignRuleCheckSettings::AllowedSlots allowed =
       mSettings.getAllowedNpthSlots();
   if (allowed == BoardDesignRuleCheckSettings::AllowedSlots::Any) {
@@ -1465,11 +1249,9 @@ void BoardDesignRuleCheck::checkAllowedNpthSlots(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkAllowedPthSlots(int progressEnd) {
+void BoardDesignRuleCheck::checkAllowedPthSlots() {
   const BoardDesignRuleCheckSettings::AllowedSlots allowed =
       mSettings.getAllowedPthSlots();
   if (allowed == BoardDesignRuleCheckSettings::AllowedSlots::Any) {
@@ -1490,11 +1272,9 @@ void BoardDesignRuleCheck::checkAllowedPthSlots(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkInvalidPadConnections(int progressEnd) {
+void BoardDesignRuleCheck::checkInvalidPadConnections() {
   emitStatus(tr("Check pad connections..."));
 
   // Pads.
@@ -1524,11 +1304,9 @@ void BoardDesignRuleCheck::checkInvalidPadConnections(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkDeviceClearances(int progressEnd) {
+void BoardDesignRuleCheck::checkDeviceClearances() {
   emitStatus(tr("Check device clearances..."));
 
   for (const auto& layers :
@@ -1580,11 +1358,9 @@ void BoardDesignRuleCheck::checkDeviceClearances(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkBoardOutline(int progressEnd) {
+void BoardDesignRuleCheck::checkBoardOutline() {
   emitStatus(tr("Check board outline..."));
 
   // Report all open polygons.
@@ -1655,11 +1431,9 @@ void BoardDesignRuleCheck::checkBoardOutline(int progressEnd) {
               minEdgeRadius, locations));
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkForUnplacedComponents(int progressEnd) {
+void BoardDesignRuleCheck::checkForUnplacedComponents() {
   emitStatus(tr("Check for unplaced components..."));
 
   foreach (const ComponentInstance* cmp,
@@ -1670,16 +1444,13 @@ void BoardDesignRuleCheck::checkForUnplacedComponents(int progressEnd) {
       emitMessage(std::make_shared<DrcMsgMissingDevice>(*cmp));
     }
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkForMissingConnections(int progressEnd) {
+void BoardDesignRuleCheck::checkForMissingConnections() {
   emitStatus(tr("Check for missing connections..."));
 
   // No check based on copper paths implemented yet -> return existing airwires
-  // instead.
-  mBoard.forceAirWiresRebuild();
+  // instead. Note that the airwires have already been rebuilt in advance.
   foreach (const BI_AirWire* airWire, mBoard.getAirWires()) {
     const QVector<Path> locations{Path::obround(airWire->getP1().getPosition(),
                                                 airWire->getP2().getPosition(),
@@ -1688,11 +1459,9 @@ void BoardDesignRuleCheck::checkForMissingConnections(int progressEnd) {
         airWire->getP1(), airWire->getP2(), airWire->getNetSignal(),
         locations));
   }
-
-  emitProgress(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkForStaleObjects(int progressEnd) {
+void BoardDesignRuleCheck::checkForStaleObjects() {
   emitStatus(tr("Check for stale objects..."));
 
   foreach (const BI_NetSegment* netSegment, mBoard.getNetSegments()) {
@@ -1711,8 +1480,6 @@ void BoardDesignRuleCheck::checkForStaleObjects(int progressEnd) {
       }
     }
   }
-
-  emitProgress(progressEnd);
 }
 
 void BoardDesignRuleCheck::checkMinimumWidth(
@@ -1909,8 +1676,11 @@ QVector<Path> BoardDesignRuleCheck::getBoardOutlines(
   return outlines;
 }
 
-const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
+ClipperLib::Paths BoardDesignRuleCheck::getCopperPaths(
     const Layer& layer, const QSet<const NetSignal*>& netsignals) {
+  // Keep the mutex locked while building the paths to avoid building the
+  // same paths several times in parallel.
+  QMutexLocker lock(&mCachedPathsMutex);
   const auto key = qMakePair(&layer, netsignals);
   if (!mCachedPaths.contains(key)) {
     BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
@@ -2017,28 +1787,36 @@ QVector<Path> BoardDesignRuleCheck::getHoleLocation(
 }
 
 void BoardDesignRuleCheck::emitProgress(int percent) noexcept {
-  messagemutex.lock();
-  progressTotal += percent;
-  mProgressPercent = progressTotal;
-  emit progressPercent(mProgressPercent);
-  messagemutex.unlock();
+  mProgressPercent = percent;
+  emit progressPercent(percent);
 }
 
 void BoardDesignRuleCheck::emitStatus(const QString& status) noexcept {
-  messagemutex.lock();
-  mProgressStatus.append(status);
-  emit progressStatus(status);
-  qApp->processEvents();
-  messagemutex.unlock();
+  QMutexLocker lock(&mMutex);
+  const int index = mRunningChecks.value(QThread::currentThread(), -1);
+  if (index >= 0) {
+    // Called from a running check, will be reported once it is finished.
+    mResults[index].status.append(status);
+  } else {
+    lock.unlock();
+    mProgressStatus.append(status);
+    emit progressStatus(status);
+    qApp->processEvents();
+  }
 }
 
 void BoardDesignRuleCheck::emitMessage(
     const std::shared_ptr<const RuleCheckMessage>& msg) noexcept {
-    messagemutex.lock();
-    
-  mMessages.append(msg);
-  emit progressMessage(msg->getMessage());
-    messagemutex.unlock();
+  QMutexLocker lock(&mMutex);
+  const int index = mRunningChecks.value(QThread::currentThread(), -1);
+  if (index >= 0) {
+    // Called from a running check, will be reported once it is finished.
+    mResults[index].messages.append(msg);
+  } else {
+    lock.unlock();
+    mMessages.append(msg);
+    emit progressMessage(msg->getMessage());
+  }
 }
 
 QString BoardDesignRuleCheck::formatLength(
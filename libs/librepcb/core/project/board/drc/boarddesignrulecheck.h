@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../exceptions.h"
 #include "../../../utils/transform.h"
 #include "boarddesignrulecheckmessages.h"
 #include "boarddesignrulechecksettings.h"
@@ -31,6 +32,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -75,32 +78,47 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  struct Check {
+    void (BoardDesignRuleCheck::*function)();
+    int progress;  ///< Progress increment in percent when finished
+  };
+
+  struct CheckResult {
+    QStringList status;
+    RuleCheckMessageList messages;
+    std::shared_ptr<Exception> error;
+  };
+
 private:  // Methods
-  void rebuildPlanes(int progressEnd);
-  void checkCopperCopperClearances(int progressEnd);
-  void checkCopperBoardClearances(int progressEnd);
-  void checkCopperHoleClearances(int progressEnd);
-  void checkDrillDrillClearances(int progressEnd);
-  void checkDrillBoardClearances(int progressEnd);
-  void checkSilkscreenStopmaskClearances(int progressEnd);
-  void checkMinimumCopperWidth(int progressEnd);
-  void checkMinimumPthAnnularRing(int progressEnd);
-  void checkMinimumNpthDrillDiameter(int progressEnd);
-  void checkMinimumNpthSlotWidth(int progressEnd);
-  void checkMinimumPthDrillDiameter(int progressEnd);
-  void checkMinimumPthSlotWidth(int progressEnd);
-  void checkMinimumSilkscreenWidth(int progressEnd);
-  void checkMinimumSilkscreenTextHeight(int progressEnd);
-  void checkZones(int progressEnd);
-  void checkVias(int progressEnd);
-  void checkAllowedNpthSlots(int progressEnd);
-  void checkAllowedPthSlots(int progressEnd);
-  void checkInvalidPadConnections(int progressEnd);
-  void checkDeviceClearances(int progressEnd);
-  void checkBoardOutline(int progressEnd);
-  void checkForUnplacedComponents(int progressEnd);
-  void checkForMissingConnections(int progressEnd);
-  void checkForStaleObjects(int progressEnd);
+  void runChecks(const QVector<Check>& checks);
+  void runCheck(int index, const Check& check) noexcept;
+  void rebuildPlanes();
+  void rebuildAirWires();
+  void checkCopperCopperClearances();
+  void checkCopperBoardClearances();
+  void checkCopperHoleClearances();
+  void checkDrillDrillClearances();
+  void checkDrillBoardClearances();
+  void checkSilkscreenStopmaskClearances();
+  void checkMinimumCopperWidth();
+  void checkMinimumPthAnnularRing();
+  void checkMinimumNpthDrillDiameter();
+  void checkMinimumNpthSlotWidth();
+  void checkMinimumPthDrillDiameter();
+  void checkMinimumPthSlotWidth();
+  void checkMinimumSilkscreenWidth();
+  void checkMinimumSilkscreenTextHeight();
+  void checkZones();
+  void checkVias();
+  void checkAllowedNpthSlots();
+  void checkAllowedPthSlots();
+  void checkInvalidPadConnections();
+  void checkDeviceClearances();
+  void checkBoardOutline();
+  void checkForUnplacedComponents();
+  void checkForMissingConnections();
+  void checkForStaleObjects();
   void checkMinimumWidth(const UnsignedLength& minWidth,
                          std::function<bool(const Layer&)> layerFilter);
   template <typename THole>
@@ -110,7 +128,7 @@ private:  // Methods
       const UnsignedLength& clearance) const;
   QVector<Path> getBoardOutlines(
       const QSet<const Layer*>& layers) const noexcept;
-  const ClipperLib::Paths& getCopperPaths(
+  ClipperLib::Paths getCopperPaths(
       const Layer& layer, const QSet<const NetSignal*>& netsignals);
   ClipperLib::Paths getDeviceOutlinePaths(const BI_Device& device,
                                           const Layer& layer);
@@ -141,6 +159,14 @@ private:  // Data
   RuleCheckMessageList mMessages;
   QHash<QPair<const Layer*, QSet<const NetSignal*>>, ClipperLib::Paths>
       mCachedPaths;
+  QMutex mCachedPathsMutex;
+
+  // State of concurrently running checks, protected by mMutex
+  QMutex mMutex;
+  QWaitCondition mCheckFinishedCondition;
+  QHash<QThread*, int> mRunningChecks;  ///< Thread -> index of running check
+  QVector<CheckResult> mResults;  ///< Indexed like the executed checks
+  QVector<int> mFinishedChecks;  ///< Indices of finished, unreported checks
 };
 
 /*******************************************************************************
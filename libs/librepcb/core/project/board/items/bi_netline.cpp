@@ -125,13 +125,8 @@ BI_NetLineAnchor* BI_NetLine::getOtherPoint(
 }
 
 Path BI_NetLine::getSceneOutline(const Length& expansion) const noexcept {
-  Length width = getWidth() + (expansion * 2);
-  if (width > 0) {
-    return Path::obround(mStartPoint->getPosition(), mEndPoint->getPosition(),
-                         PositiveLength(width));
-  } else {
-    return Path();
-  }
+  return Path::obround(mStartPoint->getPosition(), mEndPoint->getPosition(),
+                       getWidth() + (expansion * 2));
 }
 
 UnsignedLength BI_NetLine::getLength() const noexcept {
@@ -57,7 +57,8 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const Layer& layer,
     mThermalSpokeWidth(300000),
     mLocked(false),
     mIsVisible(true),
-    mFragments() {
+    mFragments(),
+    mFragmentsHash() {
 }
 
 BI_Plane::~BI_Plane() noexcept {
@@ -168,7 +169,9 @@ void BI_Plane::setVisible(bool visible) noexcept {
   }
 }
 
-void BI_Plane::setCalculatedFragments(const QVector<Path>& fragments) noexcept {
+void BI_Plane::setCalculatedFragments(const QVector<Path>& fragments,
+                                      const QByteArray& hash) noexcept {
+  mFragmentsHash = hash;
   if (fragments != mFragments) {
     mFragments = fragments;
     onEdited.notify(Event::FragmentsChanged);
@@ -95,6 +95,9 @@ public:
   }
   const Path& getOutline() const noexcept { return mOutline; }
   const QVector<Path>& getFragments() const noexcept { return mFragments; }
+  const QByteArray& getFragmentsHash() const noexcept {
+    return mFragmentsHash;
+  }
   bool isLocked() const noexcept { return mLocked; }
   bool isVisible() const noexcept { return mIsVisible; }
 
@@ -111,7 +114,8 @@ public:
   void setKeepIslands(bool keep) noexcept;
   void setLocked(bool locked) noexcept;
   void setVisible(bool visible) noexcept;
-  void setCalculatedFragments(const QVector<Path>& fragments) noexcept;
+  void setCalculatedFragments(const QVector<Path>& fragments,
+                              const QByteArray& hash = QByteArray()) noexcept;
 
   // General Methods
   void addToBoard() override;
@@ -143,6 +147,7 @@ private:  // Data
   bool mIsVisible;  // volatile, not saved to file
 
   QVector<Path> mFragments;
+  QByteArray mFragmentsHash;  ///< Hash of the input data of mFragments
 };
 
 /*******************************************************************************
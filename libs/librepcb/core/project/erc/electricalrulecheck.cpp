@@ -30,6 +30,7 @@
 #include "../circuit/netclass.h"
 #include "../circuit/netsignal.h"
 #include "../project.h"
+#include "../schematic/items/si_netline.h"
 #include "../schematic/items/si_netpoint.h"
 #include "../schematic/items/si_netsegment.h"
 #include "../schematic/items/si_symbol.h"
@@ -39,11 +40,83 @@
 
 #include <QtCore>
 
+#include <tuple>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Struct Methods
+ ******************************************************************************/
+
+bool ElectricalRuleCheck::NetSignalData::operator==(
+    const NetSignalData& rhs) const noexcept {
+  return std::tie(uuid, name, realComponentSignalCount) ==
+      std::tie(rhs.uuid, rhs.name, rhs.realComponentSignalCount);
+}
+
+bool ElectricalRuleCheck::ComponentSignalData::operator==(
+    const ComponentSignalData& rhs) const noexcept {
+  return std::tie(uuid, name, required, hasNet, netName, netNameForced,
+                  forcedNetName) ==
+      std::tie(rhs.uuid, rhs.name, rhs.required, rhs.hasNet, rhs.netName,
+               rhs.netNameForced, rhs.forcedNetName);
+}
+
+bool ElectricalRuleCheck::GateData::operator==(const GateData& rhs) const
+    noexcept {
+  return std::tie(uuid, suffix, required, placed) ==
+      std::tie(rhs.uuid, rhs.suffix, rhs.required, rhs.placed);
+}
+
+bool ElectricalRuleCheck::ComponentData::operator==(
+    const ComponentData& rhs) const noexcept {
+  return std::tie(uuid, name, componentSignals, gates) ==
+      std::tie(rhs.uuid, rhs.name, rhs.componentSignals, rhs.gates);
+}
+
+bool ElectricalRuleCheck::PinData::operator==(const PinData& rhs) const
+    noexcept {
+  return std::tie(uuid, name, hasNetLines, hasNet) ==
+      std::tie(rhs.uuid, rhs.name, rhs.hasNetLines, rhs.hasNet);
+}
+
+QString ElectricalRuleCheck::SymbolData::getName() const noexcept {
+  // Same as SI_Symbol::getName(), but only built when actually needed.
+  if (suffix.isEmpty()) {
+    return componentName;
+  } else {
+    return componentName % "-" % suffix;
+  }
+}
+
+bool ElectricalRuleCheck::SymbolData::operator==(const SymbolData& rhs) const
+    noexcept {
+  return std::tie(uuid, componentName, suffix, pins) ==
+      std::tie(rhs.uuid, rhs.componentName, rhs.suffix, rhs.pins);
+}
+
+bool ElectricalRuleCheck::NetPointData::operator==(
+    const NetPointData& rhs) const noexcept {
+  return std::tie(uuid, hasNetLines) == std::tie(rhs.uuid, rhs.hasNetLines);
+}
+
+bool ElectricalRuleCheck::NetSegmentData::operator==(
+    const NetSegmentData& rhs) const noexcept {
+  return std::tie(uuid, netSignal, netName, hasNetLabels, hasOpenWire,
+                  netPoints) ==
+      std::tie(rhs.uuid, rhs.netSignal, rhs.netName, rhs.hasNetLabels,
+               rhs.hasOpenWire, rhs.netPoints);
+}
+
+bool ElectricalRuleCheck::SchematicData::operator==(
+    const SchematicData& rhs) const noexcept {
+  return std::tie(uuid, symbols, netSegments) ==
+      std::tie(rhs.uuid, rhs.symbols, rhs.netSegments);
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -60,40 +133,34 @@ ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
  ******************************************************************************/
 
 RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
-  mOpenNetSignals.clear();
-
-  RuleCheckMessageList msgs;
-  checkNetClasses(msgs);
-  checkNetSignals(msgs);
-  checkComponents(msgs);
-  checkSchematics(msgs);
-  return msgs;
+  return run(createSnapshot(mProject), nullptr)->messages;
 }
 
 /*******************************************************************************
- *  Private Methods
+ *  Static Methods
  ******************************************************************************/
 
-void ElectricalRuleCheck::checkNetClasses(RuleCheckMessageList& msgs) const {
-  // Don't warn if there's only one netclass, as we need one to be used as
-  // default when adding a new wire.
-  if (mProject.getCircuit().getNetClasses().count() <= 1) {
-    return;
-  }
+std::shared_ptr<const ElectricalRuleCheck::Data>
+    ElectricalRuleCheck::createSnapshot(const Project& project) {
+  // Note: This is executed in the GUI thread on every check, so keep it cheap!
+  // Only copy (implicitly shared) values which are already available and
+  // defer any string building or other processing to the checks.
+  std::shared_ptr<Data> data = std::make_shared<Data>();
+  const Circuit& circuit = project.getCircuit();
+  data->netClasses.reserve(circuit.getNetClasses().count());
+  data->netSignals.reserve(circuit.getNetSignals().count());
+  data->components.reserve(circuit.getComponentInstances().count());
+  data->schematics.reserve(project.getSchematics().count());
 
-  foreach (const NetClass* netClass, mProject.getCircuit().getNetClasses()) {
-    if (!netClass->isUsed()) {
-      msgs.append(std::make_shared<ErcMsgUnusedNetClass>(*netClass));
-    }
+  foreach (const NetClass* netClass, circuit.getNetClasses()) {
+    data->netClasses.append(NetClassData{
+        netClass->getUuid(), *netClass->getName(), netClass->isUsed()});
   }
-}
 
-void ElectricalRuleCheck::checkNetSignals(RuleCheckMessageList& msgs) const {
-  foreach (const NetSignal* net, mProject.getCircuit().getNetSignals()) {
-    // Raise a warning if the net signal is connected to less then two component
-    // signals. But do not count component signals of schematic-only components
-    // since these are just "virtual" connections, i.e. not represented by a
-    // real pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
+  foreach (const NetSignal* net, circuit.getNetSignals()) {
+    // Do not count component signals of schematic-only components since these
+    // are just "virtual" connections, i.e. not represented by a real pad (see
+    // https://github.com/LibrePCB/LibrePCB/issues/739).
     const QList<ComponentSignalInstance*>& sigs = net->getComponentSignals();
     int registeredRealComponentCount = sigs.count();
     if (registeredRealComponentCount >= 2) {  // Optimization
@@ -103,98 +170,276 @@ void ElectricalRuleCheck::checkNetSignals(RuleCheckMessageList& msgs) const {
         }
       }
     }
-    if (registeredRealComponentCount < 2) {
-      mOpenNetSignals.insert(net);
-      msgs.append(std::make_shared<ErcMsgOpenNet>(*net));
-    }
+    data->netSignals.append(NetSignalData{net->getUuid(), *net->getName(),
+                                          registeredRealComponentCount});
+  }
+
+  foreach (const ComponentInstance* cmp, circuit.getComponentInstances()) {
+    data->components.append(createComponentSnapshot(*cmp));
+  }
+
+  foreach (const Schematic* schematic, project.getSchematics()) {
+    data->schematics.append(createSchematicSnapshot(*schematic));
   }
+
+  return data;
 }
 
-void ElectricalRuleCheck::checkComponents(RuleCheckMessageList& msgs) const {
-  foreach (const ComponentInstance* cmp,
-           mProject.getCircuit().getComponentInstances()) {
-    checkComponentSignals(*cmp, msgs);
+std::shared_ptr<const ElectricalRuleCheck::Result> ElectricalRuleCheck::run(
+    std::shared_ptr<const Data> data, std::shared_ptr<const Result> previous,
+    const std::atomic<bool>* abort) noexcept {
+  // Note: This method may be called from a different thread, thus it must not
+  //       access anything else than the passed snapshot!
+  auto aborted = [abort]() { return abort && abort->load(); };
 
-    // Check for unplaced gates.
-    for (const ComponentSymbolVariantItem& gate :
-         cmp->getSymbolVariant().getSymbolItems()) {
-      if (!cmp->getSymbols().contains(gate.getUuid())) {
-        if (gate.isRequired()) {
-          msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(*cmp, gate));
-        } else {
-          msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(*cmp, gate));
-        }
-      }
+  std::shared_ptr<Result> result = std::make_shared<Result>();
+  result->data = data;
+  result->checkedObjects = 0;
+
+  // Map UUIDs to the indices of the previous run.
+  QHash<Uuid, int> previousNetSignals;
+  QHash<Uuid, int> previousComponents;
+  QHash<Uuid, int> previousSchematics;
+  if (previous) {
+    for (int i = 0; i < previous->data->netSignals.count(); ++i) {
+      previousNetSignals.insert(previous->data->netSignals.at(i).uuid, i);
+    }
+    for (int i = 0; i < previous->data->components.count(); ++i) {
+      previousComponents.insert(previous->data->components.at(i).uuid, i);
+    }
+    for (int i = 0; i < previous->data->schematics.count(); ++i) {
+      previousSchematics.insert(previous->data->schematics.at(i).uuid, i);
+    }
+  }
+
+  // Net classes are checked always as it is a cheap global check.
+  checkNetClasses(*data, result->messages);
+
+  foreach (const NetSignalData& net, data->netSignals) {
+    RuleCheckMessageList msgs;
+    const int index = previousNetSignals.value(net.uuid, -1);
+    if ((index >= 0) && (previous->data->netSignals.at(index) == net)) {
+      msgs = previous->netSignalMessages.at(index);
+    } else {
+      checkNetSignal(net, msgs);
+      ++result->checkedObjects;
+    }
+    if (net.realComponentSignalCount < 2) {
+      result->openNetSignals.insert(net.uuid);
     }
+    result->netSignalMessages.append(msgs);
+    result->messages.append(msgs);
   }
+
+  foreach (const ComponentData& cmp, data->components) {
+    if (aborted()) {
+      return nullptr;
+    }
+    RuleCheckMessageList msgs;
+    const int index = previousComponents.value(cmp.uuid, -1);
+    if ((index >= 0) && (previous->data->components.at(index) == cmp)) {
+      msgs = previous->componentMessages.at(index);
+    } else {
+      checkComponent(cmp, msgs);
+      ++result->checkedObjects;
+    }
+    result->componentMessages.append(msgs);
+    result->messages.append(msgs);
+  }
+
+  foreach (const SchematicData& schematic, data->schematics) {
+    if (aborted()) {
+      return nullptr;
+    }
+    RuleCheckMessageList msgs;
+    const int index = previousSchematics.value(schematic.uuid, -1);
+    if ((index >= 0) && (previous->data->schematics.at(index) == schematic) &&
+        (!hasOpenNetsChanged(schematic, result->openNetSignals,
+                             previous->openNetSignals))) {
+      msgs = previous->schematicMessages.at(index);
+    } else {
+      checkSchematic(schematic, result->openNetSignals, msgs);
+      ++result->checkedObjects;
+    }
+    result->schematicMessages.append(msgs);
+    result->messages.append(msgs);
+  }
+
+  return result;
 }
 
-void ElectricalRuleCheck::checkComponentSignals(
-    const ComponentInstance& cmp, RuleCheckMessageList& msgs) const {
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+ElectricalRuleCheck::ComponentData ElectricalRuleCheck::createComponentSnapshot(
+    const ComponentInstance& cmp) {
+  ComponentData data{cmp.getUuid(), *cmp.getName(), {}, {}};
+  data.componentSignals.reserve(cmp.getSignals().count());
+  data.gates.reserve(cmp.getSymbolVariant().getSymbolItems().count());
   foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
-    // Check for forced net name conflict.
-    const QString netName =
-        sig->getNetSignal() ? (*sig->getNetSignal()->getName()) : QString();
-    if ((sig->getCompSignal().isRequired()) && (!sig->getNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(*sig));
-    } else if (sig->isNetSignalNameForced() &&
-               (sig->getForcedNetSignalName() != netName)) {
-      msgs.append(std::make_shared<ErcMsgForcedNetSignalNameConflict>(*sig));
+    const NetSignal* net = sig->getNetSignal();
+    const bool forced = sig->isNetSignalNameForced();
+    // Substituting attributes of the forced net name is rather expensive, so
+    // only do it for signals which actually have a forced net name.
+    data.componentSignals.append(ComponentSignalData{
+        sig->getCompSignal().getUuid(), *sig->getCompSignal().getName(),
+        sig->getCompSignal().isRequired(), net != nullptr,
+        net ? (*net->getName()) : QString(), forced,
+        forced ? sig->getForcedNetSignalName() : QString()});
+  }
+  for (const ComponentSymbolVariantItem& gate :
+       cmp.getSymbolVariant().getSymbolItems()) {
+    data.gates.append(GateData{gate.getUuid(), *gate.getSuffix(),
+                               gate.isRequired(),
+                               cmp.getSymbols().contains(gate.getUuid())});
+  }
+  return data;
+}
+
+ElectricalRuleCheck::SchematicData ElectricalRuleCheck::createSchematicSnapshot(
+    const Schematic& schematic) {
+  SchematicData data{schematic.getUuid(), {}, {}};
+  data.symbols.reserve(schematic.getSymbols().count());
+  data.netSegments.reserve(schematic.getNetSegments().count());
+  foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
+    SymbolData symbolData{symbol->getUuid(),
+                          *symbol->getComponentInstance().getName(),
+                          *symbol->getCompSymbVarItem().getSuffix(),
+                          {}};
+    symbolData.pins.reserve(symbol->getPins().count());
+    foreach (const SI_SymbolPin* pin, symbol->getPins()) {
+      symbolData.pins.append(PinData{
+          pin->getLibPinUuid(), pin->getName(), !pin->getNetLines().isEmpty(),
+          pin->getCompSigInstNetSignal() != nullptr});
     }
+    data.symbols.append(symbolData);
   }
+  foreach (const SI_NetSegment* netSegment, schematic.getNetSegments()) {
+    data.netSegments.append(createNetSegmentSnapshot(*netSegment));
+  }
+  return data;
 }
 
-void ElectricalRuleCheck::checkSchematics(RuleCheckMessageList& msgs) const {
-  foreach (const Schematic* schematic, mProject.getSchematics()) {
-    checkSymbols(*schematic, msgs);
-    checkNetSegments(*schematic, msgs);
+ElectricalRuleCheck::NetSegmentData
+    ElectricalRuleCheck::createNetSegmentSnapshot(
+        const SI_NetSegment& netSegment) {
+  bool hasOpenWire = false;
+  foreach (const SI_NetLine* netLine, netSegment.getNetLines()) {
+    if (netLine->getStartPoint().isOpen() || netLine->getEndPoint().isOpen()) {
+      hasOpenWire = true;
+      break;
+    }
   }
+  NetSegmentData data{netSegment.getUuid(),
+                      netSegment.getNetSignal().getUuid(),
+                      *netSegment.getNetSignal().getName(),
+                      !netSegment.getNetLabels().isEmpty(),
+                      hasOpenWire,
+                      {}};
+  data.netPoints.reserve(netSegment.getNetPoints().count());
+  foreach (const SI_NetPoint* netPoint, netSegment.getNetPoints()) {
+    data.netPoints.append(
+        NetPointData{netPoint->getUuid(), !netPoint->getNetLines().isEmpty()});
+  }
+  return data;
 }
 
-void ElectricalRuleCheck::checkSymbols(const Schematic& schematic,
-                                       RuleCheckMessageList& msgs) const {
-  foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
-    checkPins(*symbol, msgs);
+void ElectricalRuleCheck::checkNetClasses(const Data& data,
+                                          RuleCheckMessageList& msgs) {
+  // Don't warn if there's only one netclass, as we need one to be used as
+  // default when adding a new wire.
+  if (data.netClasses.count() <= 1) {
+    return;
+  }
+
+  foreach (const NetClassData& netClass, data.netClasses) {
+    if (!netClass.used) {
+      msgs.append(
+          std::make_shared<ErcMsgUnusedNetClass>(netClass.uuid, netClass.name));
+    }
   }
 }
 
-void ElectricalRuleCheck::checkPins(const SI_Symbol& symbol,
-                                    RuleCheckMessageList& msgs) const {
-  foreach (const SI_SymbolPin* pin, symbol.getPins()) {
-    if ((pin->getNetLines().isEmpty()) && (pin->getCompSigInstNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(*pin));
+void ElectricalRuleCheck::checkNetSignal(const NetSignalData& net,
+                                         RuleCheckMessageList& msgs) {
+  // Raise a warning if the net signal is connected to less then two component
+  // signals.
+  if (net.realComponentSignalCount < 2) {
+    msgs.append(std::make_shared<ErcMsgOpenNet>(net.uuid, net.name));
+  }
+}
+
+void ElectricalRuleCheck::checkComponent(const ComponentData& cmp,
+                                         RuleCheckMessageList& msgs) {
+  foreach (const ComponentSignalData& sig, cmp.componentSignals) {
+    // Check for forced net name conflict.
+    if (sig.required && (!sig.hasNet)) {
+      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(
+          cmp.uuid, cmp.name, sig.uuid, sig.name));
+    } else if (sig.netNameForced && (sig.forcedNetName != sig.netName)) {
+      msgs.append(std::make_shared<ErcMsgForcedNetSignalNameConflict>(
+          cmp.uuid, cmp.name, sig.uuid, sig.name, sig.netName,
+          sig.forcedNetName));
+    }
+  }
+
+  // Check for unplaced gates.
+  foreach (const GateData& gate, cmp.gates) {
+    if (!gate.placed) {
+      if (gate.required) {
+        msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(
+            cmp.uuid, cmp.name, gate.uuid, gate.suffix));
+      } else {
+        msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(
+            cmp.uuid, cmp.name, gate.uuid, gate.suffix));
+      }
     }
   }
 }
 
-void ElectricalRuleCheck::checkNetSegments(const Schematic& schematic,
-                                           RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetSegment* netSegment, schematic.getNetSegments()) {
-    checkNetPoints(*netSegment, msgs);
+void ElectricalRuleCheck::checkSchematic(const SchematicData& schematic,
+                                         const QSet<Uuid>& openNetSignals,
+                                         RuleCheckMessageList& msgs) {
+  foreach (const SymbolData& symbol, schematic.symbols) {
+    foreach (const PinData& pin, symbol.pins) {
+      if ((!pin.hasNetLines) && pin.hasNet) {
+        msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(
+            schematic.uuid, symbol.uuid, symbol.getName(), pin.uuid, pin.name));
+      }
+    }
+  }
+
+  foreach (const NetSegmentData& netSegment, schematic.netSegments) {
+    foreach (const NetPointData& netPoint, netSegment.netPoints) {
+      if (!netPoint.hasNetLines) {
+        msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(
+            schematic.uuid, netSegment.uuid, netPoint.uuid,
+            netSegment.netName));
+      }
+    }
 
     // If there are no net labels, check for any open wire. But only if there's
     // no "open net" warning on the net raised, since this would be quite a
     // duplicate warning.
-    if (netSegment->getNetLabels().isEmpty() &&
-        (!mOpenNetSignals.contains(&netSegment->getNetSignal()))) {
-      foreach (const SI_NetLine* netLine, netSegment->getNetLines()) {
-        if (netLine->getStartPoint().isOpen() ||
-            netLine->getEndPoint().isOpen()) {
-          msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(*netSegment));
-          break;
-        }
-      }
+    if ((!netSegment.hasNetLabels) && netSegment.hasOpenWire &&
+        (!openNetSignals.contains(netSegment.netSignal))) {
+      msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(
+          netSegment.uuid, netSegment.netName));
     }
   }
 }
 
-void ElectricalRuleCheck::checkNetPoints(const SI_NetSegment& netSegment,
-                                         RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetPoint* netPoint, netSegment.getNetPoints()) {
-    if (netPoint->getNetLines().isEmpty()) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(*netPoint));
+bool ElectricalRuleCheck::hasOpenNetsChanged(
+    const SchematicData& schematic, const QSet<Uuid>& openNetSignals,
+    const QSet<Uuid>& previousOpenNetSignals) {
+  foreach (const NetSegmentData& netSegment, schematic.netSegments) {
+    if (openNetSignals.contains(netSegment.netSignal) !=
+        previousOpenNetSignals.contains(netSegment.netSignal)) {
+      return true;
     }
   }
+  return false;
 }
 
 /*******************************************************************************
@@ -24,19 +24,21 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "../../types/uuid.h"
 
 #include <QtCore>
 
+#include <atomic>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
 class ComponentInstance;
-class NetSignal;
 class Project;
 class SI_NetSegment;
-class SI_Symbol;
 class Schematic;
 
 /*******************************************************************************
@@ -44,11 +46,117 @@ class Schematic;
  ******************************************************************************/
 
 /**
- * @brief The ElectricalRuleCheck class checks a ::librepcb::Board for
- *        design rule violations
+ * @brief The ElectricalRuleCheck class checks a ::librepcb::Project for
+ *        electrical rule violations
+ *
+ * The check is split into two steps: First an immutable snapshot of all the
+ * data relevant for the checks is created with #createSnapshot(), which has
+ * to be done in the thread owning the project. Then the snapshot is checked
+ * with #run(), which does not access the project at all and thus can be
+ * called from any thread.
+ *
+ * If the result of a previous run is passed to #run(), the messages of all
+ * net signals, components and schematics which did not change since then are
+ * taken over instead of checking them again.
  */
 class ElectricalRuleCheck final {
 public:
+  // Types
+  struct NetClassData {
+    Uuid uuid;
+    QString name;
+    bool used;
+  };
+  struct NetSignalData {
+    Uuid uuid;
+    QString name;
+    int realComponentSignalCount;  ///< Excluding schematic-only components
+
+    bool operator==(const NetSignalData& rhs) const noexcept;
+  };
+  struct ComponentSignalData {
+    Uuid uuid;
+    QString name;
+    bool required;
+    bool hasNet;
+    QString netName;
+    bool netNameForced;
+    QString forcedNetName;  ///< Only set if #netNameForced is true
+
+    bool operator==(const ComponentSignalData& rhs) const noexcept;
+  };
+  struct GateData {
+    Uuid uuid;
+    QString suffix;
+    bool required;
+    bool placed;
+
+    bool operator==(const GateData& rhs) const noexcept;
+  };
+  struct ComponentData {
+    Uuid uuid;
+    QString name;
+    QVector<ComponentSignalData> componentSignals;
+    QVector<GateData> gates;
+
+    bool operator==(const ComponentData& rhs) const noexcept;
+  };
+  struct PinData {
+    Uuid uuid;  ///< Library pin UUID
+    QString name;
+    bool hasNetLines;
+    bool hasNet;
+
+    bool operator==(const PinData& rhs) const noexcept;
+  };
+  struct SymbolData {
+    Uuid uuid;
+    QString componentName;
+    QString suffix;  ///< Gate suffix, may be empty
+    QVector<PinData> pins;
+
+    QString getName() const noexcept;
+    bool operator==(const SymbolData& rhs) const noexcept;
+  };
+  struct NetPointData {
+    Uuid uuid;
+    bool hasNetLines;
+
+    bool operator==(const NetPointData& rhs) const noexcept;
+  };
+  struct NetSegmentData {
+    Uuid uuid;
+    Uuid netSignal;
+    QString netName;
+    bool hasNetLabels;
+    bool hasOpenWire;
+    QVector<NetPointData> netPoints;
+
+    bool operator==(const NetSegmentData& rhs) const noexcept;
+  };
+  struct SchematicData {
+    Uuid uuid;
+    QVector<SymbolData> symbols;
+    QVector<NetSegmentData> netSegments;
+
+    bool operator==(const SchematicData& rhs) const noexcept;
+  };
+  struct Data {
+    QVector<NetClassData> netClasses;
+    QVector<NetSignalData> netSignals;
+    QVector<ComponentData> components;
+    QVector<SchematicData> schematics;
+  };
+  struct Result {
+    std::shared_ptr<const Data> data;
+    QSet<Uuid> openNetSignals;
+    QVector<RuleCheckMessageList> netSignalMessages;
+    QVector<RuleCheckMessageList> componentMessages;
+    QVector<RuleCheckMessageList> schematicMessages;
+    RuleCheckMessageList messages;  ///< All messages, in check order
+    int checkedObjects;  ///< Number of objects not taken over from previous
+  };
+
   // Constructors / Destructor
   explicit ElectricalRuleCheck(const Project& project) noexcept;
   ~ElectricalRuleCheck() noexcept;
@@ -56,24 +164,53 @@ public:
   // General Methods
   RuleCheckMessageList runChecks() const;
 
+  // Static Methods
+
+  /**
+   * @brief Create a snapshot of all data relevant for the checks
+   *
+   * @param project   The project to take the snapshot from.
+   *
+   * @return The snapshot, to be passed to #run().
+   */
+  static std::shared_ptr<const Data> createSnapshot(const Project& project);
+
+  /**
+   * @brief Check a snapshot
+   *
+   * @note This method is thread-safe.
+   *
+   * @param data      The snapshot to check.
+   * @param previous  Result of a previous run used to skip checking unchanged
+   *                  objects, or `nullptr` to check everything.
+   * @param abort     If not `nullptr`, the check is aborted as soon as this
+   *                  flag gets set.
+   *
+   * @return The result, or `nullptr` if aborted.
+   */
+  static std::shared_ptr<const Result> run(
+      std::shared_ptr<const Data> data, std::shared_ptr<const Result> previous,
+      const std::atomic<bool>* abort = nullptr) noexcept;
+
 private:  // Methods
-  void checkNetClasses(RuleCheckMessageList& msgs) const;
-  void checkNetSignals(RuleCheckMessageList& msgs) const;
-  void checkComponents(RuleCheckMessageList& msgs) const;
-  void checkComponentSignals(const ComponentInstance& cmp,
-                             RuleCheckMessageList& msgs) const;
-  void checkSchematics(RuleCheckMessageList& msgs) const;
-  void checkSymbols(const Schematic& schematic,
-                    RuleCheckMessageList& msgs) const;
-  void checkPins(const SI_Symbol& symbol, RuleCheckMessageList& msgs) const;
-  void checkNetSegments(const Schematic& schematic,
-                        RuleCheckMessageList& msgs) const;
-  void checkNetPoints(const SI_NetSegment& netSegment,
-                      RuleCheckMessageList& msgs) const;
+  static ComponentData createComponentSnapshot(const ComponentInstance& cmp);
+  static SchematicData createSchematicSnapshot(const Schematic& schematic);
+  static NetSegmentData createNetSegmentSnapshot(
+      const SI_NetSegment& netSegment);
+  static void checkNetClasses(const Data& data, RuleCheckMessageList& msgs);
+  static void checkNetSignal(const NetSignalData& net,
+                             RuleCheckMessageList& msgs);
+  static void checkComponent(const ComponentData& cmp,
+                             RuleCheckMessageList& msgs);
+  static void checkSchematic(const SchematicData& schematic,
+                             const QSet<Uuid>& openNetSignals,
+                             RuleCheckMessageList& msgs);
+  static bool hasOpenNetsChanged(const SchematicData& schematic,
+                                 const QSet<Uuid>& openNetSignals,
+                                 const QSet<Uuid>& previousOpenNetSignals);
 
 private:  // Data
   const Project& mProject;
-  mutable QSet<const NetSignal*> mOpenNetSignals;
 };
 
 /*******************************************************************************
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "../../types/uuid.h"
 
 #include <QtCore>
 
@@ -32,15 +33,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class ComponentSignalInstance;
-class ComponentSymbolVariantItem;
-class NetClass;
-class NetSignal;
-class SI_NetPoint;
-class SI_NetSegment;
-class SI_SymbolPin;
-
 /*******************************************************************************
  *  Class ErcMsgUnusedNetClass
  ******************************************************************************/
@@ -54,7 +46,7 @@ class ErcMsgUnusedNetClass final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnusedNetClass() = delete;
-  explicit ErcMsgUnusedNetClass(const NetClass& netClass) noexcept;
+  ErcMsgUnusedNetClass(const Uuid& netClass, const QString& name) noexcept;
   ErcMsgUnusedNetClass(const ErcMsgUnusedNetClass& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnusedNetClass() noexcept {}
@@ -73,7 +65,7 @@ class ErcMsgOpenNet final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgOpenNet() = delete;
-  explicit ErcMsgOpenNet(const NetSignal& net) noexcept;
+  ErcMsgOpenNet(const Uuid& net, const QString& name) noexcept;
   ErcMsgOpenNet(const ErcMsgOpenNet& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgOpenNet() noexcept {}
@@ -92,7 +84,8 @@ class ErcMsgOpenWireInSegment final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgOpenWireInSegment() = delete;
-  explicit ErcMsgOpenWireInSegment(const SI_NetSegment& segment) noexcept;
+  ErcMsgOpenWireInSegment(const Uuid& segment,
+                          const QString& netName) noexcept;
   ErcMsgOpenWireInSegment(const ErcMsgOpenWireInSegment& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgOpenWireInSegment() noexcept {}
@@ -111,8 +104,10 @@ class ErcMsgUnconnectedRequiredSignal final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnconnectedRequiredSignal() = delete;
-  explicit ErcMsgUnconnectedRequiredSignal(
-      const ComponentSignalInstance& signal) noexcept;
+  ErcMsgUnconnectedRequiredSignal(const Uuid& component,
+                                  const QString& componentName,
+                                  const Uuid& signal,
+                                  const QString& signalName) noexcept;
   ErcMsgUnconnectedRequiredSignal(
       const ErcMsgUnconnectedRequiredSignal& other) noexcept
     : RuleCheckMessage(other) {}
@@ -132,15 +127,16 @@ class ErcMsgForcedNetSignalNameConflict final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgForcedNetSignalNameConflict() = delete;
-  explicit ErcMsgForcedNetSignalNameConflict(
-      const ComponentSignalInstance& signal) noexcept;
+  ErcMsgForcedNetSignalNameConflict(const Uuid& component,
+                                    const QString& componentName,
+                                    const Uuid& signal,
+                                    const QString& signalName,
+                                    const QString& netName,
+                                    const QString& forcedNetName) noexcept;
   ErcMsgForcedNetSignalNameConflict(
       const ErcMsgForcedNetSignalNameConflict& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgForcedNetSignalNameConflict() noexcept {}
-
-private:
-  static QString getSignalNet(const ComponentSignalInstance& signal) noexcept;
 };
 
 /*******************************************************************************
@@ -156,9 +152,9 @@ class ErcMsgUnplacedRequiredGate final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnplacedRequiredGate() = delete;
-  explicit ErcMsgUnplacedRequiredGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+  ErcMsgUnplacedRequiredGate(const Uuid& component,
+                             const QString& componentName, const Uuid& gate,
+                             const QString& gateSuffix) noexcept;
   ErcMsgUnplacedRequiredGate(const ErcMsgUnplacedRequiredGate& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnplacedRequiredGate() noexcept {}
@@ -177,9 +173,9 @@ class ErcMsgUnplacedOptionalGate final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnplacedOptionalGate() = delete;
-  explicit ErcMsgUnplacedOptionalGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+  ErcMsgUnplacedOptionalGate(const Uuid& component,
+                             const QString& componentName, const Uuid& gate,
+                             const QString& gateSuffix) noexcept;
   ErcMsgUnplacedOptionalGate(const ErcMsgUnplacedOptionalGate& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnplacedOptionalGate() noexcept {}
@@ -198,7 +194,9 @@ class ErcMsgConnectedPinWithoutWire final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgConnectedPinWithoutWire() = delete;
-  explicit ErcMsgConnectedPinWithoutWire(const SI_SymbolPin& pin) noexcept;
+  ErcMsgConnectedPinWithoutWire(const Uuid& schematic, const Uuid& symbol,
+                                const QString& symbolName, const Uuid& pin,
+                                const QString& pinName) noexcept;
   ErcMsgConnectedPinWithoutWire(
       const ErcMsgConnectedPinWithoutWire& other) noexcept
     : RuleCheckMessage(other) {}
@@ -218,7 +216,9 @@ class ErcMsgUnconnectedJunction final : public RuleCheckMessage {
 public:
   // Constructors / Destructor
   ErcMsgUnconnectedJunction() = delete;
-  explicit ErcMsgUnconnectedJunction(const SI_NetPoint& netPoint) noexcept;
+  ErcMsgUnconnectedJunction(const Uuid& schematic, const Uuid& segment,
+                            const Uuid& junction,
+                            const QString& netName) noexcept;
   ErcMsgUnconnectedJunction(const ErcMsgUnconnectedJunction& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnconnectedJunction() noexcept {}
@@ -0,0 +1,145 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "projectbackgrounderc.h"
+
+#include "../project.h"
+
+#include <QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ProjectBackgroundErc::ProjectBackgroundErc(QObject* parent) noexcept
+  : QObject(parent),
+    mFuture(),
+    mWatcher(),
+    mPreviousResult(),
+    mGeneration(0),
+    mJobGeneration(0),
+    mJobPending(false),
+    mAbort(false) {
+  connect(&mWatcher, &QFutureWatcherBase::finished, this,
+          &ProjectBackgroundErc::jobFinished, Qt::QueuedConnection);
+}
+
+ProjectBackgroundErc::~ProjectBackgroundErc() noexcept {
+  cancel();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void ProjectBackgroundErc::start(const Project& project) {
+  cancel();
+
+  // The snapshot has to be taken in this thread, checking it is thread-safe.
+  std::shared_ptr<const ElectricalRuleCheck::Data> data =
+      ElectricalRuleCheck::createSnapshot(project);  // can throw
+  mJobGeneration = mGeneration;
+  mFuture = QtConcurrent::run(this, &ProjectBackgroundErc::run, data,
+                              mPreviousResult);
+  mWatcher.setFuture(mFuture);
+  mJobPending = true;
+}
+
+bool ProjectBackgroundErc::isBusy() const noexcept {
+  return (mFuture.isStarted() || mFuture.isRunning()) &&
+      (!mFuture.isFinished()) && (!mFuture.isCanceled());
+}
+
+void ProjectBackgroundErc::invalidate() noexcept {
+  ++mGeneration;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<const ProjectBackgroundErc::Result> ProjectBackgroundErc::run(
+    std::shared_ptr<const ElectricalRuleCheck::Data> data,
+    std::shared_ptr<const Result> previous) noexcept {
+  // Note: This method is called from a different thread, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+  QElapsedTimer timer;
+  timer.start();
+  std::shared_ptr<const Result> result =
+      ElectricalRuleCheck::run(data, previous, &mAbort);
+  if (result) {
+    qDebug() << "Checked" << result->checkedObjects
+             << "modified object(s) of the project in" << timer.elapsed()
+             << "ms.";
+  }
+  return result;
+}
+
+void ProjectBackgroundErc::jobFinished() noexcept {
+  // A queued signal of a previous job may arrive after #start() has already
+  // replaced the future, so ignore it unless the current job is really done.
+  // Otherwise result() would block until the new job is finished and the
+  // messages would be reported twice.
+  if ((!mJobPending) || (!mFuture.isFinished())) {
+    return;
+  }
+  mJobPending = false;
+
+  std::shared_ptr<const Result> result = mFuture.result();
+  if (!result) {
+    return;  // Aborted.
+  }
+  mPreviousResult = result;
+
+  // Results of outdated snapshots are not reported, the owner will start
+  // another run anyway.
+  if (mJobGeneration == mGeneration) {
+    emit messagesUpdated(result->messages);
+  }
+}
+
+void ProjectBackgroundErc::cancel() noexcept {
+  mAbort = true;
+  mFuture.waitForFinished();
+  mAbort = false;
+
+  // Keep the result of a job which completed before it got aborted, to
+  // still benefit from it in the next run.
+  if (mJobPending) {
+    mJobPending = false;
+    if (std::shared_ptr<const Result> result = mFuture.result()) {
+      mPreviousResult = result;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,127 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_PROJECTBACKGROUNDERC_H
+#define LIBREPCB_CORE_PROJECTBACKGROUNDERC_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../rulecheck/rulecheckmessage.h"
+#include "electricalrulecheck.h"
+
+#include <QtCore>
+
+#include <atomic>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Project;
+
+/*******************************************************************************
+ *  Class ProjectBackgroundErc
+ ******************************************************************************/
+
+/**
+ * @brief Non-blocking, incremental electrical rule check of a
+ *        ::librepcb::Project
+ *
+ * Takes a snapshot of the project (see
+ * ::librepcb::ElectricalRuleCheck::createSnapshot()) and checks it in a worker
+ * thread. The result of the previous run is remembered, so only net signals,
+ * components and schematics which were modified since then are checked again.
+ *
+ * As the messages do not reference any project items, they can be reported
+ * even if the project was modified in the meantime. But they are outdated in
+ * that case, thus the owner should call #invalidate() whenever the project
+ * gets modified to discard results of running checks, and start the check
+ * again later.
+ */
+class ProjectBackgroundErc final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  explicit ProjectBackgroundErc(QObject* parent = nullptr) noexcept;
+  ProjectBackgroundErc(const ProjectBackgroundErc& other) = delete;
+  ~ProjectBackgroundErc() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Start checking a project asynchronously
+   *
+   * @param project   The project to check.
+   *
+   * @throws Exception if the snapshot could not be created.
+   */
+  void start(const Project& project);
+
+  /**
+   * @brief Check if there is currently a check in progress
+   *
+   * @retval true if a check is in progress.
+   * @retval false if idle.
+   */
+  bool isBusy() const noexcept;
+
+  /**
+   * @brief Notify that the project was modified
+   *
+   * Results of currently running checks will be discarded.
+   */
+  void invalidate() noexcept;
+
+  // Operator Overloadings
+  ProjectBackgroundErc& operator=(const ProjectBackgroundErc& rhs) = delete;
+
+signals:
+  void messagesUpdated(const RuleCheckMessageList& messages);
+
+private:  // Types
+  typedef ElectricalRuleCheck::Result Result;
+
+private:  // Methods
+  std::shared_ptr<const Result> run(
+      std::shared_ptr<const ElectricalRuleCheck::Data> data,
+      std::shared_ptr<const Result> previous) noexcept;
+  void jobFinished() noexcept;
+  void cancel() noexcept;
+
+private:  // Data
+  QFuture<std::shared_ptr<const Result>> mFuture;
+  QFutureWatcher<std::shared_ptr<const Result>> mWatcher;
+  std::shared_ptr<const Result> mPreviousResult;  ///< Last finished job
+  int mGeneration;  ///< Incremented on every project modification
+  int mJobGeneration;  ///< Generation of the running job
+  bool mJobPending;  ///< Whether the result of #mFuture is not handled yet
+  std::atomic<bool> mAbort;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -462,6 +462,16 @@ void ProjectLoader::loadSchematicSymbol(Schematic& s, const SExpression& node) {
 
 void ProjectLoader::loadSchematicNetSegment(Schematic& s,
                                             const SExpression& node) {
+  // Note: Precompiled paths since net segments contain most of the items.
+  static const SExpression::ChildPath uuidPath("@0");
+  static const SExpression::ChildPath positionPath("position");
+  static const SExpression::ChildPath junctionPath("junction");
+  static const SExpression::ChildPath symbolPath("symbol/@0");
+  static const SExpression::ChildPath pinPath("pin/@0");
+  static const SExpression::ChildPath fromPath("from");
+  static const SExpression::ChildPath toPath("to");
+  static const SExpression::ChildPath widthPath("width/@0");
+
   const Uuid netSignalUuid = deserialize<Uuid>(node.getChild("net/@0"));
   NetSignal* netSignal =
       s.getProject().getCircuit().getNetSignals().value(netSignalUuid);
@@ -470,33 +480,32 @@ void ProjectLoader::loadSchematicNetSegment(Schematic& s,
         __FILE__, __LINE__,
         QString("Inexistent net signal: '%1'").arg(netSignalUuid.toStr()));
   }
-  SI_NetSegment* netSegment =
-      new SI_NetSegment(s, deserialize<Uuid>(node.getChild("@0")), *netSignal);
+  SI_NetSegment* netSegment = new SI_NetSegment(
+      s, deserialize<Uuid>(node.getChild(uuidPath)), *netSignal);
   s.addNetSegment(*netSegment);
 
   // Load net points.
   QList<SI_NetPoint*> netPoints;
+  QHash<Uuid, SI_NetPoint*> netPointsByUuid;
   foreach (const SExpression* child, node.getChildren("junction")) {
-    SI_NetPoint* netpoint =
-        new SI_NetPoint(*netSegment, deserialize<Uuid>(child->getChild("@0")),
-                        Point(child->getChild("position")));
+    SI_NetPoint* netpoint = new SI_NetPoint(
+        *netSegment, deserialize<Uuid>(child->getChild(uuidPath)),
+        Point(child->getChild(positionPath)));
     netPoints.append(netpoint);
+    if (!netPointsByUuid.contains(netpoint->getUuid())) {
+      netPointsByUuid.insert(netpoint->getUuid(), netpoint);
+    }
   }
 
   // Load net lines.
   QList<SI_NetLine*> netLines;
   foreach (const SExpression* child, node.getChildren("line")) {
-    auto parseAnchor = [&s, &netPoints](const SExpression& aNode) {
+    auto parseAnchor = [&s, &netPointsByUuid](const SExpression& aNode) {
       SI_NetLineAnchor* anchor = nullptr;
-      if (const SExpression* junctionNode = aNode.tryGetChild("junction")) {
+      if (const SExpression* junctionNode = aNode.tryGetChild(junctionPath)) {
         const Uuid netPointUuid =
-            deserialize<Uuid>(junctionNode->getChild("@0"));
-        foreach (SI_NetPoint* netPoint, netPoints) {
-          if (netPoint->getUuid() == netPointUuid) {
-            anchor = netPoint;
-            break;
-          }
-        }
+            deserialize<Uuid>(junctionNode->getChild(uuidPath));
+        anchor = netPointsByUuid.value(netPointUuid);
         if (!anchor) {
           throw RuntimeError(
               __FILE__, __LINE__,
@@ -504,14 +513,14 @@ void ProjectLoader::loadSchematicNetSegment(Schematic& s,
                   .arg(netPointUuid.toStr()));
         }
       } else {
-        const Uuid symbolUuid = deserialize<Uuid>(aNode.getChild("symbol/@0"));
+        const Uuid symbolUuid = deserialize<Uuid>(aNode.getChild(symbolPath));
         SI_Symbol* symbol = s.getSymbols().value(symbolUuid);
         if (!symbol) {
           throw RuntimeError(__FILE__, __LINE__,
                              QString("Symbol '%1' does not exist in schematic.")
                                  .arg(symbolUuid.toStr()));
         }
-        const Uuid pinUuid = deserialize<Uuid>(aNode.getChild("pin/@0"));
+        const Uuid pinUuid = deserialize<Uuid>(aNode.getChild(pinPath));
         anchor = symbol->getPin(pinUuid);
         if (!anchor) {
           throw RuntimeError(
@@ -523,10 +532,10 @@ void ProjectLoader::loadSchematicNetSegment(Schematic& s,
       return anchor;
     };
     SI_NetLine* netLine = new SI_NetLine(
-        *netSegment, deserialize<Uuid>(child->getChild("@0")),
-        *parseAnchor(child->getChild("from")),
-        *parseAnchor(child->getChild("to")),
-        deserialize<UnsignedLength>(child->getChild("width/@0")));
+        *netSegment, deserialize<Uuid>(child->getChild(uuidPath)),
+        *parseAnchor(child->getChild(fromPath)),
+        *parseAnchor(child->getChild(toPath)),
+        deserialize<UnsignedLength>(child->getChild(widthPath)));
     netLines.append(netLine);
   }
 
@@ -673,6 +682,18 @@ void ProjectLoader::loadBoardDeviceInstance(Board& b, const SExpression& node) {
 }
 
 void ProjectLoader::loadBoardNetSegment(Board& b, const SExpression& node) {
+  // Note: Precompiled paths since net segments contain most of the items.
+  static const SExpression::ChildPath uuidPath("@0");
+  static const SExpression::ChildPath positionPath("position");
+  static const SExpression::ChildPath junctionPath("junction");
+  static const SExpression::ChildPath viaPath("via");
+  static const SExpression::ChildPath devicePath("device/@0");
+  static const SExpression::ChildPath padPath("pad/@0");
+  static const SExpression::ChildPath fromPath("from");
+  static const SExpression::ChildPath toPath("to");
+  static const SExpression::ChildPath layerPath("layer/@0");
+  static const SExpression::ChildPath widthPath("width/@0");
+
   const tl::optional<Uuid> netSignalUuid =
       deserialize<tl::optional<Uuid>>(node.getChild("net/@0"));
   NetSignal* netSignal = netSignalUuid
@@ -683,61 +704,60 @@ void ProjectLoader::loadBoardNetSegment(Board& b, const SExpression& node) {
         __FILE__, __LINE__,
         QString("Inexistent net signal: '%1'").arg(netSignalUuid->toStr()));
   }
-  BI_NetSegment* netSegment =
-      new BI_NetSegment(b, deserialize<Uuid>(node.getChild("@0")), netSignal);
+  BI_NetSegment* netSegment = new BI_NetSegment(
+      b, deserialize<Uuid>(node.getChild(uuidPath)), netSignal);
   b.addNetSegment(*netSegment);
 
   // Load vias.
   QList<BI_Via*> vias;
+  QHash<Uuid, BI_Via*> viasByUuid;
   foreach (const SExpression* child, node.getChildren("via")) {
     BI_Via* via = new BI_Via(*netSegment, Via(*child));
     vias.append(via);
+    if (!viasByUuid.contains(via->getUuid())) {
+      viasByUuid.insert(via->getUuid(), via);
+    }
   }
 
   // Load net points.
   QList<BI_NetPoint*> netPoints;
+  QHash<Uuid, BI_NetPoint*> netPointsByUuid;
   foreach (const SExpression* child, node.getChildren("junction")) {
-    BI_NetPoint* netPoint =
-        new BI_NetPoint(*netSegment, deserialize<Uuid>(child->getChild("@0")),
-                        Point(child->getChild("position")));
+    BI_NetPoint* netPoint = new BI_NetPoint(
+        *netSegment, deserialize<Uuid>(child->getChild(uuidPath)),
+        Point(child->getChild(positionPath)));
     netPoints.append(netPoint);
+    if (!netPointsByUuid.contains(netPoint->getUuid())) {
+      netPointsByUuid.insert(netPoint->getUuid(), netPoint);
+    }
   }
 
   // Load net lines.
   QList<BI_NetLine*> netLines;
   foreach (const SExpression* child, node.getChildren("trace")) {
-    auto parseAnchor = [&b, &vias, &netPoints](const SExpression& aNode) {
+    auto parseAnchor = [&b, &viasByUuid,
+                        &netPointsByUuid](const SExpression& aNode) {
       BI_NetLineAnchor* anchor = nullptr;
-      if (const SExpression* junctionNode = aNode.tryGetChild("junction")) {
+      if (const SExpression* junctionNode = aNode.tryGetChild(junctionPath)) {
         const Uuid netPointUuid =
-            deserialize<Uuid>(junctionNode->getChild("@0"));
-        foreach (BI_NetPoint* netPoint, netPoints) {
-          if (netPoint->getUuid() == netPointUuid) {
-            anchor = netPoint;
-            break;
-          }
-        }
+            deserialize<Uuid>(junctionNode->getChild(uuidPath));
+        anchor = netPointsByUuid.value(netPointUuid);
         if (!anchor) {
           throw RuntimeError(
               __FILE__, __LINE__,
               QString("Net point '%1' does not exist in schematic.")
                   .arg(netPointUuid.toStr()));
         }
-      } else if (const SExpression* viaNode = aNode.tryGetChild("via")) {
-        const Uuid viaUuid = deserialize<Uuid>(viaNode->getChild("@0"));
-        foreach (BI_Via* via, vias) {
-          if (via->getUuid() == viaUuid) {
-            anchor = via;
-            break;
-          }
-        }
+      } else if (const SExpression* viaNode = aNode.tryGetChild(viaPath)) {
+        const Uuid viaUuid = deserialize<Uuid>(viaNode->getChild(uuidPath));
+        anchor = viasByUuid.value(viaUuid);
         if (!anchor) {
           throw RuntimeError(__FILE__, __LINE__,
                              QString("Via '%1' does not exist in board.")
                                  .arg(viaUuid.toStr()));
         }
       } else {
-        const Uuid deviceUuid = deserialize<Uuid>(aNode.getChild("device/@0"));
+        const Uuid deviceUuid = deserialize<Uuid>(aNode.getChild(devicePath));
         BI_Device* device = b.getDeviceInstanceByComponentUuid(deviceUuid);
         if (!device) {
           throw RuntimeError(
@@ -745,7 +765,7 @@ void ProjectLoader::loadBoardNetSegment(Board& b, const SExpression& node) {
               QString("Device instance '%1' does not exist in board.")
                   .arg(deviceUuid.toStr()));
         }
-        const Uuid padUuid = deserialize<Uuid>(aNode.getChild("pad/@0"));
+        const Uuid padUuid = deserialize<Uuid>(aNode.getChild(padPath));
         anchor = device->getPad(padUuid);
         if (!anchor) {
           throw RuntimeError(
@@ -757,11 +777,11 @@ void ProjectLoader::loadBoardNetSegment(Board& b, const SExpression& node) {
       return anchor;
     };
     BI_NetLine* netLine = new BI_NetLine(
-        *netSegment, deserialize<Uuid>(child->getChild("@0")),
-        *parseAnchor(child->getChild("from")),
-        *parseAnchor(child->getChild("to")),
-        deserialize<const Layer&>(child->getChild("layer/@0")),
-        deserialize<PositiveLength>(child->getChild("width/@0")));
+        *netSegment, deserialize<Uuid>(child->getChild(uuidPath)),
+        *parseAnchor(child->getChild(fromPath)),
+        *parseAnchor(child->getChild(toPath)),
+        deserialize<const Layer&>(child->getChild(layerPath)),
+        deserialize<PositiveLength>(child->getChild(widthPath)));
     netLines.append(netLine);
   }
 
@@ -813,11 +833,21 @@ void ProjectLoader::loadBoardUserSettings(Board& b) {
     }
     b.setLayersVisibility(layersVisibility);
 
-    // Planes visibility.
+    // Planes visibility & cached fragments.
     foreach (const SExpression* node, root.getChildren("plane")) {
       const Uuid uuid = deserialize<Uuid>(node->getChild("@0"));
       if (BI_Plane* plane = b.getPlanes().value(uuid)) {
         plane->setVisible(deserialize<bool>(node->getChild("visible/@0")));
+        if (const SExpression* fragmentsNode = node->tryGetChild("fragments")) {
+          const QByteArray hash = QByteArray::fromHex(
+              fragmentsNode->getChild("@0").getValue().toLatin1());
+          QVector<Path> fragments;
+          foreach (const SExpression* child,
+                   fragmentsNode->getChildren("fragment")) {
+            fragments.append(Path(*child));
+          }
+          plane->setCalculatedFragments(fragments, hash);
+        }
       } else {
         qWarning() << "Plane" << uuid.toStr()
                    << "doesn't exist, could not restore its visibility.";
@@ -34,6 +34,12 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Static Variables
+ ******************************************************************************/
+
+std::atomic<quint64> SExpression::sIndexGeneration(0);
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -49,12 +55,28 @@ SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
+    mFilePath(other.mFilePath),
+    mIndex(std::atomic_load(&other.mIndex)) {
 }
 
 SExpression::~SExpression() noexcept {
 }
 
+SExpression::ChildPath::ChildPath(const QString& path) noexcept
+  : mPath(path), mElements() {
+  foreach (const QString& name, path.split('/')) {
+    bool valid = false;
+    const int index = name.startsWith('@') ? name.mid(1).toInt(&valid) : -1;
+    if (valid && (index >= 0)) {
+      mElements.append(Element{QString(), index});
+    } else {
+      // Note: Invalid indices are kept as names, which never match since
+      // '@' is not allowed in list names.
+      mElements.append(Element{name, -1});
+    }
+  }
+}
+
 /*******************************************************************************
  *  Getters
  ******************************************************************************/
@@ -98,9 +120,15 @@ QList<const SExpression*> SExpression::getChildren(Type type) const noexcept {
 
 QList<SExpression*> SExpression::getChildren(const QString& name) noexcept {
   QList<SExpression*> children;
-  for (SExpression& child : mChildren) {
-    if (child.isList() && (child.mValue == name)) {
-      children.append(&child);
+  if (std::shared_ptr<const Index> index = getIndex()) {
+    foreach (int i, index->lists.value(name)) {
+      children.append(&mChildren[i]);  // Detaches implicitly shared children.
+    }
+  } else {
+    for (SExpression& child : mChildren) {
+      if (child.isList() && (child.mValue == name)) {
+        children.append(&child);
+      }
     }
   }
   return children;
@@ -109,9 +137,15 @@ QList<SExpression*> SExpression::getChildren(const QString& name) noexcept {
 QList<const SExpression*> SExpression::getChildren(
     const QString& name) const noexcept {
   QList<const SExpression*> children;
-  for (const SExpression& child : mChildren) {
-    if (child.isList() && (child.mValue == name)) {
-      children.append(&child);
+  if (std::shared_ptr<const Index> index = getIndex()) {
+    foreach (int i, index->lists.value(name)) {
+      children.append(&mChildren.at(i));
+    }
+  } else {
+    for (const SExpression& child : mChildren) {
+      if (child.isList() && (child.mValue == name)) {
+        children.append(&child);
+      }
     }
   }
   return children;
@@ -128,40 +162,105 @@ SExpression& SExpression::getChild(const QString& path) {
 }
 
 const SExpression& SExpression::getChild(const QString& path) const {
-  return const_cast<SExpression*>(this)->getChild(path);
+  const SExpression* child = tryGetChild(path);
+  if (child) {
+    return *child;
+  } else {
+    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+                         QString("Child not found: %1").arg(path));
+  }
+}
+
+SExpression& SExpression::getChild(const ChildPath& path) {
+  SExpression* child = tryGetChild(path);
+  if (child) {
+    return *child;
+  } else {
+    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+                         QString("Child not found: %1").arg(path.toString()));
+  }
+}
+
+const SExpression& SExpression::getChild(const ChildPath& path) const {
+  const SExpression* child = tryGetChild(path);
+  if (child) {
+    return *child;
+  } else {
+    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+                         QString("Child not found: %1").arg(path.toString()));
+  }
 }
 
 SExpression* SExpression::tryGetChild(const QString& path) noexcept {
+  // Note: The path is not split into a list to avoid memory allocations.
   SExpression* child = this;
-  foreach (const QString& name, path.split('/')) {
-    if (name.startsWith('@')) {
-      bool valid = false;
-      int index = name.mid(1).toInt(&valid);
-      if ((valid) && (index >= 0) && skipLineBreaks(child->mChildren, index)) {
-        child = &child->mChildren[index];
-      } else {
-        return nullptr;
-      }
-    } else {
-      bool found = false;
-      for (SExpression& childchild : child->mChildren) {
-        if (childchild.isList() && (childchild.mValue == name)) {
-          child = &childchild;
-          found = true;
-          break;
-        }
-      }
-      if (!found) {
-        return nullptr;
-      }
+  int start = 0;
+  while (true) {
+    int end = path.indexOf('/', start);
+    if (end < 0) {
+      end = path.length();
+    }
+    const int i = child->findChildIndex(path.midRef(start, end - start));
+    if (i < 0) {
+      return nullptr;
     }
+    child = &child->mChildren[i];  // Detaches implicitly shared children.
+    if (end >= path.length()) {
+      return child;
+    }
+    start = end + 1;
   }
-  return child;
 }
 
 const SExpression* SExpression::tryGetChild(
     const QString& path) const noexcept {
-  return const_cast<SExpression*>(this)->tryGetChild(path);
+  // Note: The path is not split into a list to avoid memory allocations.
+  const SExpression* child = this;
+  int start = 0;
+  while (true) {
+    int end = path.indexOf('/', start);
+    if (end < 0) {
+      end = path.length();
+    }
+    const int i = child->findChildIndex(path.midRef(start, end - start));
+    if (i < 0) {
+      return nullptr;
+    }
+    child = &child->mChildren.at(i);
+    if (end >= path.length()) {
+      return child;
+    }
+    start = end + 1;
+  }
+}
+
+SExpression* SExpression::tryGetChild(const ChildPath& path) noexcept {
+  SExpression* child = this;
+  for (const ChildPath::Element& element : path.mElements) {
+    const int i = (element.index >= 0)
+        ? child->findValueIndex(element.index)
+        : child->findListIndex(QStringRef(&element.name));
+    if (i < 0) {
+      return nullptr;
+    }
+    child = &child->mChildren[i];  // Detaches implicitly shared children.
+  }
+  return child;
+}
+
+const SExpression* SExpression::tryGetChild(
+    const ChildPath& path) const noexcept {
+  const SExpression* child = this;
+  for (const ChildPath::Element& element : path.mElements) {
+    const int i = (element.index >= 0)
+        ? child->findValueIndex(element.index)
+        : child->findListIndex(QStringRef(&element.name));
+    if (i < 0) {
+      return nullptr;
+    }
+    child = &child->mChildren.at(i);
+  }
+  return child;
 }
 
 /*******************************************************************************
@@ -170,7 +269,10 @@ const SExpression* SExpression::tryGetChild(
 
 void SExpression::setName(const QString& name) {
   if (mType == Type::List) {
-    mValue = name;
+    if (name != mValue) {
+      invalidateAllIndices();  // The index of the parent gets outdated.
+      mValue = name;
+    }
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -189,6 +291,7 @@ void SExpression::setValue(const QString& value) {
  ******************************************************************************/
 
 void SExpression::ensureLineBreak() {
+  invalidateIndex();
   if (mChildren.isEmpty() || (!mChildren.last().isLineBreak())) {
     mChildren.append(createLineBreak());
   }
@@ -200,6 +303,7 @@ SExpression& SExpression::appendList(const QString& name) {
 
 SExpression& SExpression::appendChild(const SExpression& child) {
   if (mType == Type::List) {
+    invalidateIndex();
     mChildren.append(child);
     return mChildren.last();
   } else {
@@ -210,6 +314,7 @@ SExpression& SExpression::appendChild(const SExpression& child) {
 void SExpression::removeChild(const SExpression& child) {
   for (int i = 0; i < mChildren.count(); ++i) {
     if (&mChildren.at(i) == &child) {
+      invalidateIndex();
       mChildren.removeAt(i);
       return;
     }
@@ -219,6 +324,7 @@ void SExpression::removeChild(const SExpression& child) {
 
 void SExpression::removeChildrenWithNodeRecursive(
     const SExpression& search) noexcept {
+  invalidateIndex();
   for (int i = mChildren.count() - 1; i >= 0; --i) {
     if (mChildren.at(i).mChildren.contains(search)) {
       mChildren.removeAt(i);
@@ -230,6 +336,7 @@ void SExpression::removeChildrenWithNodeRecursive(
 
 void SExpression::replaceRecursive(const SExpression& search,
                                    const SExpression& replace) noexcept {
+  invalidateIndex();
   for (SExpression& child : mChildren) {
     if (child == search) {
       child = replace;
@@ -274,10 +381,14 @@ bool SExpression::operator<(const SExpression& rhs) const noexcept {
 }
 
 SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
+  if ((rhs.mType != mType) || (isList() && (rhs.mValue != mValue))) {
+    invalidateAllIndices();  // The index of the parent gets outdated.
+  }
   mType = rhs.mType;
   mValue = rhs.mValue;
   mChildren = rhs.mChildren;
   mFilePath = rhs.mFilePath;
+  std::atomic_store(&mIndex, std::atomic_load(&rhs.mIndex));
   return *this;
 }
 
@@ -321,9 +432,14 @@ bool SExpression::isValidToken(const QString& token) noexcept {
 }
 
 bool SExpression::isValidTokenChar(const QChar& c) noexcept {
-  static QSet<QChar> allowedSpecialChars = {'\\', '.', ':', '_', '-'};
+  return (c.unicode() < 128) &&
+      isValidTokenChar(static_cast<char>(c.unicode()));
+}
+
+bool SExpression::isValidTokenChar(char c) noexcept {
   return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
-      ((c >= '0') && (c <= '9')) || allowedSpecialChars.contains(c);
+      ((c >= '0') && (c <= '9')) || (c == '\\') || (c == '.') || (c == ':') ||
+      (c == '_') || (c == '-');
 }
 
 QString SExpression::toString(int indent) const {
@@ -389,16 +505,22 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath& filePath) {
+  // Note: The content is parsed directly as UTF-8, without converting the
+  // whole file to a QString first. Only the values of the nodes are decoded,
+  // and values occurring several times are decoded only once.
+  StringCache cache;
   int index = 0;
-  QString contentStr = QString::fromUtf8(content);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index >= contentStr.length()) {
+  if (content.startsWith("\xEF\xBB\xBF")) {
+    index += 3;  // Skip UTF-8 byte order mark.
+  }
+  skipWhitespaceAndComments(content, index, true);  // Skip newlines as well.
+  if (index >= content.length()) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "No S-Expression node found.");
   }
-  SExpression root = parse(contentStr, index, filePath);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index < contentStr.length()) {
+  SExpression root = parse(content, index, filePath, cache);
+  skipWhitespaceAndComments(content, index, true);  // Skip newlines as well.
+  if (index < content.length()) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "File contains more than one root node.");
   }
@@ -422,20 +544,86 @@ bool SExpression::isMultiLine() const noexcept {
   return false;
 }
 
-bool SExpression::skipLineBreaks(const QList<SExpression>& children,
-                                 int& index) noexcept {
-  for (int i = 0; i < children.count(); ++i) {
-    if (children.at(i).isLineBreak()) {
-      ++index;
-    } else if (i == index) {
-      return true;
+std::shared_ptr<const SExpression::Index> SExpression::getIndex()
+    const noexcept {
+  // Small lists are faster to scan than to index.
+  static const int minChildCount = 16;
+  const quint64 generation = sIndexGeneration.load();
+  std::shared_ptr<const Index> index = std::atomic_load(&mIndex);
+  if (index && (index->generation != generation)) {
+    index.reset();  // Outdated since some node was renamed in the meantime.
+  }
+  if ((!index) && (mChildren.count() >= minChildCount)) {
+    std::shared_ptr<Index> newIndex = std::make_shared<Index>();
+    newIndex->generation = generation;
+    for (int i = 0; i < mChildren.count(); ++i) {
+      const SExpression& child = mChildren.at(i);
+      if (child.isList()) {
+        newIndex->lists[child.mValue].append(i);
+      }
+      if (!child.isLineBreak()) {
+        newIndex->values.append(i);
+      }
     }
+    // Note: If several threads build the index concurrently, they all build
+    // the same index, thus it doesn't matter which one is kept.
+    index = newIndex;
+    std::atomic_store(&mIndex, index);
   }
-  return false;
+  return index;
 }
 
-SExpression SExpression::parse(const QString& content, int& index,
-                               const FilePath& filePath) {
+void SExpression::invalidateIndex() noexcept {
+  std::atomic_store(&mIndex, std::shared_ptr<const Index>());
+}
+
+void SExpression::invalidateAllIndices() noexcept {
+  ++sIndexGeneration;
+}
+
+int SExpression::findListIndex(const QStringRef& name) const noexcept {
+  if (std::shared_ptr<const Index> index = getIndex()) {
+    const auto it = index->lists.find(name.toString());
+    return (it != index->lists.end()) ? it->first() : -1;
+  }
+  for (int i = 0; i < mChildren.count(); ++i) {
+    const SExpression& child = mChildren.at(i);
+    if (child.isList() && (child.mValue == name)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int SExpression::findValueIndex(int n) const noexcept {
+  if (std::shared_ptr<const Index> index = getIndex()) {
+    return (n < index->values.count()) ? index->values.at(n) : -1;
+  }
+  for (int i = 0; i < mChildren.count(); ++i) {
+    if (!mChildren.at(i).isLineBreak()) {
+      if (n == 0) {
+        return i;
+      }
+      --n;
+    }
+  }
+  return -1;
+}
+
+int SExpression::findChildIndex(const QStringRef& element) const noexcept {
+  if (element.startsWith('@')) {
+    bool valid = false;
+    const int n = QStringRef(element.string(), element.position() + 1,
+                             element.size() - 1)
+                      .toInt(&valid);
+    return (valid && (n >= 0)) ? findValueIndex(n) : -1;
+  } else {
+    return findListIndex(element);
+  }
+}
+
+SExpression SExpression::parse(const QByteArray& content, int& index,
+                               const FilePath& filePath, StringCache& cache) {
   Q_ASSERT(index < content.length());
 
   if (content.at(index) == '\n') {
@@ -443,21 +631,22 @@ SExpression SExpression::parse(const QString& content, int& index,
     skipWhitespaceAndComments(content, index);  // consume following spaces
     return createLineBreak();
   } else if (content.at(index) == '(') {
-    return parseList(content, index, filePath);
+    return parseList(content, index, filePath, cache);
   } else if (content.at(index) == '"') {
-    return createString(parseString(content, index, filePath));
+    return createString(parseString(content, index, filePath, cache));
   } else {
-    return createToken(parseToken(content, index, filePath));
+    return createToken(parseToken(content, index, filePath, cache));
   }
 }
 
-SExpression SExpression::parseList(const QString& content, int& index,
-                                   const FilePath& filePath) {
+SExpression SExpression::parseList(const QByteArray& content, int& index,
+                                   const FilePath& filePath,
+                                   StringCache& cache) {
   Q_ASSERT((index < content.length()) && (content.at(index) == '('));
 
   ++index;  // consume the '('
 
-  SExpression list = createList(parseToken(content, index, filePath));
+  SExpression list = createList(parseToken(content, index, filePath, cache));
 
   while (true) {
     if (index >= content.length()) {
@@ -469,69 +658,102 @@ SExpression SExpression::parseList(const QString& content, int& index,
       skipWhitespaceAndComments(content, index);  // consume following spaces
       break;
     } else {
-      list.appendChild(parse(content, index, filePath));
+      list.mChildren.append(parse(content, index, filePath, cache));
     }
   }
 
   return list;
 }
 
-QString SExpression::parseToken(const QString& content, int& index,
-                                const FilePath& filePath) {
-  int oldIndex = index;
+QString SExpression::parseToken(const QByteArray& content, int& index,
+                                const FilePath& filePath, StringCache& cache) {
+  const int oldIndex = index;
   while ((index < content.length()) && (isValidTokenChar(content.at(index)))) {
     ++index;
   }
-  QString token = content.mid(oldIndex, index - oldIndex);
-  if (token.isEmpty()) {
+  if (index == oldIndex) {
     throw FileParseError(
         __FILE__, __LINE__, filePath, -1, -1, QString(),
         QString("Invalid token character detected: '%1'")
-            .arg(index < content.length() ? content.at(index) : QChar()));
+            .arg(QString::fromUtf8(content.mid(index, 4)).left(1)));
   }
+  const QString token = decode(content, oldIndex, index - oldIndex, cache);
   skipWhitespaceAndComments(content, index);  // consume following spaces
   return token;
 }
 
-QString SExpression::parseString(const QString& content, int& index,
-                                 const FilePath& filePath) {
+QString SExpression::parseString(const QByteArray& content, int& index,
+                                 const FilePath& filePath,
+                                 StringCache& cache) {
   ++index;  // consume the '"'
 
+  // Fast path for strings without escape sequences (the most common case):
+  // They can be decoded directly from the content.
+  const int oldIndex = index;
+  while ((index < content.length()) && (content.at(index) != '"') &&
+         (content.at(index) != '\\')) {
+    ++index;
+  }
+  if (index >= content.length()) {
+    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+                         "String ended without quote.");
+  }
+  if (content.at(index) == '"') {
+    const QString string = decode(content, oldIndex, index - oldIndex, cache);
+    ++index;  // consume the '"'
+    skipWhitespaceAndComments(content, index);  // consume following spaces
+    return string;
+  }
+
   // Note: Until LibrePCB 0.1.5 we used the sexpresso library for escaping
   // strings. This library escaped more characters than we do now. To still
   // support reading the file format 0.1, we have to keep support for the
   // old escaping behavior.
-  static QHash<QChar, QChar> escapedChars = {
-      {'\'', '\''},  // Single quote
-      {'"', '"'},  // Double quote
-      {'?', '\?'},  // Question mark
-      {'\\', '\\'},  // Backslash
-      {'a', '\a'},  // Audible bell
-      {'b', '\b'},  // Backspace
-      {'f', '\f'},  // Form feed
-      {'n', '\n'},  // Line feed
-      {'r', '\r'},  // Carriage return
-      {'t', '\t'},  // Horizontal tab
-      {'v', '\v'},  // Vertical tab
-  };
-
-  QString string;
+  QByteArray string = content.mid(oldIndex, index - oldIndex);
   bool escaped = false;
   while (true) {
     if (index >= content.length()) {
       throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                            "String ended without quote.");
     }
-    const QChar& c = content.at(index);
+    const char c = content.at(index);
     if (escaped) {
-      if (escapedChars.contains(c)) {
-        string += escapedChars[c];
-        ++index;
-        escaped = false;
-      } else {
-        throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                             QString("Illegal escape sequence: '\\%1'").arg(c));
+      switch (c) {
+        case '\'':  // Single quote
+        case '"':  // Double quote
+        case '?':  // Question mark
+        case '\\':  // Backslash
+          string += c;
+          break;
+        case 'a':  // Audible bell
+          string += '\a';
+          break;
+        case 'b':  // Backspace
+          string += '\b';
+          break;
+        case 'f':  // Form feed
+          string += '\f';
+          break;
+        case 'n':  // Line feed
+          string += '\n';
+          break;
+        case 'r':  // Carriage return
+          string += '\r';
+          break;
+        case 't':  // Horizontal tab
+          string += '\t';
+          break;
+        case 'v':  // Vertical tab
+          string += '\v';
+          break;
+        default:
+          throw FileParseError(
+              __FILE__, __LINE__, filePath, -1, -1, QString(),
+              QString("Illegal escape sequence: '\\%1'")
+                  .arg(QString::fromUtf8(content.mid(index, 4)).left(1)));
       }
+      ++index;
+      escaped = false;
     } else if (c == '"') {
       ++index;  // consume the '"'
       skipWhitespaceAndComments(content, index);  // consume following spaces
@@ -544,22 +766,35 @@ QString SExpression::parseString(const QString& content, int& index,
       ++index;
     }
   }
-  return string;
+  return QString::fromUtf8(string);
 }
 
-void SExpression::skipWhitespaceAndComments(const QString& content, int& index,
-                                            bool skipNewline) {
-  static QSet<QChar> spaces = {' ', '\f', '\r', '\t', '\v'};
+const QString& SExpression::decode(const QByteArray& content, int index,
+                                   int length, StringCache& cache) noexcept {
+  // Note: The key refers to the content without copying it, which is fine
+  // since the cache is discarded before the content.
+  const QByteArray key =
+      QByteArray::fromRawData(content.constData() + index, length);
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    it = cache.insert(key, QString::fromUtf8(key));
+  }
+  return it.value();
+}
 
+void SExpression::skipWhitespaceAndComments(const QByteArray& content,
+                                            int& index,
+                                            bool skipNewline) noexcept {
   bool isComment = false;
   while (index < content.length()) {
-    const QChar& c = content.at(index);
+    const char c = content.at(index);
     if (c == ';') {  // Line-comment of the Lisp language
       isComment = true;
     } else if (c == '\n') {
       isComment = false;
     }
-    if (isComment || ((skipNewline) && (c == '\n')) || spaces.contains(c)) {
+    if (isComment || (skipNewline && (c == '\n')) || (c == ' ') ||
+        (c == '\f') || (c == '\r') || (c == '\t') || (c == '\v')) {
       ++index;
     } else {
       break;
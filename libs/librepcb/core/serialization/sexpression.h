@@ -27,6 +27,9 @@
 
 #include <QtCore>
 
+#include <atomic>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -62,6 +65,15 @@ T deserialize(const SExpression& node);
 
 /**
  * @brief The SExpression class
+ *
+ * Lists with many children (e.g. the root node of a board) lazily build an
+ * index of their children on the first lookup by name or by index, so
+ * repeated lookups do not need to scan all children again. The const methods
+ * are thread-safe, i.e. the index may be built concurrently by several
+ * threads. Adding or removing children discards the index of the modified
+ * list, and changing the type or the name of any node (which affects the
+ * index of its parent) discards all existing indices, so the index is never
+ * outdated, no matter how a child was obtained.
  */
 class SExpression final {
   Q_DECLARE_TR_FUNCTIONS(SExpression)
@@ -75,6 +87,45 @@ public:
     LineBreak,  ///< manual line break inside a List
   };
 
+  /**
+   * @brief Precompiled path for #getChild() and #tryGetChild()
+   *
+   * The path string is parsed only once when creating this object, thus it
+   * is faster than passing the path as string for lookups executed many
+   * times. Typically it is created as a static constant:
+   *
+   * @code
+   * static const SExpression::ChildPath path("grid/interval/@0");
+   * const SExpression& child = node.getChild(path);
+   * @endcode
+   */
+  class ChildPath final {
+  public:
+    // Constructors / Destructor
+    ChildPath() = delete;
+    ChildPath(const ChildPath& other) = default;
+    explicit ChildPath(const QString& path) noexcept;
+    ~ChildPath() noexcept = default;
+
+    // Getters
+    const QString& toString() const noexcept { return mPath; }
+
+    // Operator Overloadings
+    ChildPath& operator=(const ChildPath& rhs) = default;
+
+  private:  // Types
+    struct Element {
+      QString name;  ///< List name, if index is negative
+      int index;  ///< Child index, or -1 to get the child by name
+    };
+
+  private:  // Data
+    QString mPath;
+    QVector<Element> mElements;
+
+    friend class SExpression;
+  };
+
   // Constructors / Destructor
   SExpression() noexcept;
   SExpression(const SExpression& other) noexcept;
@@ -141,6 +192,8 @@ public:
    */
   SExpression& getChild(const QString& path);
   const SExpression& getChild(const QString& path) const;
+  SExpression& getChild(const ChildPath& path);
+  const SExpression& getChild(const ChildPath& path) const;
 
   /**
    * @brief Try get a child by path
@@ -155,6 +208,8 @@ public:
    */
   SExpression* tryGetChild(const QString& path) noexcept;
   const SExpression* tryGetChild(const QString& path) const noexcept;
+  SExpression* tryGetChild(const ChildPath& path) noexcept;
+  const SExpression* tryGetChild(const ChildPath& path) const noexcept;
 
   // Setters
   void setName(const QString& name);
@@ -194,25 +249,50 @@ public:
   static SExpression createLineBreak();
   static SExpression parse(const QByteArray& content, const FilePath& filePath);
 
+private:  // Types
+  /**
+   * Values already decoded while parsing, with the raw UTF-8 data as key
+   * (pointing into the parsed content, i.e. without copying it). Equal list
+   * names, tokens and strings then share the same implicitly shared QString
+   * instead of allocating memory for each of them.
+   */
+  typedef QHash<QByteArray, QString> StringCache;
+
+  /**
+   * Index of the children of a list, see #getIndex().
+   */
+  struct Index {
+    quint64 generation;  ///< Value of #sIndexGeneration when building it
+    QHash<QString, QVector<int>> lists;  ///< Indices of lists by name
+    QVector<int> values;  ///< Indices of all children except line breaks
+  };
+
 private:  // Methods
   SExpression(Type type, const QString& value);
 
   bool isMultiLine() const noexcept;
-  static bool skipLineBreaks(const QList<SExpression>& children,
-                             int& index) noexcept;
-  static SExpression parse(const QString& content, int& index,
-                           const FilePath& filePath);
-  static SExpression parseList(const QString& content, int& index,
-                               const FilePath& filePath);
-  static QString parseToken(const QString& content, int& index,
-                            const FilePath& filePath);
-  static QString parseString(const QString& content, int& index,
-                             const FilePath& filePath);
-  static void skipWhitespaceAndComments(const QString& content, int& index,
-                                        bool skipNewline = false);
+  std::shared_ptr<const Index> getIndex() const noexcept;
+  void invalidateIndex() noexcept;
+  static void invalidateAllIndices() noexcept;
+  int findListIndex(const QStringRef& name) const noexcept;
+  int findValueIndex(int n) const noexcept;
+  int findChildIndex(const QStringRef& element) const noexcept;
+  static SExpression parse(const QByteArray& content, int& index,
+                           const FilePath& filePath, StringCache& cache);
+  static SExpression parseList(const QByteArray& content, int& index,
+                               const FilePath& filePath, StringCache& cache);
+  static QString parseToken(const QByteArray& content, int& index,
+                            const FilePath& filePath, StringCache& cache);
+  static QString parseString(const QByteArray& content, int& index,
+                             const FilePath& filePath, StringCache& cache);
+  static const QString& decode(const QByteArray& content, int index,
+                               int length, StringCache& cache) noexcept;
+  static void skipWhitespaceAndComments(const QByteArray& content, int& index,
+                                        bool skipNewline = false) noexcept;
   static QString escapeString(const QString& string) noexcept;
   static bool isValidToken(const QString& token) noexcept;
   static bool isValidTokenChar(const QChar& c) noexcept;
+  static bool isValidTokenChar(char c) noexcept;
   QString toString(int indent) const;
 
 private:  // Data
@@ -220,6 +300,14 @@ private:  // Data
   QString mValue;  ///< either a list name, a token or a string
   QList<SExpression> mChildren;
   FilePath mFilePath;
+
+  /// Lazily built index of mChildren, only accessed with std::atomic_load()
+  /// and std::atomic_store() to allow building it in const methods
+  mutable std::shared_ptr<const Index> mIndex;
+
+  /// Incremented whenever the type or name of any node changes, to discard
+  /// the indices of all parents (which are not known by their children)
+  static std::atomic<quint64> sIndexGeneration;
 };
 
 /*******************************************************************************
@@ -40,9 +40,12 @@ static QtMetaTypeRegistration<Point> sMetaType;
  *  Class Point
  ******************************************************************************/
 
-Point::Point(const SExpression& node)
-  : mX(deserialize<Length>(node.getChild("@0"))),
-    mY(deserialize<Length>(node.getChild("@1"))) {
+Point::Point(const SExpression& node) : mX(0), mY(0) {
+  // Note: Precompiled paths since this is called very often.
+  static const SExpression::ChildPath xPath("@0");
+  static const SExpression::ChildPath yPath("@1");
+  mX = deserialize<Length>(node.getChild(xPath));
+  mY = deserialize<Length>(node.getChild(yPath));
 }
 
 // General Methods
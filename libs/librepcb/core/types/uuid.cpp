@@ -25,7 +25,6 @@
 #include "../exceptions.h"
 #include "../serialization/sexpression.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
 /*******************************************************************************
@@ -33,74 +32,45 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString Uuid::toStr() const noexcept {
+  static const char digits[] = "0123456789abcdef";
+  QString str(36, QChar('-'));
+  QChar* data = str.data();
+  int pos = 0;
+  for (int i = 0; i < 32; ++i) {
+    if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) {
+      ++pos;  // Skip '-'.
+    }
+    const quint64 value = (i < 16) ? mHigh : mLow;
+    const int shift = 60 - 4 * (i % 16);
+    data[pos++] = QLatin1Char(digits[(value >> shift) & 0xF]);
+  }
+  return str;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
 bool Uuid::isValid(const QString& str) noexcept {
-  // Note: This used to be done using a RegEx, but when profiling and
-  // optimizing the library rescan code we found that a manually unrolled
-  // comparison loop performs much better than the previous RegEx.
-  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
-  if (str.length() != 36) return false;
-
-  // Helper function
-  auto isLowerHex = [](const QChar& chr) {
-    return (chr >= QChar('0') && chr <= QChar('9')) ||
-        (chr >= QChar('a') && chr <= QChar('f'));
-  };
-
-  if (!isLowerHex(str[0])) return false;
-  if (!isLowerHex(str[1])) return false;
-  if (!isLowerHex(str[2])) return false;
-  if (!isLowerHex(str[3])) return false;
-  if (!isLowerHex(str[4])) return false;
-  if (!isLowerHex(str[5])) return false;
-  if (!isLowerHex(str[6])) return false;
-  if (!isLowerHex(str[7])) return false;
-  if (str[8] != QChar('-')) return false;
-  if (!isLowerHex(str[9])) return false;
-  if (!isLowerHex(str[10])) return false;
-  if (!isLowerHex(str[11])) return false;
-  if (!isLowerHex(str[12])) return false;
-  if (str[13] != QChar('-')) return false;
-  if (!isLowerHex(str[14])) return false;
-  if (!isLowerHex(str[15])) return false;
-  if (!isLowerHex(str[16])) return false;
-  if (!isLowerHex(str[17])) return false;
-  if (str[18] != QChar('-')) return false;
-  if (!isLowerHex(str[19])) return false;
-  if (!isLowerHex(str[20])) return false;
-  if (!isLowerHex(str[21])) return false;
-  if (!isLowerHex(str[22])) return false;
-  if (str[23] != QChar('-')) return false;
-  if (!isLowerHex(str[24])) return false;
-  if (!isLowerHex(str[25])) return false;
-  if (!isLowerHex(str[26])) return false;
-  if (!isLowerHex(str[27])) return false;
-  if (!isLowerHex(str[28])) return false;
-  if (!isLowerHex(str[29])) return false;
-  if (!isLowerHex(str[30])) return false;
-  if (!isLowerHex(str[31])) return false;
-  if (!isLowerHex(str[32])) return false;
-  if (!isLowerHex(str[33])) return false;
-  if (!isLowerHex(str[34])) return false;
-  if (!isLowerHex(str[35])) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
-
-  return true;
+  return parse(str).has_value();
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  const QUuid quuid = QUuid::createUuid();
+  if ((quuid.variant() == QUuid::DCE) && (quuid.version() == QUuid::Random)) {
+    const quint64 high = (static_cast<quint64>(quuid.data1) << 32) |
+        (static_cast<quint64>(quuid.data2) << 16) |
+        static_cast<quint64>(quuid.data3);
+    quint64 low = 0;
+    for (int i = 0; i < 8; ++i) {
+      low = (low << 8) | static_cast<quint64>(quuid.data4[i]);
+    }
+    return Uuid(high, low);
   } else {
     // Calls abort()!
     qFatal("Not able to generate valid random UUID, terminating application!");
@@ -108,8 +78,8 @@ Uuid Uuid::createRandom() noexcept {
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  if (tl::optional<Uuid> uuid = parse(str)) {
+    return *uuid;
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("String is not a valid UUID: \"%1\"").arg(str));
@@ -117,11 +87,46 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
-  } else {
-    return tl::nullopt;
+  return parse(str);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+tl::optional<Uuid> Uuid::parse(const QString& str) noexcept {
+  // Note: This used to be done using a RegEx, but when profiling and
+  // optimizing the library rescan code we found that a manually written
+  // comparison loop performs much better than the previous RegEx.
+  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
+  if (str.length() != 36) return tl::nullopt;
+
+  quint64 values[2] = {0, 0};
+  int digit = 0;
+  for (int i = 0; i < 36; ++i) {
+    const ushort chr = str.at(i).unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (chr != '-') return tl::nullopt;
+      continue;
+    }
+    quint64 nibble;
+    if ((chr >= '0') && (chr <= '9')) {
+      nibble = chr - '0';
+    } else if ((chr >= 'a') && (chr <= 'f')) {
+      nibble = chr - 'a' + 10;
+    } else {
+      return tl::nullopt;  // Note: Uppercase is not allowed!
+    }
+    quint64& value = values[digit / 16];
+    value = (value << 4) | nibble;
+    ++digit;
   }
+
+  // Check type of UUID (RFC4122 variant, version 4).
+  if (((values[0] >> 12) & 0xF) != 4) return tl::nullopt;
+  if ((values[1] >> 62) != 2) return tl::nullopt;
+
+  return Uuid(values[0], values[1]);
 }
 
 /*******************************************************************************
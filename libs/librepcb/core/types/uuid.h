@@ -46,6 +46,10 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally the UUID is stored as 128-bit binary value to make copying,
+ * comparing and hashing cheap since UUIDs are used as keys in many containers.
+ * The string representation is only created on demand by #toStr().
+ *
  * @note This class guarantees that only Uuid objects representing a valid UUID
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
@@ -69,7 +73,8 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept
+    : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -83,7 +88,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -91,18 +96,24 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (the order is the same as when
+   *         comparing their string representations)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -148,14 +159,29 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its binary value
+   *
+   * @param high      The upper 64 bits (first 16 hex digits) of the UUID
+   * @param low       The lower 64 bits (last 16 hex digits) of the UUID
+   */
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  /**
+   * @brief Parse and validate a UUID string
+   *
+   * @param str           Input string
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @retval Uuid         The created Uuid object if str was valid
+   * @retval tl::nullopt  If str was not a valid UUID
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  static tl::optional<Uuid> parse(const QString& str) noexcept;
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  // Guaranteed to always contain a valid UUID
+  quint64 mHigh;  ///< Upper 64 bits, i.e. "d79d354b-62bd-4866"
+  quint64 mLow;  ///< Lower 64 bits, i.e. "996a-78941c575e78"
 };
 
 /*******************************************************************************
@@ -173,14 +199,15 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  // Random UUIDs are uniformly distributed, so a simple XOR is good enough.
+  return ::qHash(key.mHigh ^ key.mLow, seed);
 }
 
 }  // namespace librepcb
 
 namespace tl {
 inline uint qHash(const optional<librepcb::Uuid>& key, uint seed) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? librepcb::qHash(*key, seed) : ::qHash(QString(), seed);
 }
 }  // namespace tl
 
@@ -0,0 +1,257 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "spatialindex.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+// Maximum number of children per tree node.
+static const int sNodeCapacity = 16;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+SpatialIndex::SpatialIndex() noexcept : mRects(), mLeafItems(), mLevels() {
+}
+
+SpatialIndex::SpatialIndex(const QVector<Rect>& rects) noexcept
+  : mRects(rects), mLeafItems(), mLevels() {
+  // Empty rects never match any query, so don't add them to the tree at all.
+  QVector<int> items;
+  QVector<Rect> itemRects;
+  for (int i = 0; i < mRects.count(); ++i) {
+    if (!isEmpty(mRects.at(i))) {
+      items.append(i);
+      itemRects.append(mRects.at(i));
+    }
+  }
+
+  // Build the leaf level.
+  QVector<int> order;
+  QVector<Node> nodes = pack(itemRects, order);
+  mLeafItems.reserve(order.count());
+  foreach (int index, order) {
+    mLeafItems.append(items.at(index));
+  }
+  if (nodes.isEmpty()) {
+    return;
+  }
+  mLevels.append(nodes);
+
+  // Build the upper levels until there's only a single root level left which
+  // is small enough to be scanned linearly.
+  while (mLevels.last().count() > sNodeCapacity) {
+    const QVector<Node> lower = mLevels.last();
+    QVector<Rect> lowerRects;
+    lowerRects.reserve(lower.count());
+    foreach (const Node& node, lower) {
+      lowerRects.append(node.rect);
+    }
+    nodes = pack(lowerRects, order);
+    QVector<Node> reordered;
+    reordered.reserve(order.count());
+    foreach (int index, order) {
+      reordered.append(lower.at(index));
+    }
+    mLevels.last() = reordered;
+    mLevels.append(nodes);
+  }
+}
+
+SpatialIndex::~SpatialIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<int> SpatialIndex::find(const Rect& rect) const noexcept {
+  QVector<int> result;
+  if (isEmpty(rect) || mLevels.isEmpty()) {
+    return result;
+  }
+
+  // Depth-first traversal, starting at all nodes of the root level.
+  QVector<std::pair<int, int>> stack;  // Level, node index.
+  const int rootLevel = mLevels.count() - 1;
+  for (int i = 0; i < mLevels.at(rootLevel).count(); ++i) {
+    stack.append(std::make_pair(rootLevel, i));
+  }
+  while (!stack.isEmpty()) {
+    const std::pair<int, int> entry = stack.takeLast();
+    const Node& node = mLevels.at(entry.first).at(entry.second);
+    if (!intersects(node.rect, rect)) {
+      continue;
+    }
+    if (entry.first == 0) {
+      for (int i = node.first; i < node.first + node.count; ++i) {
+        const int item = mLeafItems.at(i);
+        if (intersects(mRects.at(item), rect)) {
+          result.append(item);
+        }
+      }
+    } else {
+      for (int i = node.first; i < node.first + node.count; ++i) {
+        stack.append(std::make_pair(entry.first - 1, i));
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+QVector<int> SpatialIndex::find(
+    const ClipperLib::IntPoint& point) const noexcept {
+  return find(Rect{point.X, point.Y, point.X, point.Y});
+}
+
+QVector<std::pair<int, int>> SpatialIndex::findIntersectingPairs()
+    const noexcept {
+  QVector<std::pair<int, int>> result;
+  for (int i = 0; i < mRects.count(); ++i) {
+    foreach (int k, find(mRects.at(i))) {
+      if (k > i) {
+        result.append(std::make_pair(i, k));
+      }
+    }
+  }
+  return result;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+SpatialIndex::Rect SpatialIndex::emptyRect() noexcept {
+  const ClipperLib::cInt max = std::numeric_limits<ClipperLib::cInt>::max();
+  const ClipperLib::cInt min = std::numeric_limits<ClipperLib::cInt>::min();
+  return Rect{max, max, min, min};
+}
+
+bool SpatialIndex::isEmpty(const Rect& rect) noexcept {
+  return (rect.left > rect.right) || (rect.top > rect.bottom);
+}
+
+bool SpatialIndex::intersects(const Rect& a, const Rect& b) noexcept {
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+      (b.top <= a.bottom) && (!isEmpty(a)) && (!isEmpty(b));
+}
+
+SpatialIndex::Rect SpatialIndex::united(const Rect& a,
+                                        const Rect& b) noexcept {
+  return Rect{std::min(a.left, b.left), std::min(a.top, b.top),
+              std::max(a.right, b.right), std::max(a.bottom, b.bottom)};
+}
+
+SpatialIndex::Rect SpatialIndex::grown(const Rect& rect,
+                                       ClipperLib::cInt offset) noexcept {
+  if (isEmpty(rect)) {
+    return rect;
+  }
+  return Rect{rect.left - offset, rect.top - offset, rect.right + offset,
+              rect.bottom + offset};
+}
+
+SpatialIndex::Rect SpatialIndex::boundingRect(
+    const ClipperLib::Path& path) noexcept {
+  Rect rect = emptyRect();
+  for (const ClipperLib::IntPoint& p : path) {
+    rect.left = std::min(rect.left, p.X);
+    rect.top = std::min(rect.top, p.Y);
+    rect.right = std::max(rect.right, p.X);
+    rect.bottom = std::max(rect.bottom, p.Y);
+  }
+  return rect;
+}
+
+SpatialIndex::Rect SpatialIndex::boundingRect(
+    const ClipperLib::Paths& paths) noexcept {
+  Rect rect = emptyRect();
+  for (const ClipperLib::Path& path : paths) {
+    rect = united(rect, boundingRect(path));
+  }
+  return rect;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<SpatialIndex::Node> SpatialIndex::pack(const QVector<Rect>& rects,
+                                               QVector<int>& order) noexcept {
+  // Sort-Tile-Recursive: Sort all rects by their X center, split them into
+  // vertical slices, sort each slice by the Y center and then group
+  // consecutive rects into nodes.
+  order.clear();
+  order.reserve(rects.count());
+  for (int i = 0; i < rects.count(); ++i) {
+    order.append(i);
+  }
+  auto centerX = [&rects](int i) {
+    return (rects.at(i).left / 2) + (rects.at(i).right / 2);
+  };
+  auto centerY = [&rects](int i) {
+    return (rects.at(i).top / 2) + (rects.at(i).bottom / 2);
+  };
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return centerX(a) < centerX(b);
+  });
+  const int nodeCount = (rects.count() + sNodeCapacity - 1) / sNodeCapacity;
+  const int sliceCount = qCeil(std::sqrt(static_cast<qreal>(nodeCount)));
+  const int sliceSize = std::max(sliceCount, 1) * sNodeCapacity;
+  for (int i = 0; i < order.count(); i += sliceSize) {
+    auto end = order.begin() + std::min(i + sliceSize, order.count());
+    std::stable_sort(order.begin() + i, end, [&](int a, int b) {
+      return centerY(a) < centerY(b);
+    });
+  }
+
+  QVector<Node> nodes;
+  nodes.reserve(nodeCount);
+  for (int i = 0; i < order.count(); i += sliceSize) {
+    const int sliceEnd = std::min(i + sliceSize, order.count());
+    for (int k = i; k < sliceEnd; k += sNodeCapacity) {
+      Node node{emptyRect(), k, std::min(sNodeCapacity, sliceEnd - k)};
+      for (int n = node.first; n < node.first + node.count; ++n) {
+        node.rect = united(node.rect, rects.at(order.at(n)));
+      }
+      nodes.append(node);
+    }
+  }
+  return nodes;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_SPATIALINDEX_H
+#define LIBREPCB_CORE_SPATIALINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class SpatialIndex
+ ******************************************************************************/
+
+/**
+ * @brief Static R-tree over axis-aligned bounding boxes
+ *
+ * The index is bulk-loaded once from a list of bounding boxes (using the
+ * Sort-Tile-Recursive algorithm) and then allows to query all items whose
+ * bounding box intersects a given rectangle in logarithmic time. Items are
+ * identified by their index in the list passed to the constructor, thus the
+ * caller keeps the actual data in its own container.
+ *
+ * Typical use case is to avoid expensive pairwise operations (e.g. Clipper
+ * intersections) on objects which are far away from each other.
+ *
+ * @note Bounding boxes are inclusive, i.e. boxes which only touch each other
+ *       are considered as intersecting. Empty boxes (see #isEmpty()) never
+ *       intersect anything.
+ */
+class SpatialIndex final {
+public:
+  // Types
+  typedef ClipperLib::IntRect Rect;
+
+  // Constructors / Destructor
+  SpatialIndex() noexcept;
+  SpatialIndex(const SpatialIndex& other) = default;
+  explicit SpatialIndex(const QVector<Rect>& rects) noexcept;
+  ~SpatialIndex() noexcept;
+
+  // Getters
+  int getCount() const noexcept { return mRects.count(); }
+  const Rect& getRect(int index) const noexcept { return mRects.at(index); }
+
+  // General Methods
+
+  /**
+   * @brief Find all items whose bounding box intersects a rectangle
+   *
+   * @param rect    The rectangle to search for.
+   *
+   * @return Indices of all matching items, sorted in ascending order.
+   */
+  QVector<int> find(const Rect& rect) const noexcept;
+
+  /**
+   * @brief Find all items whose bounding box contains a point
+   *
+   * @param point   The point to search for.
+   *
+   * @return Indices of all matching items, sorted in ascending order.
+   */
+  QVector<int> find(const ClipperLib::IntPoint& point) const noexcept;
+
+  /**
+   * @brief Find all pairs of items with intersecting bounding boxes
+   *
+   * @return Index pairs where `first < second`, sorted in ascending order
+   *         (i.e. in the same order as a nested loop over all items would
+   *         visit them).
+   */
+  QVector<std::pair<int, int>> findIntersectingPairs() const noexcept;
+
+  // Static Methods
+  static Rect emptyRect() noexcept;
+  static bool isEmpty(const Rect& rect) noexcept;
+  static bool intersects(const Rect& a, const Rect& b) noexcept;
+  static Rect united(const Rect& a, const Rect& b) noexcept;
+  static Rect grown(const Rect& rect, ClipperLib::cInt offset) noexcept;
+  static Rect boundingRect(const ClipperLib::Path& path) noexcept;
+  static Rect boundingRect(const ClipperLib::Paths& paths) noexcept;
+
+  // Operator Overloadings
+  SpatialIndex& operator=(const SpatialIndex& rhs) = default;
+
+private:  // Types
+  struct Node {
+    Rect rect;
+    int first;  ///< Index of first child in the next lower level
+    int count;  ///< Number of children in the next lower level
+  };
+
+private:  // Methods
+  static QVector<Node> pack(const QVector<Rect>& rects,
+                            QVector<int>& order) noexcept;
+
+private:  // Data
+  /// The bounding boxes of all items, in the order passed to the constructor
+  QVector<Rect> mRects;
+
+  /// Item indices, ordered in the way the leaf nodes reference them
+  QVector<int> mLeafItems;
+
+  /// Tree levels, index 0 being the leaf level and the last one being the root
+  QVector<QVector<Node>> mLevels;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
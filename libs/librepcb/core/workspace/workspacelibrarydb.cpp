@@ -36,12 +36,15 @@
 #include "../library/sym/symbol.h"
 #include "../serialization/sexpression.h"
 #include "../sqlitedatabase.h"
+#include "../utils/toolbox.h"
 #include "workspacelibrarydbwriter.h"
 #include "workspacelibraryscanner.h"
 
 #include <QtCore>
 #include <QtSql>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -60,7 +63,8 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
   : QObject(nullptr),
     mLibrariesPath(librariesPath),
     mFilePath(mLibrariesPath.getPathTo(
-        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))) {
+        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))),
+    mFullTextIndex(FullTextIndex::None) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -80,6 +84,7 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
     writer.createAllTables();  // can throw
     writer.addInternalData("version", sCurrentDbVersion);  // can throw
   }
+  mFullTextIndex = getFullTextIndex();
 
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mLibrariesPath, mFilePath));
@@ -113,48 +118,103 @@ int WorkspaceLibraryDb::getScanProgressPercent() const noexcept {
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
-  // ATTENTION: Keep SQL in sync with the generig find() method below!
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT packages.uuid FROM packages "
-      "LEFT JOIN packages_tr "
-      "ON packages.id = packages_tr.element_id "
-      "LEFT JOIN packages_alt "
-      "ON packages.id = packages_alt.package_id "
-      "WHERE packages_tr.name LIKE :escapedKeyword "
-      "OR packages_tr.keywords LIKE :escapedKeyword "
-      "OR packages_alt.name LIKE :escapedKeyword "
-      "OR packages.uuid = :keyword "
-      "GROUP BY packages.uuid "
-      "ORDER BY packages_tr.name ASC");
-  query.bindValue(":keyword", keyword);
-  query.bindValue(":escapedKeyword", "%" + keyword + "%");
-  mDb->exec(query);
-
   QList<Uuid> uuids;
-  while (query.next()) {
-    uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+  const QString ftsQuery = toFullTextQuery(keyword, mFullTextIndex);
+  if (!ftsQuery.isEmpty()) {
+    // ATTENTION: Keep SQL in sync with the generic find() method below!
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT packages.uuid FROM ("
+        "SELECT element_id AS id, name, "
+        "bm25(packages_fts, 0.0, 10.0, 1.0) AS score "
+        "FROM packages_fts WHERE packages_fts MATCH :query "
+        "UNION ALL "
+        "SELECT package_id AS id, name, "
+        "bm25(packages_alt_fts, 0.0, 10.0) AS score "
+        "FROM packages_alt_fts WHERE packages_alt_fts MATCH :query "
+        "LIMIT -1"  // Avoids flattening, bm25() is not allowed in aggregates.
+        ") AS matches "
+        "INNER JOIN packages ON packages.id = matches.id "
+        "GROUP BY packages.uuid "
+        "ORDER BY MIN(matches.score) ASC, MIN(matches.name) ASC");
+    query.bindValue(":query", ftsQuery);
+    mDb->exec(query);
+    while (query.next()) {
+      uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+    }
+  }
+
+  // Slow substring search (e.g. for UUIDs or short words), only if the index
+  // is not available or did not find anything.
+  // ATTENTION: Keep SQL in sync with the generic find() method below!
+  if (uuids.isEmpty()) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT packages.uuid FROM packages "
+        "LEFT JOIN packages_tr "
+        "ON packages.id = packages_tr.element_id "
+        "LEFT JOIN packages_alt "
+        "ON packages.id = packages_alt.package_id "
+        "WHERE packages_tr.name LIKE :escapedKeyword "
+        "OR packages_tr.keywords LIKE :escapedKeyword "
+        "OR packages_alt.name LIKE :escapedKeyword "
+        "OR packages.uuid = :keyword "
+        "GROUP BY packages.uuid "
+        "ORDER BY packages_tr.name ASC "
+        "LIMIT :limit");
+    query.bindValue(":keyword", keyword);
+    query.bindValue(":escapedKeyword", "%" + keyword + "%");
+    query.bindValue(":limit", sMaxFallbackResults);
+    mDb->exec(query);
+    while (query.next()) {
+      uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+    }
   }
   return uuids;
 }
 
 QList<Uuid> WorkspaceLibraryDb::findDevicesOfParts(
     const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT devices.uuid FROM devices "
-      "LEFT JOIN parts "
-      "ON devices.id = parts.device_id "
-      "LEFT JOIN devices_tr "
-      "ON devices.id = devices_tr.element_id "
-      "WHERE parts.manufacturer LIKE :keyword "
-      "OR parts.mpn LIKE :keyword "
-      "GROUP BY devices.uuid "
-      "ORDER BY devices_tr.name ASC");
-  query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
-
   QList<Uuid> uuids;
-  while (query.next()) {
-    uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+  const QString ftsQuery = toFullTextQuery(keyword, mFullTextIndex);
+  if (!ftsQuery.isEmpty()) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT devices.uuid FROM ("
+        "SELECT device_id AS id, bm25(parts_fts, 0.0, 10.0, 1.0) AS score "
+        "FROM parts_fts WHERE parts_fts MATCH :query "
+        "LIMIT -1"  // Avoids flattening, bm25() is not allowed in aggregates.
+        ") AS matches "
+        "INNER JOIN devices "
+        "ON devices.id = matches.id "
+        "LEFT JOIN devices_tr "
+        "ON devices.id = devices_tr.element_id "
+        "GROUP BY devices.uuid "
+        "ORDER BY MIN(matches.score) ASC, MIN(devices_tr.name) ASC");
+    query.bindValue(":query", ftsQuery);
+    mDb->exec(query);
+    while (query.next()) {
+      uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+    }
+  }
+
+  // Slow substring search, only if the index is not available or did not
+  // find anything.
+  if (uuids.isEmpty()) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT devices.uuid FROM devices "
+        "LEFT JOIN parts "
+        "ON devices.id = parts.device_id "
+        "LEFT JOIN devices_tr "
+        "ON devices.id = devices_tr.element_id "
+        "WHERE parts.manufacturer LIKE :keyword "
+        "OR parts.mpn LIKE :keyword "
+        "GROUP BY devices.uuid "
+        "ORDER BY devices_tr.name ASC "
+        "LIMIT :limit");
+    query.bindValue(":keyword", "%" + keyword + "%");
+    query.bindValue(":limit", sMaxFallbackResults);
+    mDb->exec(query);
+    while (query.next()) {
+      uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+    }
   }
   return uuids;
 }
@@ -243,6 +303,30 @@ QSet<Uuid> WorkspaceLibraryDb::getComponentDevices(
   return getUuidSet(query);
 }
 
+QHash<Uuid, QSet<Uuid>> WorkspaceLibraryDb::getComponentDevices(
+    const QList<Uuid>& components) const {
+  QHash<Uuid, QSet<Uuid>> devices;
+  foreach (const QList<Uuid>& chunk, splitIntoChunks(components)) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT component_uuid, uuid FROM devices "
+        "WHERE component_uuid IN (%placeholders) "
+        "GROUP BY component_uuid, uuid",
+        {
+            {"%placeholders", getPlaceholders(chunk.count())},
+        });
+    bindUuids(query, chunk);
+    mDb->exec(query);
+    while (query.next()) {
+      const Uuid cmpUuid =
+          Uuid::fromString(query.value(0).toString());  // can throw
+      const Uuid devUuid =
+          Uuid::fromString(query.value(1).toString());  // can throw
+      devices[cmpUuid].insert(devUuid);
+    }
+  }
+  return devices;
+}
+
 QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::getDeviceParts(
     const Uuid& device) const {
   SQLiteDatabase::TransactionScopeGuard sg(*mDb);  // Atomic attributes query!
@@ -325,34 +409,144 @@ QMultiMap<Version, FilePath> WorkspaceLibraryDb::getAll(
 
 FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
     const QMultiMap<Version, FilePath>& list) const noexcept {
-  if (list.isEmpty())
+  if (list.isEmpty()) {
     return FilePath();
-  else
-    return list.last();  // highest version number
+  }
+
+  // If several elements have the highest version number (e.g. the same
+  // element in several libraries), take the one with the lowest filepath to
+  // get a deterministic result.
+  const QList<FilePath> candidates = list.values(list.lastKey());
+  return *std::min_element(candidates.begin(), candidates.end());
+}
+
+QHash<Uuid, WorkspaceLibraryDb::ElementInfo> WorkspaceLibraryDb::getLatestInfos(
+    const QString& elementsTable, const QList<Uuid>& uuids,
+    const QStringList& localeOrder) const {
+  struct Element {
+    Uuid uuid;
+    Version version;
+    ElementInfo info;
+    LocalizedDescriptionMap names;
+  };
+
+  // Get all versions of the requested elements, together with all their
+  // translations (one row per translation).
+  const bool isDevice = (elementsTable == "devices");
+  QHash<int, std::shared_ptr<Element>> elements;  // Key: Element ID
+  foreach (const QList<Uuid>& chunk, splitIntoChunks(uuids)) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT %elements.id, uuid, version, filepath, deprecated, "
+        "%device_columns, locale, name FROM %elements "
+        "LEFT JOIN %elements_tr "
+        "ON %elements.id = %elements_tr.element_id "
+        "WHERE %elements.uuid IN (%placeholders)",
+        {
+            {"%elements", elementsTable},
+            {"%device_columns",
+             isDevice ? "component_uuid, package_uuid" : "NULL, NULL"},
+            {"%placeholders", getPlaceholders(chunk.count())},
+        });
+    bindUuids(query, chunk);
+    mDb->exec(query);
+    while (query.next()) {
+      std::shared_ptr<Element>& element = elements[query.value(0).toInt()];
+      if (!element) {
+        const FilePath fp(
+            FilePath::fromRelative(mLibrariesPath, query.value(3).toString()));
+        if (!fp.isValid()) {
+          throw LogicError(__FILE__, __LINE__);
+        }
+        element.reset(new Element{
+            Uuid::fromString(query.value(1).toString()),  // can throw
+            Version::fromString(query.value(2).toString()),  // can throw
+            ElementInfo{fp, QString(), query.value(4).toBool(),
+                        Uuid::tryFromString(query.value(5).toString()),
+                        Uuid::tryFromString(query.value(6).toString())},
+            LocalizedDescriptionMap(QString{}),
+        });
+      }
+      const QString name = query.value(8).toString();
+      if (!name.isNull()) {
+        element->names.insert(query.value(7).toString(), name);
+      }
+    }
+  }
+
+  // Determine the latest version of each element. For equal versions, take
+  // the one with the lowest filepath, like getLatestVersionFilePath() does.
+  QHash<Uuid, std::shared_ptr<Element>> latest;
+  foreach (const std::shared_ptr<Element>& element, elements) {
+    auto it = latest.find(element->uuid);
+    if (it == latest.end()) {
+      latest.insert(element->uuid, element);
+    } else if (((*it)->version < element->version) ||
+               (((*it)->version == element->version) &&
+                (element->info.filePath < (*it)->info.filePath))) {
+      *it = element;
+    }
+  }
+
+  QHash<Uuid, ElementInfo> infos;
+  foreach (const std::shared_ptr<Element>& element, latest) {
+    ElementInfo info = element->info;
+    info.name = element->names.value(localeOrder);
+    infos.insert(element->uuid, info);
+  }
+  return infos;
 }
 
 QList<Uuid> WorkspaceLibraryDb::find(const QString& elementsTable,
                                      const QString& keyword) const {
-  // ATTENTION: Keep SQL in sync with the find<Package>() method above!
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT %elements.uuid FROM %elements "
-      "LEFT JOIN %elements_tr "
-      "ON %elements.id = %elements_tr.element_id "
-      "WHERE %elements_tr.name LIKE :escapedKeyword "
-      "OR %elements_tr.keywords LIKE :escapedKeyword "
-      "OR %elements.uuid = :keyword "
-      "GROUP BY %elements.uuid "
-      "ORDER BY %elements_tr.name ASC",
-      {
-          {"%elements", elementsTable},
-      });
-  query.bindValue(":keyword", keyword);
-  query.bindValue(":escapedKeyword", "%" + keyword + "%");
-  mDb->exec(query);
-
   QList<Uuid> uuids;
-  while (query.next()) {
-    uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+  const QString ftsQuery = toFullTextQuery(keyword, mFullTextIndex);
+  if (!ftsQuery.isEmpty()) {
+    // ATTENTION: Keep SQL in sync with the find<Package>() method above!
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT %elements.uuid FROM ("
+        "SELECT element_id AS id, name, "
+        "bm25(%elements_fts, 0.0, 10.0, 1.0) AS score "
+        "FROM %elements_fts WHERE %elements_fts MATCH :query "
+        "LIMIT -1"  // Avoids flattening, bm25() is not allowed in aggregates.
+        ") AS matches "
+        "INNER JOIN %elements "
+        "ON %elements.id = matches.id "
+        "GROUP BY %elements.uuid "
+        "ORDER BY MIN(matches.score) ASC, MIN(matches.name) ASC",
+        {
+            {"%elements", elementsTable},
+        });
+    query.bindValue(":query", ftsQuery);
+    mDb->exec(query);
+    while (query.next()) {
+      uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+    }
+  }
+
+  // Slow substring search (e.g. for UUIDs or short words), only if the index
+  // is not available or did not find anything.
+  // ATTENTION: Keep SQL in sync with the find<Package>() method above!
+  if (uuids.isEmpty()) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT %elements.uuid FROM %elements "
+        "LEFT JOIN %elements_tr "
+        "ON %elements.id = %elements_tr.element_id "
+        "WHERE %elements_tr.name LIKE :escapedKeyword "
+        "OR %elements_tr.keywords LIKE :escapedKeyword "
+        "OR %elements.uuid = :keyword "
+        "GROUP BY %elements.uuid "
+        "ORDER BY %elements_tr.name ASC "
+        "LIMIT :limit",
+        {
+            {"%elements", elementsTable},
+        });
+    query.bindValue(":keyword", keyword);
+    query.bindValue(":escapedKeyword", "%" + keyword + "%");
+    query.bindValue(":limit", sMaxFallbackResults);
+    mDb->exec(query);
+    while (query.next()) {
+      uuids.append(Uuid::fromString(query.value(0).toString()));  // can throw
+    }
   }
   return uuids;
 }
@@ -543,6 +737,32 @@ QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
   return uuids;
 }
 
+QList<QList<Uuid>> WorkspaceLibraryDb::splitIntoChunks(
+    const QList<Uuid>& uuids) noexcept {
+  // Older SQLite versions support only up to 999 parameters per statement.
+  static const int chunkSize = 500;
+  QList<QList<Uuid>> chunks;
+  for (int i = 0; i < uuids.count(); i += chunkSize) {
+    chunks.append(uuids.mid(i, chunkSize));
+  }
+  return chunks;
+}
+
+QString WorkspaceLibraryDb::getPlaceholders(int count) noexcept {
+  QStringList placeholders;
+  for (int i = 0; i < count; ++i) {
+    placeholders.append(QString(":uuid%1").arg(i));
+  }
+  return placeholders.join(", ");
+}
+
+void WorkspaceLibraryDb::bindUuids(QSqlQuery& query,
+                                   const QList<Uuid>& uuids) noexcept {
+  for (int i = 0; i < uuids.count(); ++i) {
+    query.bindValue(QString(":uuid%1").arg(i), uuids.at(i).toStr());
+  }
+}
+
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
     QSqlQuery query = mDb->prepareQuery(
@@ -562,6 +782,50 @@ int WorkspaceLibraryDb::getDbVersion() const noexcept {
   }
 }
 
+WorkspaceLibraryDb::FullTextIndex WorkspaceLibraryDb::getFullTextIndex()
+    const noexcept {
+  try {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT sql FROM sqlite_master "
+        "WHERE type = 'table' AND name = 'parts_fts'");
+    mDb->exec(query);
+    if (!query.next()) {
+      return FullTextIndex::None;
+    } else if (query.value(0).toString().contains("trigram")) {
+      return FullTextIndex::Trigram;
+    } else {
+      return FullTextIndex::WordPrefix;
+    }
+  } catch (const Exception& e) {
+    return FullTextIndex::None;
+  }
+}
+
+QString WorkspaceLibraryDb::toFullTextQuery(const QString& keyword,
+                                            FullTextIndex index) noexcept {
+  // Split the keyword into words and search for all of them, either as
+  // substrings or as word prefixes. Quoting avoids interpreting any FTS5 query
+  // syntax. The trigram tokenizer never matches words shorter than 3
+  // characters, so these have to be searched without index.
+  static const QRegularExpression separators(
+      "[\\W_]+", QRegularExpression::UseUnicodePropertiesOption);
+  QStringList terms;
+  foreach (const QString& word,
+           keyword.split(separators, QString::SkipEmptyParts)) {
+    if (index == FullTextIndex::Trigram) {
+      if (word.length() < 3) {
+        return QString();
+      }
+      terms.append("\"" % word % "\"");
+    } else if (index == FullTextIndex::WordPrefix) {
+      terms.append("\"" % word % "\"*");
+    } else {
+      return QString();
+    }
+  }
+  return terms.join(" ");
+}
+
 template <typename ElementType>
 QString WorkspaceLibraryDb::getTable() noexcept {
   return WorkspaceLibraryDbWriter::getElementTable<ElementType>();
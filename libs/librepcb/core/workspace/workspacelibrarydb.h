@@ -101,6 +101,19 @@ public:
     }
   };
 
+  /**
+   * @brief Metadata of the latest version of a library element
+   *
+   * @see #getLatestInfos()
+   */
+  struct ElementInfo {
+    FilePath filePath;  ///< Directory of the element
+    QString name;  ///< Name in the requested locale
+    bool deprecated;  ///< Deprecation flag
+    tl::optional<Uuid> componentUuid;  ///< Component (devices only)
+    tl::optional<Uuid> packageUuid;  ///< Package (devices only)
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb() = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -165,22 +178,55 @@ public:
    * @param uuid  The UUID of the element to get.
    *
    * @return  Filepath of the element with the highest version number and the
-   *          specified UUID. If no element is found, an invalid filepath
-   *          will be returned.
+   *          specified UUID. If several elements have the highest version
+   *          number, the one with the lowest filepath is returned. If no
+   *          element is found, an invalid filepath will be returned.
    */
   template <typename ElementType>
   FilePath getLatest(const Uuid& uuid) const {
     return getLatestVersionFilePath(getAll<ElementType>(uuid));
   }
 
+  /**
+   * @brief Get metadata of the latest version of many elements at once
+   *
+   * This returns the same information as calling #getLatest(),
+   * #getTranslations(), #getMetadata() and #getDeviceMetadata() for each
+   * element, but needs only a single database query instead of several
+   * queries per element. Use this whenever a whole list of elements needs to
+   * be displayed, e.g. search results.
+   *
+   * @tparam ElementType  Type of the library elements.
+   *
+   * @param uuids         UUIDs of the elements to get.
+   * @param localeOrder   Locale order (highest priority first) for the name.
+   *
+   * @return  Metadata of the latest version of each element, by UUID.
+   *          Elements not found in the database are not contained.
+   */
+  template <typename ElementType>
+  QHash<Uuid, ElementInfo> getLatestInfos(
+      const QList<Uuid>& uuids, const QStringList& localeOrder) const {
+    return getLatestInfos(getTable<ElementType>(), uuids, localeOrder);
+  }
+
   /**
    * @brief Find elements by keyword
    *
+   * If available, the full-text search index is used to find all elements
+   * containing each word of the keyword (in any order), sorted by relevance.
+   * Depending on the SQLite version, the index contains either all substrings
+   * (e.g. "0603" in "R0603") or only word prefixes. Only if the index finds
+   * nothing (or words shorter than 3 characters are searched in a substring
+   * index), elements containing the whole keyword anywhere are searched
+   * without index, sorted alphabetically and limited to
+   * #sMaxFallbackResults elements.
+   *
    * @param keyword   Keyword to search for. Note that the translations for
    *                  all languages will be taken into account.
    *
-   * @return  UUIDs of elements matching the filter, sorted alphabetically
-   *          and without duplicates. Empty if no elements were found.
+   * @return  UUIDs of elements matching the filter, without duplicates.
+   *          Empty if no elements were found.
    */
   template <typename ElementType>
   QList<Uuid> find(const QString& keyword) const {
@@ -190,11 +236,13 @@ public:
   /**
    * @brief Find parts by keyword
    *
+   * Uses the full-text search index if available, see #find().
+   *
    * @param keyword   Keyword to search for.
    *
-   * @return  All devices which contain parts matching the filter, sorted
-   *          alphabetically and without duplicates. Empty if no elements
-   *          were found.
+   * @return  All devices which contain parts matching the filter, sorted as
+   *          described in #find() and without duplicates. Empty if no
+   *          elements were found.
    */
   QList<Uuid> findDevicesOfParts(const QString& keyword) const;
 
@@ -374,6 +422,17 @@ public:
    */
   QSet<Uuid> getComponentDevices(const Uuid& component) const;
 
+  /**
+   * @brief Get all devices of many components at once
+   *
+   * @param components  Component UUIDs to get the devices of.
+   *
+   * @return  UUIDs of devices, by component UUID. Components without any
+   *          device are not contained.
+   */
+  QHash<Uuid, QSet<Uuid>> getComponentDevices(
+      const QList<Uuid>& components) const;
+
   /**
    * @brief Get all parts of a specific device
    *
@@ -402,12 +461,22 @@ signals:
   void scanFinished();
 
 private:
+  // Types
+  enum class FullTextIndex {
+    None,  ///< No full-text search index available
+    WordPrefix,  ///< Index of word prefixes
+    Trigram,  ///< Index of all substrings with at least 3 characters
+  };
+
   // Private Methods
   QMultiMap<Version, FilePath> getAll(const QString& elementsTable,
                                       const tl::optional<Uuid>& uuid,
                                       const FilePath& lib) const;
   FilePath getLatestVersionFilePath(
       const QMultiMap<Version, FilePath>& list) const noexcept;
+  QHash<Uuid, ElementInfo> getLatestInfos(
+      const QString& elementsTable, const QList<Uuid>& uuids,
+      const QStringList& localeOrder) const;
   QList<Uuid> find(const QString& elementsTable, const QString& keyword) const;
   bool getTranslations(const QString& elementsTable, const FilePath& elemDir,
                        const QStringList& localeOrder, QString* name,
@@ -424,7 +493,13 @@ private:
                            const QString& categoryTable,
                            const tl::optional<Uuid>& category, int limit) const;
   static QSet<Uuid> getUuidSet(QSqlQuery& query);
+  static QList<QList<Uuid>> splitIntoChunks(const QList<Uuid>& uuids) noexcept;
+  static QString getPlaceholders(int count) noexcept;
+  static void bindUuids(QSqlQuery& query, const QList<Uuid>& uuids) noexcept;
   int getDbVersion() const noexcept;
+  FullTextIndex getFullTextIndex() const noexcept;
+  static QString toFullTextQuery(const QString& keyword,
+                                 FullTextIndex index) noexcept;
   template <typename ElementType>
   static QString getTable() noexcept;
   template <typename ElementType>
@@ -434,10 +509,12 @@ private:
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
   const FilePath mFilePath;  ///< Path to the SQLite database file.
   QScopedPointer<SQLiteDatabase> mDb;  ///< The SQLite database.
+  FullTextIndex mFullTextIndex;  ///< Type of the full-text search index.
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
 
   // Constants
-  static const int sCurrentDbVersion = 5;
+  static const int sCurrentDbVersion = 7;
+  static const int sMaxFallbackResults = 500;  ///< Limit of non-index search
 };
 
 /*******************************************************************************
@@ -103,6 +103,8 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
+      "`content_hash` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
@@ -126,6 +128,8 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
+      "`content_hash` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
@@ -149,6 +153,8 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
+      "`content_hash` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL"
@@ -179,6 +185,8 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
+      "`content_hash` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL"
@@ -217,6 +225,8 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
+      "`content_hash` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL"
@@ -247,6 +257,8 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`library_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT, "
+      "`content_hash` TEXT, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
@@ -296,6 +308,94 @@ void WorkspaceLibraryDbWriter::createAllTables() {
     QSqlQuery query = mDb.prepareQuery(string);
     mDb.exec(query);
   }
+
+  // Full-text search index (optional, requires SQLite with FTS5 support). The
+  // trigram tokenizer (SQLite >= 3.34) also finds substrings in the middle of
+  // words, older versions only support a word prefix index.
+  try {
+    createFullTextIndex("tokenize='trigram'");  // can throw
+  } catch (const Exception&) {
+    try {
+      createFullTextIndex("prefix='1 2 3'");  // can throw
+      qInfo() << "SQLite does not support the trigram tokenizer, using a word "
+                 "prefix index for the library search.";
+    } catch (const Exception& e) {
+      qWarning() << "Could not create full-text search index of the library "
+                    "database, falling back to slow search:"
+                 << e.getMsg();
+    }
+  }
+}
+
+void WorkspaceLibraryDbWriter::createFullTextIndex(const QString& options) {
+  QStringList queries;
+
+  // Translations of all element types. The index is kept in sync with the
+  // "*_tr" tables by triggers, which also fire on cascaded deletes. The row ID
+  // of each index entry is the ID of the corresponding translation.
+  const QStringList elementTables = {
+      "libraries", "component_categories", "package_categories", "symbols",
+      "packages",  "components",           "devices",
+  };
+  foreach (const QString& table, elementTables) {
+    queries << QString(
+                   "CREATE VIRTUAL TABLE IF NOT EXISTS %1_fts USING fts5("
+                   "element_id UNINDEXED, name, keywords, %2)")
+                   .arg(table, options);
+    queries << QString(
+                   "CREATE TRIGGER IF NOT EXISTS %1_tr_fts_insert "
+                   "AFTER INSERT ON %1_tr BEGIN "
+                   "INSERT INTO %1_fts (rowid, element_id, name, keywords) "
+                   "VALUES (new.id, new.element_id, new.name, new.keywords); "
+                   "END")
+                   .arg(table);
+    queries << QString(
+                   "CREATE TRIGGER IF NOT EXISTS %1_tr_fts_delete "
+                   "AFTER DELETE ON %1_tr BEGIN "
+                   "DELETE FROM %1_fts WHERE rowid = old.id; "
+                   "END")
+                   .arg(table);
+  }
+
+  // Alternative package names.
+  queries << QString(
+                 "CREATE VIRTUAL TABLE IF NOT EXISTS packages_alt_fts "
+                 "USING fts5("
+                 "package_id UNINDEXED, name, %1)")
+                 .arg(options);
+  queries << QString(
+      "CREATE TRIGGER IF NOT EXISTS packages_alt_fts_insert "
+      "AFTER INSERT ON packages_alt BEGIN "
+      "INSERT INTO packages_alt_fts (rowid, package_id, name) "
+      "VALUES (new.id, new.package_id, new.name); "
+      "END");
+  queries << QString(
+      "CREATE TRIGGER IF NOT EXISTS packages_alt_fts_delete "
+      "AFTER DELETE ON packages_alt BEGIN "
+      "DELETE FROM packages_alt_fts WHERE rowid = old.id; "
+      "END");
+
+  // Parts.
+  queries << QString(
+                 "CREATE VIRTUAL TABLE IF NOT EXISTS parts_fts USING fts5("
+                 "device_id UNINDEXED, mpn, manufacturer, %1)")
+                 .arg(options);
+  queries << QString(
+      "CREATE TRIGGER IF NOT EXISTS parts_fts_insert "
+      "AFTER INSERT ON parts BEGIN "
+      "INSERT INTO parts_fts (rowid, device_id, mpn, manufacturer) "
+      "VALUES (new.id, new.device_id, new.mpn, new.manufacturer); "
+      "END");
+  queries << QString(
+      "CREATE TRIGGER IF NOT EXISTS parts_fts_delete "
+      "AFTER DELETE ON parts BEGIN "
+      "DELETE FROM parts_fts WHERE rowid = old.id; "
+      "END");
+
+  foreach (const QString& string, queries) {
+    QSqlQuery query = mDb.prepareQuery(string);
+    mDb.exec(query);
+  }
 }
 
 void WorkspaceLibraryDbWriter::addInternalData(const QString& key, int value) {
@@ -510,6 +610,22 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
   return mDb.insert(query);
 }
 
+void WorkspaceLibraryDbWriter::setElementFingerprint(
+    const QString& elementsTable, int elementId, const QString& fingerprint,
+    const QString& contentHash) {
+  QSqlQuery query = mDb.prepareQuery(
+      "UPDATE %elements "
+      "SET fingerprint = :fingerprint, content_hash = :content_hash "
+      "WHERE id = :id",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":id", elementId);
+  query.bindValue(":fingerprint", fingerprint);
+  query.bindValue(":content_hash", contentHash);
+  mDb.exec(query);
+}
+
 void WorkspaceLibraryDbWriter::removeElement(const QString& elementsTable,
                                              const FilePath& fp) {
   QSqlQuery query = mDb.prepareQuery(
@@ -68,6 +68,11 @@ public:
    * @brief Create all tables to initialize the database
    *
    * This has to be done only once, after creating a new database.
+   *
+   * If supported by SQLite, a full-text search index is created as well. It
+   * is updated automatically (by triggers) whenever translations, alternative
+   * package names or parts are added or removed. If available, the trigram
+   * tokenizer is used to index substrings, otherwise only word prefixes.
    */
   void createAllTables();
 
@@ -188,6 +193,25 @@ public:
    */
   int addPartAttribute(int partId, const Attribute& attribute);
 
+  /**
+   * @brief Set the fingerprint of a previously added library element
+   *
+   * The fingerprint is used by ::librepcb::WorkspaceLibraryScanner to detect
+   * whether an element needs to be parsed again during the next scan.
+   *
+   * @tparam ElementType  Type of element to set the fingerprint.
+   * @param elementId     ID of the element to set the fingerprint.
+   * @param fingerprint   Fingerprint of the file metadata (paths, sizes and
+   *                      modification times) of the element directory.
+   * @param contentHash   Hash of the file contents of the element directory.
+   */
+  template <typename ElementType>
+  void setElementFingerprint(int elementId, const QString& fingerprint,
+                             const QString& contentHash) {
+    setElementFingerprint(getElementTable<ElementType>(), elementId,
+                          fingerprint, contentHash);
+  }
+
   /**
    * @brief Remove a library element
    *
@@ -300,11 +324,15 @@ public:
       delete;
 
 private:  // Methods
+  void createFullTextIndex(const QString& options);
   int addElement(const QString& elementsTable, int libId, const FilePath& fp,
                  const Uuid& uuid, const Version& version, bool deprecated);
   int addCategory(const QString& categoriesTable, int libId, const FilePath& fp,
                   const Uuid& uuid, const Version& version, bool deprecated,
                   const tl::optional<Uuid>& parent);
+  void setElementFingerprint(const QString& elementsTable, int elementId,
+                             const QString& fingerprint,
+                             const QString& contentHash);
   void removeElement(const QString& elementsTable, const FilePath& fp);
   void removeAllElements(const QString& elementsTable);
   int addTranslation(const QString& elementsTable, int elementId,
@@ -32,11 +32,15 @@
 #include "../library/pkg/package.h"
 #include "../library/sym/symbol.h"
 #include "../sqlitedatabase.h"
+#include "../utils/scopeguard.h"
 #include "../utils/toolbox.h"
 #include "workspacelibrarydbwriter.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -51,6 +55,7 @@ WorkspaceLibraryScanner::WorkspaceLibraryScanner(
   : QThread(nullptr),
     mLibrariesPath(librariesPath),
     mDbFilePath(dbFilePath),
+    mThreadPool(),
     mSemaphore(0),
     mAbort(false),
     mLastProgressPercent(100) {
@@ -127,52 +132,76 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    writer.removeAllElements<ComponentCategory>();
-    writer.removeAllElements<PackageCategory>();
-    writer.removeAllElements<Symbol>();
-    writer.removeAllElements<Package>();
-    writer.removeAllElements<Component>();
-    writer.removeAllElements<Device>();
+    // get all elements currently contained in the database, to update only
+    // the added, modified and removed elements
+    QHash<FilePath, DbElement> cmpCats =
+        getElementsFromDb<ComponentCategory>(db);  // can throw
+    QHash<FilePath, DbElement> pkgCats =
+        getElementsFromDb<PackageCategory>(db);  // can throw
+    QHash<FilePath, DbElement> symbols =
+        getElementsFromDb<Symbol>(db);  // can throw
+    QHash<FilePath, DbElement> packages =
+        getElementsFromDb<Package>(db);  // can throw
+    QHash<FilePath, DbElement> components =
+        getElementsFromDb<Component>(db);  // can throw
+    QHash<FilePath, DbElement> devices =
+        getElementsFromDb<Device>(db);  // can throw
 
     // scan all libraries
     int count = 0;
+    int parsedCount = 0;
     qreal percent = 1;
     foreach (const std::shared_ptr<Library>& lib, libraries) {
       FilePath fp = lib->getDirectory().getAbsPath();
       Q_ASSERT(libIds.contains(fp));
       int libId = libIds[fp];
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<ComponentCategory>(
-          writer, fp, lib->searchForElements<ComponentCategory>(), libId);
+      count += updateElementsInDb<ComponentCategory>(
+          writer, fp, lib->searchForElements<ComponentCategory>(), libId,
+          cmpCats, parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<PackageCategory>(
-          writer, fp, lib->searchForElements<PackageCategory>(), libId);
+      count += updateElementsInDb<PackageCategory>(
+          writer, fp, lib->searchForElements<PackageCategory>(), libId, pkgCats,
+          parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Symbol>(writer, fp,
-                                       lib->searchForElements<Symbol>(), libId);
+      count += updateElementsInDb<Symbol>(
+          writer, fp, lib->searchForElements<Symbol>(), libId, symbols,
+          parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Package>(
-          writer, fp, lib->searchForElements<Package>(), libId);
+      count += updateElementsInDb<Package>(
+          writer, fp, lib->searchForElements<Package>(), libId, packages,
+          parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Component>(
-          writer, fp, lib->searchForElements<Component>(), libId);
+      count += updateElementsInDb<Component>(
+          writer, fp, lib->searchForElements<Component>(), libId, components,
+          parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Device>(writer, fp,
-                                       lib->searchForElements<Device>(), libId);
+      count += updateElementsInDb<Device>(
+          writer, fp, lib->searchForElements<Device>(), libId, devices,
+          parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
+    // remove elements which do not exist anymore
+    if ((!mAbort) && (mSemaphore.available() == 0)) {
+      removeElementsFromDb<ComponentCategory>(writer, cmpCats);  // can throw
+      removeElementsFromDb<PackageCategory>(writer, pkgCats);  // can throw
+      removeElementsFromDb<Symbol>(writer, symbols);  // can throw
+      removeElementsFromDb<Package>(writer, packages);  // can throw
+      removeElementsFromDb<Component>(writer, components);  // can throw
+      removeElementsFromDb<Device>(writer, devices);  // can throw
+    }
+
     // commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
       transactionGuard.commit();  // can throw
-      qDebug() << "Workspace library scan succeeded:" << count << "elements in"
-               << timer.elapsed() << "ms.";
+      qDebug() << "Workspace library scan succeeded:" << count << "elements ("
+               << parsedCount << "parsed) in" << timer.elapsed() << "ms.";
       emit scanSucceeded(count);
     } else {
       qDebug() << "Workspace library scan aborted after" << timer.elapsed()
@@ -265,28 +294,155 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(WorkspaceLibraryDbWriter& writer,
-                                             const FilePath& libPath,
-                                             const QStringList& dirs,
-                                             int libId) {
-  int count = 0;
+QHash<FilePath, WorkspaceLibraryScanner::DbElement>
+    WorkspaceLibraryScanner::getElementsFromDb(SQLiteDatabase& db) {
+  QHash<FilePath, DbElement> elements;
+  QSqlQuery query = db.prepareQuery(
+      "SELECT id, library_id, filepath, fingerprint, content_hash "
+      "FROM %elements",
+      {
+          {"%elements",
+           WorkspaceLibraryDbWriter::getElementTable<ElementType>()},
+      });
+  db.exec(query);
+  while (query.next()) {
+    FilePath fp = mLibrariesPath.getPathTo(query.value(2).toString());
+    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
+    elements.insert(fp,
+                    DbElement{query.value(0).toInt(), query.value(1).toInt(),
+                              query.value(3).toString(),
+                              query.value(4).toString()});
+  }
+  return elements;
+}
+
+template <typename ElementType>
+int WorkspaceLibraryScanner::updateElementsInDb(
+    WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
+    const QStringList& dirs, int libId, QHash<FilePath, DbElement>& dbElements,
+    int& parsedCount) {
+  typedef ElementJob<ElementType> Job;
+
+  // Prepare the jobs. Elements still contained in dbElements after the scan
+  // will be removed from the database.
+  QVector<std::shared_ptr<Job>> jobs;
   foreach (const QString& dirpath, dirs) {
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->fp = libPath.getPathTo(dirpath);
+    if (dbElements.contains(job->fp)) {
+      job->dbElement = dbElements.take(job->fp);
+    }
+    job->success = false;
+    jobs.append(job);
+  }
+
+  // Check and parse the elements in parallel, but limit the number of jobs in
+  // flight to keep the memory usage of parsed elements low.
+  const int maxJobsInFlight = std::max(mThreadPool.maxThreadCount(), 1) * 4;
+  QVector<QFuture<void>> futures;
+  auto startJobs = [&](int finishedJobs) {
+    while ((futures.count() < jobs.count()) &&
+           (futures.count() < finishedJobs + maxJobsInFlight)) {
+      std::shared_ptr<Job> job = jobs.at(futures.count());
+      futures.append(QtConcurrent::run(&mThreadPool, [this, job, libId]() {
+        prepareElement(*job, libId);
+      }));
+    }
+  };
+
+  // Already started jobs reference this object, so wait for them to finish
+  // before leaving (also on abort or errors).
+  auto sg = scopeGuard([&futures]() {
+    for (QFuture<void>& future : futures) {
+      future.waitForFinished();
+    }
+  });
+
+  // Write the results to the database in the scanner thread, since SQLite
+  // requires serial access.
+  int count = 0;
+  for (int i = 0; i < jobs.count(); ++i) {
+    startJobs(i);
+    futures[i].waitForFinished();
     if (mAbort || (mSemaphore.available() > 0)) break;
-    const FilePath fp = libPath.getPathTo(dirpath);
-    try {
-      std::unique_ptr<ElementType> element =
-          openAndMigrate<ElementType>(fp);  // can throw
-      int id = addElementToDb(writer, libId, *element);
-      addTranslationsToDb(writer, id, *element);
-      count++;
-    } catch (const Exception& e) {
+    std::shared_ptr<Job> job = jobs.at(i);
+    jobs[i].reset();  // Release the element as soon as possible.
+    if (!job->success) {
       qWarning() << "Failed to open library element during scan:"
-                 << fp.toNative();
+                 << job->fp.toNative();
+      // Make sure the element gets removed from the database.
+      if (job->dbElement) {
+        dbElements.insert(job->fp, *job->dbElement);
+      }
+    } else if (job->element) {
+      if (job->dbElement) {
+        writer.removeElement<ElementType>(job->fp);  // can throw
+      }
+      const int id = addElementToDb(writer, libId, *job->element);
+      addTranslationsToDb(writer, id, *job->element);
+      writer.setElementFingerprint<ElementType>(id, job->fingerprint,
+                                                job->contentHash);
+      count++;
+      parsedCount++;
+    } else {
+      Q_ASSERT(job->dbElement);
+      if (job->dbElement->fingerprint != job->fingerprint) {
+        writer.setElementFingerprint<ElementType>(
+            job->dbElement->id, job->fingerprint, job->contentHash);
+      }
+      count++;
     }
   }
   return count;
 }
 
+template <typename ElementType>
+void WorkspaceLibraryScanner::prepareElement(ElementJob<ElementType>& job,
+                                             int libId) noexcept {
+  // Note: This method is called from the thread pool, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+  if (mAbort || (mSemaphore.available() > 0)) {
+    return;
+  }
+
+  try {
+    // Skip the element if its files were not modified since the last scan.
+    const bool sameLibrary = job.dbElement && (job.dbElement->libId == libId);
+    job.fingerprint = calcFingerprint(job.fp);  // can throw
+    if (sameLibrary && (!job.dbElement->fingerprint.isEmpty()) &&
+        (job.dbElement->fingerprint == job.fingerprint)) {
+      job.contentHash = job.dbElement->contentHash;
+      job.success = true;
+      return;
+    }
+    job.contentHash = calcContentHash(job.fp);  // can throw
+    if (sameLibrary && (!job.dbElement->contentHash.isEmpty()) &&
+        (job.dbElement->contentHash == job.contentHash)) {
+      job.success = true;
+      return;
+    }
+
+    // Parse the element. The files might be modified by the file format
+    // migration, so the fingerprint needs to be calculated again afterwards.
+    job.element = openAndMigrate<ElementType>(job.fp);  // can throw
+    job.fingerprint = calcFingerprint(job.fp);  // can throw
+    job.contentHash = calcContentHash(job.fp);  // can throw
+    job.success = true;
+  } catch (const Exception& e) {
+    job.element.reset();
+    job.success = false;
+  }
+}
+
+template <typename ElementType>
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    WorkspaceLibraryDbWriter& writer,
+    const QHash<FilePath, DbElement>& dbElements) {
+  foreach (const FilePath& fp, dbElements.keys()) {
+    writer.removeElement<ElementType>(fp);  // can throw
+  }
+}
+
 template <typename ElementType>
 int WorkspaceLibraryScanner::addElementToDb(WorkspaceLibraryDbWriter& writer,
                                             int libId,
@@ -395,6 +551,49 @@ std::unique_ptr<ElementType> WorkspaceLibraryScanner::openAndMigrate(
   return element;
 }
 
+QList<FilePath> WorkspaceLibraryScanner::getElementFiles(
+    const FilePath& dir) {
+  QList<FilePath> files;
+  foreach (const FilePath& fp,
+           FileUtils::getFilesInDirectory(dir, {}, true, false)) {
+    // Ignore the lock file as it is created and removed when opening an
+    // element in the library editor.
+    if (fp.getFilename() != ".lock") {
+      files.append(fp);
+    }
+  }
+  std::sort(files.begin(), files.end(),
+            [](const FilePath& a, const FilePath& b) {
+              return a.toStr() < b.toStr();
+            });
+  return files;
+}
+
+QString WorkspaceLibraryScanner::calcFingerprint(const FilePath& dir) {
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  foreach (const FilePath& fp, getElementFiles(dir)) {
+    const QFileInfo info(fp.toStr());
+    hash.addData(fp.toRelative(dir).toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(QByteArray::number(info.size()).append(';'));
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    hash.addData(QByteArray::number(modified).append(';'));
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+QString WorkspaceLibraryScanner::calcContentHash(const FilePath& dir) {
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  foreach (const FilePath& fp, getElementFiles(dir)) {
+    const QByteArray content = FileUtils::readFile(fp);  // can throw
+    hash.addData(fp.toRelative(dir).toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(QByteArray::number(content.size()).append(';'));
+    hash.addData(content);
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "../fileio/filepath.h"
 
+#include <optional/tl/optional.hpp>
+
 #include <QtCore>
 
 #include <memory>
@@ -45,6 +47,19 @@ class WorkspaceLibraryDbWriter;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * Scans the workspace libraries and updates the library database
+ * incrementally: For each library element, a fingerprint of its files (paths,
+ * sizes and modification times) is stored in the database. Elements with an
+ * unchanged fingerprint are not parsed again. If only the fingerprint changed
+ * (e.g. files were touched), a hash of the file contents is compared too, to
+ * avoid parsing elements which were not modified at all. Only added and
+ * modified elements are parsed, and elements which do not exist anymore are
+ * removed from the database.
+ *
+ * Checking and parsing the elements is done in parallel on a thread pool,
+ * while the results are written to the database serially by the scanner
+ * thread, in the same order as the elements were found.
+ *
  * @warning Be very careful with dependencies to other objects as the #run()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
@@ -77,6 +92,24 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  struct DbElement {
+    int id;
+    int libId;
+    QString fingerprint;
+    QString contentHash;
+  };
+
+  template <typename ElementType>
+  struct ElementJob {
+    FilePath fp;
+    tl::optional<DbElement> dbElement;
+    QString fingerprint;
+    QString contentHash;
+    std::unique_ptr<ElementType> element;  ///< Only set if (re-)parsed
+    bool success;
+  };
+
 private:  // Methods
   void run() noexcept override;
   void scan() noexcept;
@@ -87,8 +120,17 @@ private:  // Methods
       SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
       const QList<std::shared_ptr<Library>>& libs);
   template <typename ElementType>
-  int addElementsToDb(WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
-                      const QStringList& dirs, int libId);
+  QHash<FilePath, DbElement> getElementsFromDb(SQLiteDatabase& db);
+  template <typename ElementType>
+  int updateElementsInDb(WorkspaceLibraryDbWriter& writer,
+                         const FilePath& libPath, const QStringList& dirs,
+                         int libId, QHash<FilePath, DbElement>& dbElements,
+                         int& parsedCount);
+  template <typename ElementType>
+  void prepareElement(ElementJob<ElementType>& job, int libId) noexcept;
+  template <typename ElementType>
+  void removeElementsFromDb(WorkspaceLibraryDbWriter& writer,
+                            const QHash<FilePath, DbElement>& dbElements);
   template <typename ElementType>
   int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
                      const ElementType& element);
@@ -100,10 +142,14 @@ private:  // Methods
                        const ElementType& element);
   template <typename ElementType>
   std::unique_ptr<ElementType> openAndMigrate(const FilePath& fp);
+  static QList<FilePath> getElementFiles(const FilePath& dir);
+  static QString calcFingerprint(const FilePath& dir);
+  static QString calcContentHash(const FilePath& dir);
 
 private:  // Data
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
   const FilePath mDbFilePath;  ///< Path to the SQLite database file.
+  QThreadPool mThreadPool;  ///< Used to parse elements in parallel.
   QSemaphore mSemaphore;
   volatile bool mAbort;
   int mLastProgressPercent;
@@ -25,6 +25,8 @@
 #include "opengltriangleobject.h"
 
 #include <librepcb/core/3d/occmodel.h>
+#include <librepcb/core/3d/stepmodelcache.h>
+#include <librepcb/core/application.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/filesystem.h>
 #include <librepcb/core/fileio/fileutils.h>
@@ -58,7 +60,12 @@ namespace editor {
  ******************************************************************************/
 
 OpenGlSceneBuilder::OpenGlSceneBuilder(QObject* parent) noexcept
-  : QObject(parent), mMaxArcTolerance(5000), mFuture(), mAbort(false) {
+  : QObject(parent),
+    mMaxArcTolerance(5000),
+    mFuture(),
+    mAbort(false),
+    mStepModelCache(new StepModelCache(
+        Application::getCacheDir().getPathTo("3d"), 500 * 1024 * 1024)) {
   qRegisterMetaType<std::shared_ptr<OpenGlObject>>();
 }
 
@@ -267,12 +274,11 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
     // Add/update devices.
     QSet<Uuid> deviceUuids;
     if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
+      publishDevices(*fs, data->getDevices(), d + 0.067, scaleFactor,
+                     data->getStepAlphaValue());
+      if (mAbort) return;
       for (const auto& obj : data->getDevices()) {
-        const QByteArray content = fs->readIfExists(obj.stepFile);
-        publishDevice(obj, content, d + 0.067, scaleFactor,
-                      data->getStepAlphaValue());
         deviceUuids.insert(obj.uuid);
-        if (mAbort) return;
       }
     }
 
@@ -410,25 +416,75 @@ void OpenGlSceneBuilder::publishTriangleData(
   }
 }
 
-void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
-                                       const QByteArray& stepContent, qreal z,
-                                       qreal scaleFactor, qreal alpha) {
-  StepModel model;
-  if (mStepModels.contains(stepContent)) {
-    model = mStepModels.value(stepContent);
-  } else {
-    if (stepContent.size()) {
-      try {
-        std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
-        model = occModel->tesselate();
-      } catch (const Exception& e) {
-        qCritical().nospace()
-            << "Failed to draw 3D model of " << obj.name << ": " << e.getMsg();
+void OpenGlSceneBuilder::publishDevices(
+    FileSystem& fs, const QList<SceneData3D::DeviceData>& devices, qreal z,
+    qreal scaleFactor, qreal alpha) {
+  // Publish devices with already loaded models immediately and group all
+  // other devices by their STEP model, to load each model only once.
+  QList<QByteArray> pendingModels;  // In order of first occurrence.
+  QHash<QByteArray, QList<const SceneData3D::DeviceData*>> pendingDevices;
+  for (const auto& obj : devices) {
+    const QByteArray content = fs.readIfExists(obj.stepFile);
+    auto it = mStepMeshes.constFind(content);
+    if (it != mStepMeshes.constEnd()) {
+      publishDevice(obj, *it, z, scaleFactor, alpha);
+    } else {
+      if (!pendingDevices.contains(content)) {
+        pendingModels.append(content);
+      }
+      pendingDevices[content].append(&obj);
+    }
+    if (mAbort) return;
+  }
+
+  // Load and tesselate the models in parallel and publish the corresponding
+  // devices as soon as each model is finished. Use a private thread pool
+  // since this method itself is run within the global thread pool.
+  QThreadPool pool;
+  QMutex mutex;
+  QWaitCondition modelFinishedCondition;
+  QQueue<std::pair<QByteArray, StepModel>> finishedModels;
+  auto sg = scopeGuard([&pool]() {
+    pool.clear();  // Don't start any more models if aborted.
+    pool.waitForDone();
+  });
+  foreach (const QByteArray& content, pendingModels) {
+    const QString name = pendingDevices.value(content).first()->name;
+    QtConcurrent::run(&pool, [&, content, name]() {
+      const StepModel model = loadStepModel(content, name);
+      QMutexLocker lock(&mutex);
+      finishedModels.enqueue(std::make_pair(content, model));
+      modelFinishedCondition.wakeAll();
+    });
+  }
+  for (int i = 0; i < pendingModels.count(); ++i) {
+    std::pair<QByteArray, StepModel> result;
+    {
+      QMutexLocker lock(&mutex);
+      while (finishedModels.isEmpty()) {
+        if (mAbort) return;
+        modelFinishedCondition.wait(&mutex, 100);
       }
+      result = finishedModels.dequeue();
     }
-    mStepModels.insert(stepContent, model);
+    // The vertex data is shared by all devices using the same model, each
+    // device only gets its own transformation.
+    StepMesh mesh;
+    for (auto it = result.second.begin(); it != result.second.end(); ++it) {
+      mesh.insert(it.key(), std::make_shared<OpenGlTriangleData>(it.value()));
+    }
+    mStepMeshes.insert(result.first, mesh);
+    foreach (const SceneData3D::DeviceData* obj,
+             pendingDevices.value(result.first)) {
+      publishDevice(*obj, mesh, z, scaleFactor, alpha);
+    }
+    if (mAbort) return;
   }
+}
 
+void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
+                                       const StepMesh& mesh, qreal z,
+                                       qreal scaleFactor, qreal alpha) {
   QMatrix4x4 m;
   m.scale(scaleFactor);
   m.translate(obj.transform.getPosition().getX().toMm(),
@@ -448,15 +504,11 @@ void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
   QMap<Color, std::shared_ptr<OpenGlTriangleObject>>& items =
       mDevices[obj.uuid];
   foreach (const Color& color, items.keys()) {
-    if (!model.contains(color)) {
+    if (!mesh.contains(color)) {
       emit objectRemoved(items.take(color));
     }
   }
-  for (auto it = model.begin(); it != model.end(); it++) {
-    QVector<QVector3D> vertices = it.value();
-    for (auto& vertex : vertices) {
-      vertex = m.map(vertex);
-    }
+  for (auto it = mesh.begin(); it != mesh.end(); it++) {
     std::shared_ptr<OpenGlTriangleObject> obj = items.value(it.key());
     QColor color = QColor::fromRgbF(
         std::get<0>(it.key()), std::get<1>(it.key()), std::get<2>(it.key()));
@@ -464,17 +516,41 @@ void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
       color.setAlphaF(alpha);
     }
     if (obj) {
-      obj->setData(color, vertices);
+      obj->setData(color, it.value(), m);
       emit objectUpdated(obj);
     } else {
       obj = std::make_shared<OpenGlTriangleObject>();
-      obj->setData(color, vertices);
+      obj->setData(color, it.value(), m);
       items[it.key()] = obj;
       emit objectAdded(obj);
     }
   }
 }
 
+OpenGlSceneBuilder::StepModel OpenGlSceneBuilder::loadStepModel(
+    const QByteArray& stepContent, const QString& name) const noexcept {
+  // Note: This method is called from different threads in parallel!
+  StepModel model;
+  if (stepContent.isEmpty()) {
+    return model;
+  }
+  if (tl::optional<StepModel> cached = mStepModelCache->load(stepContent)) {
+    model = *cached;
+  } else {
+    try {
+      // Note: OccModel serializes only the accesses to global OpenCascade
+      // state, the rest of loading and tesselating runs in parallel.
+      std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
+      model = occModel->tesselate();
+      mStepModelCache->store(stepContent, model);
+    } catch (const Exception& e) {
+      qCritical().nospace()
+          << "Failed to draw 3D model of " << name << ": " << e.getMsg();
+    }
+  }
+  return model;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -34,9 +34,14 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
+
+class FileSystem;
+class StepModelCache;
+
 namespace editor {
 
 class OpenGlObject;
+class OpenGlTriangleData;
 class OpenGlTriangleObject;
 
 /*******************************************************************************
@@ -53,6 +58,7 @@ public:
   // Types
   typedef std::tuple<qreal, qreal, qreal> Color;
   typedef QMap<Color, QVector<QVector3D>> StepModel;
+  typedef QMap<Color, std::shared_ptr<OpenGlTriangleData>> StepMesh;
 
   // Constructors / Destructor
   OpenGlSceneBuilder(QObject* parent = nullptr) noexcept;
@@ -105,19 +111,25 @@ private:  // Methods
                                       qreal scaleFactor);
   void publishTriangleData(const QString& id, const QColor& color,
                            const QVector<QVector3D>& triangles);
+  void publishDevices(FileSystem& fs,
+                      const QList<SceneData3D::DeviceData>& devices, qreal z,
+                      qreal scaleFactor, qreal alpha);
   void publishDevice(const SceneData3D::DeviceData& obj,
-                     const QByteArray& stepContent, qreal z, qreal scaleFactor,
+                     const StepMesh& mesh, qreal z, qreal scaleFactor,
                      qreal alpha);
+  StepModel loadStepModel(const QByteArray& stepContent,
+                          const QString& name) const noexcept;
 
 private:  // Data
   const PositiveLength mMaxArcTolerance;
   QFuture<void> mFuture;
   bool mAbort;
+  std::unique_ptr<StepModelCache> mStepModelCache;  ///< Persistent cache
 
   // Thread data.
   QHash<QString, std::shared_ptr<OpenGlTriangleObject>> mBoardObjects;
   QHash<Uuid, QMap<Color, std::shared_ptr<OpenGlTriangleObject>>> mDevices;
-  QHash<QByteArray, StepModel> mStepModels;  ///< Cache
+  QHash<QByteArray, StepMesh> mStepMeshes;  ///< Shared by all devices
 };
 
 /*******************************************************************************
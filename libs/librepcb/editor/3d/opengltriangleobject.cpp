@@ -31,20 +31,43 @@
 namespace librepcb {
 namespace editor {
 
+/*******************************************************************************
+ *  Class OpenGlTriangleData
+ ******************************************************************************/
+
+OpenGlTriangleData::OpenGlTriangleData(
+    const QVector<QVector3D>& triangles) noexcept
+  : mBuffer(QOpenGLBuffer::VertexBuffer),
+    mCount(triangles.count()),
+    mNewTriangles(triangles) {
+}
+
+OpenGlTriangleData::~OpenGlTriangleData() noexcept {
+  mBuffer.destroy();
+}
+
+int OpenGlTriangleData::bind() noexcept {
+  if (!mBuffer.isCreated()) {
+    mBuffer.create();
+    mBuffer.bind();
+    mBuffer.allocate(mNewTriangles.constData(),
+                     mNewTriangles.count() * sizeof(QVector3D));
+    mNewTriangles.clear();  // Not needed anymore, release memory.
+  } else {
+    mBuffer.bind();
+  }
+  return mCount;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 OpenGlTriangleObject::OpenGlTriangleObject() noexcept
-  : mBuffer(QOpenGLBuffer::VertexBuffer),
-    mCount(0),
-    mMutex(),
-    mColor(Qt::black),
-    mNewTriangles() {
+  : mMutex(), mColor(Qt::black), mData(), mTransform() {
 }
 
 OpenGlTriangleObject::~OpenGlTriangleObject() noexcept {
-  mBuffer.destroy();
 }
 
 /*******************************************************************************
@@ -53,35 +76,37 @@ OpenGlTriangleObject::~OpenGlTriangleObject() noexcept {
 
 void OpenGlTriangleObject::setData(const QColor& color,
                                    const QVector<QVector3D>& data) noexcept {
+  setData(color, std::make_shared<OpenGlTriangleData>(data), QMatrix4x4());
+}
+
+void OpenGlTriangleObject::setData(const QColor& color,
+                                   std::shared_ptr<OpenGlTriangleData> data,
+                                   const QMatrix4x4& transform) noexcept {
   QMutexLocker lock(&mMutex);
   mColor = color;
-  mNewTriangles = data;
+  mData = data;
+  mTransform = transform;
 }
 
 void OpenGlTriangleObject::draw(QOpenGLFunctions& gl,
                                 QOpenGLShaderProgram& program) noexcept {
-  // Update buffer, if needed.
+  std::shared_ptr<OpenGlTriangleData> data;
   {
     QMutexLocker lock(&mMutex);
-    if (!mBuffer.isCreated()) {
-      mBuffer.create();
-    }
-    mBuffer.bind();
-    if (mNewTriangles) {
-      mBuffer.allocate(mNewTriangles->data(),
-                       mNewTriangles->count() * sizeof(QVector3D));
-      mCount = mNewTriangles->count();
-      mNewTriangles = tl::nullopt;
-    }
+    data = mData;
+    program.setAttributeValue("a_color", mColor);
+    program.setUniformValue("model_matrix", mTransform);
+  }
+  if (!data) {
+    return;
   }
 
-  program.setAttributeValue("a_color", mColor);
-
-  mBuffer.bind();
+  // Upload data, if not done yet.
+  const int count = data->bind();
   int vertexLocation = program.attributeLocation("a_position");
   program.enableAttributeArray(vertexLocation);
   program.setAttributeBuffer(vertexLocation, GL_FLOAT, 0, 3, sizeof(QVector3D));
-  gl.glDrawArrays(GL_TRIANGLES, 0, mCount);
+  gl.glDrawArrays(GL_TRIANGLES, 0, count);
 }
 
 /*******************************************************************************
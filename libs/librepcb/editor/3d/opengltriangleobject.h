@@ -25,17 +25,56 @@
  ******************************************************************************/
 #include "openglobject.h"
 
-#include <optional/tl/optional.hpp>
-
 #include <QtCore>
 #include <QtOpenGL>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 namespace editor {
 
+/*******************************************************************************
+ *  Class OpenGlTriangleData
+ ******************************************************************************/
+
+/**
+ * @brief Vertex data of one or more ::librepcb::editor::OpenGlTriangleObject
+ *
+ * The data is uploaded to the GPU when it is drawn the first time. It can be
+ * shared between several objects with different transformations (e.g. all
+ * devices using the same 3D model) to store and upload it only once.
+ */
+class OpenGlTriangleData final {
+public:
+  // Constructors / Destructor
+  OpenGlTriangleData() = delete;
+  OpenGlTriangleData(const OpenGlTriangleData& other) = delete;
+  explicit OpenGlTriangleData(const QVector<QVector3D>& triangles) noexcept;
+  ~OpenGlTriangleData() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Bind the vertex buffer, uploading the data if not done yet
+   *
+   * @note Must be called with the OpenGL context being current.
+   *
+   * @return Number of vertices in the buffer.
+   */
+  int bind() noexcept;
+
+  // Operator Overloadings
+  OpenGlTriangleData& operator=(const OpenGlTriangleData& rhs) = delete;
+
+private:  // Data
+  QOpenGLBuffer mBuffer;
+  int mCount;
+  QVector<QVector3D> mNewTriangles;
+};
+
 /*******************************************************************************
  *  Class OpenGlTriangleObject
  ******************************************************************************/
@@ -52,6 +91,8 @@ public:
 
   // General Methods
   void setData(const QColor& color, const QVector<QVector3D>& data) noexcept;
+  void setData(const QColor& color, std::shared_ptr<OpenGlTriangleData> data,
+               const QMatrix4x4& transform) noexcept;
   virtual void draw(QOpenGLFunctions& gl,
                     QOpenGLShaderProgram& program) noexcept override;
 
@@ -59,12 +100,10 @@ public:
   OpenGlTriangleObject& operator=(const OpenGlTriangleObject& rhs) = delete;
 
 private:  // Data
-  QOpenGLBuffer mBuffer;
-  int mCount;
-
   QMutex mMutex;
   QColor mColor;
-  tl::optional<QVector<QVector3D>> mNewTriangles;
+  std::shared_ptr<OpenGlTriangleData> mData;
+  QMatrix4x4 mTransform;
 };
 
 /*******************************************************************************
@@ -101,6 +101,18 @@ QPixmap GraphicsScene::toPixmap(const QSize& size,
   return pixmap;
 }
 
+QSet<QGraphicsItem*> GraphicsScene::getItemsInRect(
+    const QRectF& rect) const noexcept {
+  QSet<QGraphicsItem*> result;
+  foreach (QGraphicsItem* item, items(rect, Qt::IntersectsItemBoundingRect)) {
+    // Group items (e.g. devices) are found through their children.
+    for (; item && (!result.contains(item)); item = item->parentItem()) {
+      result.insert(item);
+    }
+  }
+  return result;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -61,6 +61,20 @@ public:
   QPixmap toPixmap(const QSize& size,
                    const QColor& background = Qt::transparent) noexcept;
 
+  /**
+   * @brief Get all visible items located within a given area
+   *
+   * This uses the spatial index of the scene (which Qt keeps up to date when
+   * items are added, removed, moved or modified), thus it is much faster than
+   * iterating over all items of large scenes, e.g. for hit-testing.
+   *
+   * @param rect    The area to look for items (in scene coordinates).
+   *
+   * @return All items whose bounding rect intersects with the given area,
+   *         plus all their parent items.
+   */
+  QSet<QGraphicsItem*> getItemsInRect(const QRectF& rect) const noexcept;
+
 private:
   QGraphicsRectItem* mSelectionRectItem;
 };
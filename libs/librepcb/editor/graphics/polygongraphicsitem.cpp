@@ -109,6 +109,7 @@ QVector<int> PolygonGraphicsItem::getVertexIndicesAtPosition(
 void PolygonGraphicsItem::setEditable(bool editable) noexcept {
   mEditable = editable;
   updateBoundingRectMargin();
+  update();
 }
 
 QVariant PolygonGraphicsItem::itemChange(GraphicsItemChange change,
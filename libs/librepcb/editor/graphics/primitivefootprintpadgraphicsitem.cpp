@@ -77,6 +77,7 @@ PrimitiveFootprintPadGraphicsItem::PrimitiveFootprintPadGraphicsItem(
   mTextGraphicsItem->setLineWidth(UnsignedLength(100000));
   mTextGraphicsItem->setLighterColors(true);  // More contrast for readability.
   mTextGraphicsItem->setShapeMode(PrimitivePathGraphicsItem::ShapeMode::None);
+  mTextGraphicsItem->setHiddenBelowSizePx(8);  // Unreadable anyway.
   mTextGraphicsItem->setZValue(500);
 }
 
@@ -169,6 +170,7 @@ void PrimitiveFootprintPadGraphicsItem::setGeometries(
       item->setRotation(mOriginCrossGraphicsItem->rotation());
       item->setMirrored(mMirror);
       item->setPath(shape);
+      item->setSimplifiedBelowSizePx(4);  // Draw tiny pads as rects.
       item->setShapeMode(
           isCopperLayer ? PrimitivePathGraphicsItem::ShapeMode::FilledOutline
                         : PrimitivePathGraphicsItem::ShapeMode::None);
@@ -185,6 +187,7 @@ void PrimitiveFootprintPadGraphicsItem::setGeometries(
           clrItem->setRotation(mOriginCrossGraphicsItem->rotation());
           clrItem->setPath(
               geometry.withOffset(clearance).toFilledQPainterPathPx());
+          clrItem->setHiddenBelowSizePx(4);  // Irrelevant for tiny pads.
           clrItem->setShapeMode(PrimitivePathGraphicsItem::ShapeMode::None);
           clrItem->setZValue(item->zValue());
           mPathGraphicsItems.append(PathItem{layer, true, true, clrItem});
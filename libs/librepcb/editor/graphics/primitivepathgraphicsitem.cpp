@@ -46,6 +46,8 @@ PrimitivePathGraphicsItem::PrimitivePathGraphicsItem(
     mLighterColors(false),
     mShapeMode(ShapeMode::StrokeAndAreaByLayer),
     mBoundingRectMarginPx(0),
+    mSimplifiedBelowSizePx(0),
+    mHiddenBelowSizePx(0),
     mOnLayerEditedSlot(*this, &PrimitivePathGraphicsItem::layerEdited) {
   setFlag(QGraphicsItem::ItemIsSelectable, true);
 
@@ -130,6 +132,17 @@ void PrimitivePathGraphicsItem::setShapeMode(ShapeMode mode) noexcept {
   updateBoundingRectAndShape();
 }
 
+void PrimitivePathGraphicsItem::setSimplifiedBelowSizePx(
+    qreal sizePx) noexcept {
+  mSimplifiedBelowSizePx = sizePx;
+  update();
+}
+
+void PrimitivePathGraphicsItem::setHiddenBelowSizePx(qreal sizePx) noexcept {
+  mHiddenBelowSizePx = sizePx;
+  update();
+}
+
 /*******************************************************************************
  *  Inherited from QGraphicsItem
  ******************************************************************************/
@@ -147,13 +160,37 @@ void PrimitivePathGraphicsItem::paint(QPainter* painter,
   Q_UNUSED(widget);
 
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
+  const QPen& pen = isSelected ? mPenHighlighted : mPen;
+  const QBrush& brush = isSelected ? mBrushHighlighted : mBrush;
 
   if (mMirror) {
     painter->scale(-1, 1);
   }
 
-  painter->setPen(isSelected ? mPenHighlighted : mPen);
-  painter->setBrush(isSelected ? mBrushHighlighted : mBrush);
+  // Level of detail: If the item is tiny on screen, there's no point in
+  // rendering the (possibly complex) path.
+  if ((mSimplifiedBelowSizePx > 0) || (mHiddenBelowSizePx > 0)) {
+    const qreal lod =
+        option->levelOfDetailFromTransform(painter->worldTransform());
+    const qreal sizePx =
+        std::max(mBoundingRect.width(), mBoundingRect.height()) * lod;
+    if (sizePx < mHiddenBelowSizePx) {
+      return;
+    } else if ((sizePx < mSimplifiedBelowSizePx) &&
+               (brush.style() != Qt::NoBrush)) {
+      painter->fillRect(mBoundingRect, brush.color());
+      return;
+    } else if (sizePx < mSimplifiedBelowSizePx) {
+      // Not filled, so only draw the outline of the path's bounding rect.
+      painter->setPen(pen);
+      painter->setBrush(Qt::NoBrush);
+      painter->drawRect(mPainterPath.boundingRect());
+      return;
+    }
+  }
+
+  painter->setPen(pen);
+  painter->setBrush(brush);
   painter->drawPath(mPainterPath);
 }
 
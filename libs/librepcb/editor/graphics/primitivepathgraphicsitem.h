@@ -81,6 +81,26 @@ public:
   void setLighterColors(bool lighter) noexcept;
   void setShapeMode(ShapeMode mode) noexcept;
 
+  /**
+   * @brief Draw only the bounding rectangle if the item is small on screen
+   *
+   * To keep rendering of large scenes fast at low zoom levels, the detailed
+   * path is replaced by its bounding rectangle as long as its largest
+   * dimension is smaller than the given size in device pixels. The rectangle
+   * is filled only if the item has a fill layer, otherwise just its outline
+   * is drawn.
+   *
+   * @param sizePx    Size threshold in device pixels (0 = always draw path).
+   */
+  void setSimplifiedBelowSizePx(qreal sizePx) noexcept;
+
+  /**
+   * @brief Don't draw anything if the item is small on screen
+   *
+   * @param sizePx    Size threshold in device pixels (0 = always draw path).
+   */
+  void setHiddenBelowSizePx(qreal sizePx) noexcept;
+
   // Inherited from QGraphicsItem
   QRectF boundingRect() const noexcept override {
     return mBoundingRect +
@@ -117,6 +137,8 @@ protected:  // Data
   QRectF mBoundingRect;
   qreal mBoundingRectMarginPx;
   QPainterPath mShape;
+  qreal mSimplifiedBelowSizePx;
+  qreal mHiddenBelowSizePx;
 
   // Slots
   GraphicsLayer::OnEditedSlot mOnLayerEditedSlot;
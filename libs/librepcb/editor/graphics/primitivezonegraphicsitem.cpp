@@ -191,6 +191,7 @@ void PrimitiveZoneGraphicsItem::setOutline(const Path& path) noexcept {
 void PrimitiveZoneGraphicsItem::setEditable(bool editable) noexcept {
   mEditable = editable;
   updateBoundingRectMargin();
+  update();
 }
 
 /*******************************************************************************
@@ -152,18 +152,16 @@ void ComponentChooserDialog::searchComponents(const QString& input) {
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> components = mWorkspace.getLibraryDb().find<Component>(input);
+    const QList<Uuid> components =
+        mWorkspace.getLibraryDb().find<Component>(input);  // can throw
+    const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+        mWorkspace.getLibraryDb().getLatestInfos<Component>(
+            components, localeOrder());  // can throw
     foreach (const Uuid& uuid, components) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatest<Component>(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getTranslations<Component>(fp, localeOrder(),
-                                                           &name);  // can throw
-      bool deprecated = false;
-      mWorkspace.getLibraryDb().getMetadata<Component>(
-          fp, nullptr, nullptr, &deprecated);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
+      auto it = infos.constFind(uuid);
+      if (it == infos.constEnd()) continue;
+      QListWidgetItem* item = new QListWidgetItem(it->name);
+      item->setForeground(it->deprecated ? QBrush(Qt::red) : QBrush());
       item->setData(Qt::UserRole, uuid.toStr());
       mUi->listComponents->addItem(item);
     }
@@ -182,24 +180,14 @@ void ComponentChooserDialog::setSelectedCategory(
   try {
     QSet<Uuid> components =
         mWorkspace.getLibraryDb().getByCategory<Component>(uuid);  // can throw
-    foreach (const Uuid& cmpUuid, components) {
-      try {
-        FilePath fp = mWorkspace.getLibraryDb().getLatest<Component>(
-            cmpUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getTranslations<Component>(
-            fp, localeOrder(),
-            &name);  // can throw
-        bool deprecated = false;
-        mWorkspace.getLibraryDb().getMetadata<Component>(
-            fp, nullptr, nullptr, &deprecated);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-        item->setData(Qt::UserRole, cmpUuid.toStr());
-        mUi->listComponents->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+    const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+        mWorkspace.getLibraryDb().getLatestInfos<Component>(
+            components.values(), localeOrder());  // can throw
+    for (auto it = infos.constBegin(); it != infos.constEnd(); ++it) {
+      QListWidgetItem* item = new QListWidgetItem(it->name);
+      item->setForeground(it->deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, it.key().toStr());
+      mUi->listComponents->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load components"), e.getMsg());
@@ -150,18 +150,16 @@ void PackageChooserDialog::searchPackages(const QString& input) {
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> packages = mWorkspace.getLibraryDb().find<Package>(input);
+    const QList<Uuid> packages =
+        mWorkspace.getLibraryDb().find<Package>(input);  // can throw
+    const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+        mWorkspace.getLibraryDb().getLatestInfos<Package>(
+            packages, localeOrder());  // can throw
     foreach (const Uuid& uuid, packages) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatest<Package>(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getTranslations<Package>(fp, localeOrder(),
-                                                         &name);  // can throw
-      bool deprecated = false;
-      mWorkspace.getLibraryDb().getMetadata<Package>(fp, nullptr, nullptr,
-                                                     &deprecated);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
+      auto it = infos.constFind(uuid);
+      if (it == infos.constEnd()) continue;
+      QListWidgetItem* item = new QListWidgetItem(it->name);
+      item->setForeground(it->deprecated ? QBrush(Qt::red) : QBrush());
       item->setData(Qt::UserRole, uuid.toStr());
       mUi->listPackages->addItem(item);
     }
@@ -180,23 +178,14 @@ void PackageChooserDialog::setSelectedCategory(
   try {
     QSet<Uuid> packages =
         mWorkspace.getLibraryDb().getByCategory<Package>(uuid);  // can throw
-    foreach (const Uuid& pkgUuid, packages) {
-      try {
-        FilePath fp =
-            mWorkspace.getLibraryDb().getLatest<Package>(pkgUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getTranslations<Package>(fp, localeOrder(),
-                                                           &name);  // can throw
-        bool deprecated = false;
-        mWorkspace.getLibraryDb().getMetadata<Package>(
-            fp, nullptr, nullptr, &deprecated);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-        item->setData(Qt::UserRole, pkgUuid.toStr());
-        mUi->listPackages->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+    const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+        mWorkspace.getLibraryDb().getLatestInfos<Package>(
+            packages.values(), localeOrder());  // can throw
+    for (auto it = infos.constBegin(); it != infos.constEnd(); ++it) {
+      QListWidgetItem* item = new QListWidgetItem(it->name);
+      item->setForeground(it->deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, it.key().toStr());
+      mUi->listPackages->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load packages"), e.getMsg());
@@ -168,19 +168,17 @@ void SymbolChooserDialog::searchSymbols(const QString& input) {
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> symbols = mWorkspace.getLibraryDb().find<Symbol>(input);
+    const QList<Uuid> symbols =
+        mWorkspace.getLibraryDb().find<Symbol>(input);  // can throw
+    const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+        mWorkspace.getLibraryDb().getLatestInfos<Symbol>(
+            symbols, localeOrder());  // can throw
     foreach (const Uuid& uuid, symbols) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatest<Symbol>(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getTranslations<Symbol>(fp, localeOrder(),
-                                                        &name);  // can throw
-      bool deprecated = false;
-      mWorkspace.getLibraryDb().getMetadata<Symbol>(fp, nullptr, nullptr,
-                                                    &deprecated);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-      item->setData(Qt::UserRole, fp.toStr());
+      auto it = infos.constFind(uuid);
+      if (it == infos.constEnd()) continue;
+      QListWidgetItem* item = new QListWidgetItem(it->name);
+      item->setForeground(it->deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, it->filePath.toStr());
       mUi->listSymbols->addItem(item);
     }
   }
@@ -198,24 +196,14 @@ void SymbolChooserDialog::setSelectedCategory(
   try {
     QSet<Uuid> symbols =
         mWorkspace.getLibraryDb().getByCategory<Symbol>(uuid);  // can throw
-    foreach (const Uuid& symbolUuid, symbols) {
-      try {
-        FilePath fp = mWorkspace.getLibraryDb().getLatest<Symbol>(
-            symbolUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getTranslations<Symbol>(fp, localeOrder(),
-                                                          &name);  // can throw
-        bool deprecated = false;
-        mWorkspace.getLibraryDb().getMetadata<Symbol>(
-            fp, nullptr, nullptr,
-            &deprecated);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setForeground(deprecated ? QBrush(Qt::red) : QBrush());
-        item->setData(Qt::UserRole, fp.toStr());
-        mUi->listSymbols->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+    const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+        mWorkspace.getLibraryDb().getLatestInfos<Symbol>(
+            symbols.values(), localeOrder());  // can throw
+    foreach (const WorkspaceLibraryDb::ElementInfo& info, infos) {
+      QListWidgetItem* item = new QListWidgetItem(info.name);
+      item->setForeground(info.deprecated ? QBrush(Qt::red) : QBrush());
+      item->setData(Qt::UserRole, info.filePath.toStr());
+      mUi->listSymbols->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load symbols"), e.getMsg());
@@ -544,25 +544,74 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
   const QList<Uuid> matchingPartDevices =
       mDb.findDevicesOfParts(input);  // can throw
 
+  // Determine matching devices which are not added through their component.
+  QList<Uuid> devices = matchingPartDevices;
+  foreach (const Uuid& uuid, matchingDevices) {
+    if (!devices.contains(uuid)) {
+      devices.append(uuid);
+    }
+  }
+
+  // Fetch metadata of all involved elements at once, since querying them
+  // one by one is very slow for large search results.
+  const QHash<Uuid, QSet<Uuid>> componentDevices =
+      mDb.getComponentDevices(matchingComponents);  // can throw
+  QSet<Uuid> allDevices = devices.toSet();
+  foreach (const QSet<Uuid>& uuids, componentDevices) {
+    allDevices |= uuids;
+  }
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> devInfos =
+      mDb.getLatestInfos<Device>(allDevices.values(),
+                                 mLocaleOrder);  // can throw
+  QSet<Uuid> allComponents = matchingComponents.toSet();
+  QSet<Uuid> allPackages;
+  foreach (const WorkspaceLibraryDb::ElementInfo& info, devInfos) {
+    if (info.componentUuid) allComponents.insert(*info.componentUuid);
+    if (info.packageUuid) allPackages.insert(*info.packageUuid);
+  }
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> cmpInfos =
+      mDb.getLatestInfos<Component>(allComponents.values(),
+                                    mLocaleOrder);  // can throw
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> pkgInfos =
+      mDb.getLatestInfos<Package>(allPackages.values(),
+                                  mLocaleOrder);  // can throw
+
+  auto addComponent = [&result](const WorkspaceLibraryDb::ElementInfo& info)
+      -> SearchResultComponent& {
+    SearchResultComponent& resCmp = result.components[info.filePath];
+    resCmp.name = info.name;
+    resCmp.deprecated = info.deprecated;
+    return resCmp;
+  };
+  auto addDevice = [&pkgInfos](SearchResultComponent& resCmp,
+                               const Uuid& uuid,
+                               const WorkspaceLibraryDb::ElementInfo& info)
+      -> SearchResultDevice& {
+    SearchResultDevice& resDev = resCmp.devices[info.filePath];
+    resDev.uuid = uuid;
+    resDev.name = info.name;
+    resDev.deprecated = info.deprecated;
+    auto pkgIt = info.packageUuid ? pkgInfos.constFind(*info.packageUuid)
+                                  : pkgInfos.constEnd();
+    if (pkgIt != pkgInfos.constEnd()) {
+      resDev.pkgFp = pkgIt->filePath;
+      resDev.pkgName = pkgIt->name;
+    }
+    return resDev;
+  };
+
   // Add matching components and all their devices and parts.
   QSet<Uuid> fullyAddedDevices;
   foreach (const Uuid& cmpUuid, matchingComponents) {
-    FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);  // can throw
-    SearchResultComponent& resCmp = result.components[cmpFp];
+    auto cmpIt = cmpInfos.constFind(cmpUuid);
+    if (cmpIt == cmpInfos.constEnd()) continue;
+    SearchResultComponent& resCmp = addComponent(*cmpIt);
     resCmp.match = true;
-    foreach (const Uuid& devUuid, devices) {
-      FilePath devFp = mDb.getLatest<Device>(devUuid);  // can throw
-      if (!devFp.isValid()) continue;
-      if (resCmp.devices.contains(devFp)) continue;
-      Uuid pkgUuid = Uuid::createRandom();
-      mDb.getDeviceMetadata(devFp, nullptr,
-                            &pkgUuid);  // can throw
-      FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);  // can throw
-      SearchResultDevice& resDev = resCmp.devices[devFp];
-      resDev.uuid = devUuid;
-      resDev.pkgFp = pkgFp;
+    foreach (const Uuid& devUuid, componentDevices.value(cmpUuid)) {
+      auto devIt = devInfos.constFind(devUuid);
+      if (devIt == devInfos.constEnd()) continue;
+      if (resCmp.devices.contains(devIt->filePath)) continue;
+      SearchResultDevice& resDev = addDevice(resCmp, devUuid, *devIt);
       resDev.match = matchingDevices.contains(devUuid);
       const QList<WorkspaceLibraryDb::Part> parts =
           mDb.getDeviceParts(devUuid);  // can throw
@@ -576,30 +625,18 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
   }
 
   // Add matching devices + parts and their corresponding components.
-  QList<Uuid> devices = matchingPartDevices;
-  foreach (const Uuid& uuid, matchingDevices) {
-    if (!devices.contains(uuid)) {
-      devices.append(uuid);
-    }
-  }
   devices.erase(std::remove_if(devices.begin(), devices.end(),
                                [&fullyAddedDevices](const Uuid& uuid) {
                                  return fullyAddedDevices.contains(uuid);
                                }),
                 devices.end());
   foreach (const Uuid& devUuid, devices) {
-    FilePath devFp = mDb.getLatest<Device>(devUuid);  // can throw
-    if (!devFp.isValid()) continue;
-    Uuid cmpUuid = Uuid::createRandom();
-    Uuid pkgUuid = Uuid::createRandom();
-    mDb.getDeviceMetadata(devFp, &cmpUuid,
-                          &pkgUuid);  // can throw
-    const FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    SearchResultDevice& resDev = result.components[cmpFp].devices[devFp];
-    FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);  // can throw
-    resDev.uuid = devUuid;
-    resDev.pkgFp = pkgFp;
+    auto devIt = devInfos.constFind(devUuid);
+    if ((devIt == devInfos.constEnd()) || (!devIt->componentUuid)) continue;
+    auto cmpIt = cmpInfos.constFind(*devIt->componentUuid);
+    if (cmpIt == cmpInfos.constEnd()) continue;
+    SearchResultDevice& resDev =
+        addDevice(addComponent(*cmpIt), devUuid, *devIt);
     resDev.match = matchingDevices.contains(devUuid);
 
     QList<WorkspaceLibraryDb::Part> parts;
@@ -618,30 +655,6 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
     }
   }
 
-  // Get additional metadata of elements.
-  QMutableHashIterator<FilePath, SearchResultComponent> cmpIt(
-      result.components);
-  while (cmpIt.hasNext()) {
-    cmpIt.next();
-    mDb.getTranslations<Component>(cmpIt.key(), mLocaleOrder,
-                                   &cmpIt.value().name);
-    mDb.getMetadata<Component>(cmpIt.key(), nullptr, nullptr,
-                               &cmpIt.value().deprecated);
-    QMutableHashIterator<FilePath, SearchResultDevice> devIt(
-        cmpIt.value().devices);
-    while (devIt.hasNext()) {
-      devIt.next();
-      mDb.getTranslations<Device>(devIt.key(), mLocaleOrder,
-                                  &devIt.value().name);
-      mDb.getMetadata<Device>(devIt.key(), nullptr, nullptr,
-                              &devIt.value().deprecated);
-      if (devIt.value().pkgFp.isValid()) {
-        mDb.getTranslations<Package>(devIt.value().pkgFp, mLocaleOrder,
-                                     &devIt.value().pkgName);
-      }
-    }
-  }
-
   // Count number it items.
   foreach (const SearchResultComponent& cmp, result.components) {
     result.deviceCount += cmp.devices.count();
@@ -660,44 +673,54 @@ void AddComponentDialog::setSelectedCategory(
   mUi->treeComponents->clear();
 
   mSelectedCategoryUuid = categoryUuid;
-  QSet<Uuid> components = mDb.getByCategory<Component>(categoryUuid);
-  foreach (const Uuid& cmpUuid, components) {
+  const QList<Uuid> components =
+      mDb.getByCategory<Component>(categoryUuid).values();
+
+  // Fetch metadata of all elements at once, since querying them one by one
+  // is very slow for categories containing many elements.
+  const QHash<Uuid, QSet<Uuid>> componentDevices =
+      mDb.getComponentDevices(components);
+  QSet<Uuid> allDevices;
+  foreach (const QSet<Uuid>& uuids, componentDevices) {
+    allDevices |= uuids;
+  }
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> cmpInfos =
+      mDb.getLatestInfos<Component>(components, mLocaleOrder);
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> devInfos =
+      mDb.getLatestInfos<Device>(allDevices.values(), mLocaleOrder);
+  QSet<Uuid> allPackages;
+  foreach (const WorkspaceLibraryDb::ElementInfo& info, devInfos) {
+    if (info.packageUuid) allPackages.insert(*info.packageUuid);
+  }
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> pkgInfos =
+      mDb.getLatestInfos<Package>(allPackages.values(), mLocaleOrder);
+
+  for (auto cmpIt = cmpInfos.constBegin(); cmpIt != cmpInfos.constEnd();
+       ++cmpIt) {
     // component
-    FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);
-    if (!cmpFp.isValid()) continue;
-    QString cmpName;
-    mDb.getTranslations<Component>(cmpFp, mLocaleOrder, &cmpName);
-    bool cmpDeprecated = false;
-    mDb.getMetadata<Component>(cmpFp, nullptr, nullptr, &cmpDeprecated);
     QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
     cmpItem->setIcon(0, QIcon(":/img/library/symbol.png"));
-    cmpItem->setText(0, cmpName);
-    cmpItem->setForeground(0, cmpDeprecated ? QBrush(Qt::red) : QBrush());
-    cmpItem->setData(0, Qt::UserRole, cmpFp.toStr());
+    cmpItem->setText(0, cmpIt->name);
+    cmpItem->setForeground(0, cmpIt->deprecated ? QBrush(Qt::red) : QBrush());
+    cmpItem->setData(0, Qt::UserRole, cmpIt->filePath.toStr());
     // devices
-    QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);
+    const QSet<Uuid> devices = componentDevices.value(cmpIt.key());
     foreach (const Uuid& devUuid, devices) {
       try {
-        FilePath devFp = mDb.getLatest<Device>(devUuid);
-        if (!devFp.isValid()) continue;
-        QString devName;
-        mDb.getTranslations<Device>(devFp, mLocaleOrder, &devName);
-        bool devDeprecated = false;
-        mDb.getMetadata<Device>(devFp, nullptr, nullptr, &devDeprecated);
+        auto devIt = devInfos.constFind(devUuid);
+        if (devIt == devInfos.constEnd()) continue;
         QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
         devItem->setIcon(0, QIcon(":/img/library/device.png"));
-        devItem->setText(0, devName);
-        devItem->setForeground(0, devDeprecated ? QBrush(Qt::red) : QBrush());
-        devItem->setData(0, Qt::UserRole, devFp.toStr());
+        devItem->setText(0, devIt->name);
+        devItem->setForeground(0,
+                               devIt->deprecated ? QBrush(Qt::red) : QBrush());
+        devItem->setData(0, Qt::UserRole, devIt->filePath.toStr());
         // package
-        Uuid pkgUuid = Uuid::createRandom();  // only for initialization, will
-                                              // be overwritten
-        mDb.getDeviceMetadata(devFp, nullptr, &pkgUuid);
-        FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);
-        if (pkgFp.isValid()) {
-          QString pkgName;
-          mDb.getTranslations<Package>(pkgFp, mLocaleOrder, &pkgName);
-          devItem->setText(1, pkgName);
+        auto pkgIt = devIt->packageUuid
+            ? pkgInfos.constFind(*devIt->packageUuid)
+            : pkgInfos.constEnd();
+        if (pkgIt != pkgInfos.constEnd()) {
+          devItem->setText(1, pkgIt->name);
           devItem->setTextAlignment(1, Qt::AlignRight);
           QFont font = devItem->font(1);
           font.setItalic(true);
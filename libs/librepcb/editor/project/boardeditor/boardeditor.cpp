@@ -65,6 +65,7 @@
 #include <librepcb/core/project/board/boardd356netlistexport.h>
 #include <librepcb/core/project/board/boardpainter.h>
 #include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
+#include <librepcb/core/project/board/drc/boardbackgrounddrc.h>
 #include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
 #include <librepcb/core/project/board/items/bi_device.h>
 #include <librepcb/core/project/board/items/bi_footprintpad.h>
@@ -116,7 +117,9 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
     mVisibleSceneRect(),
     mFsm(),
     mPlaneFragmentsBuilder(new BoardPlaneFragmentsBuilder(true, this)),
-    mTimestampOfLastPlaneRebuild(0) {
+    mTimestampOfLastPlaneRebuild(0),
+    mBackgroundDrc(new BoardBackgroundDrc(this)),
+    mBackgroundDrcScheduled(false) {
   mUi->setupUi(this);
   mUi->tabBar->setDocumentMode(true);  // For MacOS
   mUi->lblUnplacedComponentsNote->hide();
@@ -199,6 +202,16 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
             mTimestampOfLastPlaneRebuild = QDateTime::currentMSecsSinceEpoch();
           });
 
+  // Setup background DRC. Since it runs on a snapshot of the board, any
+  // modification requires to discard running checks and to check again.
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, this,
+          &BoardEditor::scheduleBackgroundDrc);
+  connect(mPlaneFragmentsBuilder.data(),
+          &BoardPlaneFragmentsBuilder::boardPlanesModified, this,
+          &BoardEditor::scheduleBackgroundDrc);
+  connect(mBackgroundDrc.data(), &BoardBackgroundDrc::messagesUpdated, this,
+          &BoardEditor::backgroundDrcMessagesUpdated);
+
   // Create all actions, window menus, toolbars and dock widgets.
   createActions();
   createToolBars();
@@ -305,6 +318,8 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept {
     mUi->graphicsView->setScene(nullptr);
     mGraphicsScene.reset();
     mActiveBoard = newBoard;
+    mBackgroundDrc->reset();
+    mBackgroundDrcScheduled = true;
 
     if (mActiveBoard) {
       // Update layers.
@@ -1349,11 +1364,40 @@ void BoardEditor::runDrc(bool quick) noexcept {
     // Print how long it took.
     qDebug() << (quick ? "Quick check" : "DRC") << "succeeded after"
              << timer.elapsed() << "ms.";
+
+    // The DRC might have modified the board (e.g. rebuilt planes), thus the
+    // background DRC needs to check it again to stay up to date.
+    scheduleBackgroundDrc();
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Error"), e.getMsg());
   }
 }
 
+void BoardEditor::scheduleBackgroundDrc() noexcept {
+  mBackgroundDrc->invalidate();
+  mBackgroundDrcScheduled = true;
+}
+
+void BoardEditor::backgroundDrcMessagesUpdated(
+    Board& board, const RuleCheckMessageList& messages) noexcept {
+  if ((&board != getActiveBoard()) ||
+      (!mDrcMessages.value(board.getUuid()))) {
+    return;
+  }
+
+  // Replace the copper clearance messages of the last DRC run, but keep all
+  // other messages since they are not checked in background.
+  RuleCheckMessageList newMessages;
+  foreach (const auto& msg, *mDrcMessages.value(board.getUuid())) {
+    if (!msg->as<DrcMsgCopperCopperClearanceViolation>()) {
+      newMessages.append(msg);
+    }
+  }
+  newMessages += messages;
+  mDrcMessages.insert(board.getUuid(), newMessages);
+  mDockDrc->setMessages(newMessages);
+}
+
 void BoardEditor::highlightDrcMessage(const RuleCheckMessage& msg,
                                       bool zoomTo) noexcept {
   if (msg.getLocations().isEmpty()) {
@@ -1492,6 +1536,21 @@ void BoardEditor::performScheduledTasks() noexcept {
     mOpenGlSceneBuildScheduled = false;
     mOpenGlSceneBuilder->start(data);
   }
+
+  // Update copper clearance violations in background, but only if the DRC
+  // has already been run for the current board. Otherwise the user is not
+  // interested in DRC messages (yet).
+  Board* board = getActiveBoard();
+  if ((!planesRebuilding) && mBackgroundDrcScheduled && board &&
+      mDrcMessages.value(board->getUuid()) && (!mBackgroundDrc->isBusy()) &&
+      updateAllowedInCurrentState && isActiveTopLevelWindow()) {
+    mBackgroundDrcScheduled = false;
+    try {
+      mBackgroundDrc->start(*board);  // can throw
+    } catch (const Exception& e) {
+      qCritical() << "Failed to start background DRC:" << e.getMsg();
+    }
+  }
 }
 
 void BoardEditor::startPlaneRebuild(bool full) noexcept {
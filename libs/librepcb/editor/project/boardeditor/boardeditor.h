@@ -40,6 +40,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class BoardBackgroundDrc;
 class BoardPlaneFragmentsBuilder;
 class ComponentInstance;
 class Project;
@@ -149,6 +150,9 @@ private:
   void toolRequested(const QVariant& newTool) noexcept;
   void unplacedComponentsCountChanged(int count) noexcept;
   void runDrc(bool quick) noexcept;
+  void scheduleBackgroundDrc() noexcept;
+  void backgroundDrcMessagesUpdated(
+      Board& board, const RuleCheckMessageList& messages) noexcept;
   void highlightDrcMessage(const RuleCheckMessage& msg, bool zoomTo) noexcept;
   void setDrcMessageApproved(const RuleCheckMessage& msg,
                              bool approved) noexcept;
@@ -199,6 +203,8 @@ private:
   // DRC
   QHash<Uuid, tl::optional<RuleCheckMessageList>> mDrcMessages;  ///< UUID=Board
   QScopedPointer<QGraphicsPathItem> mDrcLocationGraphicsItem;
+  QScopedPointer<BoardBackgroundDrc> mBackgroundDrc;
+  bool mBackgroundDrcScheduled;
 
   // Actions
   QScopedPointer<QAction> mActionAboutLibrePcb;
@@ -71,6 +71,12 @@ BoardGraphicsScene::BoardGraphicsScene(
     mBoard(board),
     mLayerProvider(lp),
     mHighlightedNetSignals(highlightedNetSignals) {
+  // Static items like planes, polygons and texts are cached as pixmaps in
+  // device coordinates (see QGraphicsItem::DeviceCoordinateCache), so only
+  // modified items need to be rendered again. The default pixmap cache limit
+  // is too small for large boards, causing the caches to be discarded.
+  QPixmapCache::setCacheLimit(std::max(QPixmapCache::cacheLimit(), 100 * 1024));
+
   foreach (BI_Device* obj, mBoard.getDeviceInstances()) {
     addDevice(*obj);
   }
@@ -177,6 +177,12 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   const QPainterPath posAreaLarge =
       mContext.editorGraphicsView.calcPosWithTolerance(pos, 1.5);
 
+  // Only items near the cursor need to be checked in detail. Getting them
+  // from the spatial index of the scene is a lot faster than calculating the
+  // grab area of every single item on large boards.
+  const QSet<QGraphicsItem*> nearbyItems = scene->getItemsInRect(
+      posAreaLarge.boundingRect() | QRectF(posExact, posOnGrid).normalized());
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -247,7 +253,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
                       flags, &except, &addItem, &canSkip](
                          std::shared_ptr<QGraphicsItem> item,
                          const Point& nearestPos, int priority, bool large) {
-    if (except.contains(item)) {
+    if ((!item) || except.contains(item)) {
       return;
     }
     auto prio = std::make_pair(priority, 0);
@@ -287,137 +293,131 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
     }
   };
 
-  if (flags.testFlag(FindFlag::Holes)) {
-    for (auto it = scene->getHoles().begin(); it != scene->getHoles().end();
-         it++) {
-      processItem(it.value(),
-                  it.key()->getData().getPath()->getVertices().first().getPos(),
-                  5, false);
+  // Map the items near the cursor back to their board items to filter them.
+  // Note that hidden items (e.g. on hidden layers) are not contained in the
+  // spatial index, thus they are never found.
+  foreach (QGraphicsItem* graphicsItem, nearbyItems) {
+    if (auto bgi = dynamic_cast<BGI_Hole*>(graphicsItem)) {
+      BI_Hole& hole = bgi->getHole();
+      if (flags.testFlag(FindFlag::Holes)) {
+        processItem(scene->getHoles().value(&hole),
+                    hole.getData().getPath()->getVertices().first().getPos(),
+                    5, false);
+      }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Vias)) {
-    for (auto it = scene->getVias().begin(); it != scene->getVias().end();
-         it++) {
-      if (netsignals.isEmpty() ||
-          netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
-        if ((!cuLayer) || (it.key()->getVia().isOnLayer(*cuLayer))) {
-          processItem(it.value(), it.key()->getPosition(), 0, false);
-        }
+    if (auto bgi = dynamic_cast<BGI_Via*>(graphicsItem)) {
+      BI_Via& via = bgi->getVia();
+      if (flags.testFlag(FindFlag::Vias) &&
+          (netsignals.isEmpty() ||
+           netsignals.contains(via.getNetSegment().getNetSignal())) &&
+          ((!cuLayer) || (via.getVia().isOnLayer(*cuLayer)))) {
+        processItem(scene->getVias().value(&via), via.getPosition(), 0, false);
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::NetPoints)) {
-    for (auto it = scene->getNetPoints().begin();
-         it != scene->getNetPoints().end(); it++) {
-      if (netsignals.isEmpty() ||
-          netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
-        const Layer* layer = it.key()->getLayerOfTraces();
-        if ((!cuLayer) || (&*cuLayer == layer)) {
-          processItem(it.value(), it.key()->getPosition(),
-                      10 + (layer ? priorityFromLayer(*layer) : 0), false);
-        }
+    if (auto bgi = dynamic_cast<BGI_NetPoint*>(graphicsItem)) {
+      BI_NetPoint& netPoint = bgi->getNetPoint();
+      const Layer* layer = netPoint.getLayerOfTraces();
+      if (flags.testFlag(FindFlag::NetPoints) &&
+          (netsignals.isEmpty() ||
+           netsignals.contains(netPoint.getNetSegment().getNetSignal())) &&
+          ((!cuLayer) || (&*cuLayer == layer))) {
+        processItem(scene->getNetPoints().value(&netPoint),
+                    netPoint.getPosition(),
+                    10 + (layer ? priorityFromLayer(*layer) : 0), false);
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::NetLines)) {
-    for (auto it = scene->getNetLines().begin();
-         it != scene->getNetLines().end(); it++) {
-      if (netsignals.isEmpty() ||
-          netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
-        const Layer& layer = it.key()->getLayer();
-        if ((!cuLayer) || (*cuLayer == layer)) {
-          processItem(it.value(),
-                      Toolbox::nearestPointOnLine(
-                          pos.mappedToGrid(getGridInterval()),
-                          it.key()->getStartPoint().getPosition(),
-                          it.key()->getEndPoint().getPosition()),
-                      20 + priorityFromLayer(layer), false);
-        }
+    if (auto bgi = dynamic_cast<BGI_NetLine*>(graphicsItem)) {
+      BI_NetLine& netLine = bgi->getNetLine();
+      const Layer& layer = netLine.getLayer();
+      if (flags.testFlag(FindFlag::NetLines) &&
+          (netsignals.isEmpty() ||
+           netsignals.contains(netLine.getNetSegment().getNetSignal())) &&
+          ((!cuLayer) || (*cuLayer == layer))) {
+        processItem(scene->getNetLines().value(&netLine),
+                    Toolbox::nearestPointOnLine(
+                        pos.mappedToGrid(getGridInterval()),
+                        netLine.getStartPoint().getPosition(),
+                        netLine.getEndPoint().getPosition()),
+                    20 + priorityFromLayer(layer), false);
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Planes)) {
-    for (auto it = scene->getPlanes().begin(); it != scene->getPlanes().end();
-         it++) {
-      if (netsignals.isEmpty() ||
-          netsignals.contains(it.key()->getNetSignal())) {
-        if ((!cuLayer) || (*cuLayer == it.key()->getLayer())) {
-          processItem(
-              it.value(),
-              it.key()->getOutline().calcNearestPointBetweenVertices(pos),
-              30 + priorityFromLayer(it.key()->getLayer()),
-              true);  // Probably large grab area makes sense?
-        }
+    if (auto bgi = dynamic_cast<BGI_Plane*>(graphicsItem)) {
+      BI_Plane& plane = bgi->getPlane();
+      if (flags.testFlag(FindFlag::Planes) &&
+          (netsignals.isEmpty() ||
+           netsignals.contains(plane.getNetSignal())) &&
+          ((!cuLayer) || (*cuLayer == plane.getLayer()))) {
+        processItem(scene->getPlanes().value(&plane),
+                    plane.getOutline().calcNearestPointBetweenVertices(pos),
+                    30 + priorityFromLayer(plane.getLayer()),
+                    true);  // Probably large grab area makes sense?
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Zones)) {
-    for (auto it = scene->getZones().begin(); it != scene->getZones().end();
-         it++) {
-      if ((!cuLayer) || (it.key()->getData().getLayers().contains(&*cuLayer))) {
-        QList<const Layer*> layers = it.key()->getData().getLayers().toList();
+    if (auto bgi = dynamic_cast<BGI_Zone*>(graphicsItem)) {
+      BI_Zone& zone = bgi->getZone();
+      if (flags.testFlag(FindFlag::Zones) &&
+          ((!cuLayer) || (zone.getData().getLayers().contains(&*cuLayer)))) {
+        QList<const Layer*> layers = zone.getData().getLayers().toList();
         std::sort(layers.begin(), layers.end(), &Layer::lessThan);
         int priority = 30;
         if (!layers.isEmpty()) {
           priority += priorityFromLayer(*layers.first());
         }
         processItem(
-            it.value(),
-            it.key()->getData().getOutline().calcNearestPointBetweenVertices(
-                pos),
+            scene->getZones().value(&zone),
+            zone.getData().getOutline().calcNearestPointBetweenVertices(pos),
             priority,
             true);  // Probably large grab area makes sense?
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Devices)) {
-    for (auto it = scene->getDevices().begin(); it != scene->getDevices().end();
-         it++) {
-      processItem(it.value(), it.key()->getPosition(),
-                  40 + (it.key()->getMirrored() ? 300 : 100), false);
+    if (auto bgi = dynamic_cast<BGI_Device*>(graphicsItem)) {
+      BI_Device& device = bgi->getDevice();
+      if (flags.testFlag(FindFlag::Devices)) {
+        processItem(scene->getDevices().value(&device), device.getPosition(),
+                    40 + (device.getMirrored() ? 300 : 100), false);
+      }
     }
-  }
 
-  if (flags.testFlag(FindFlag::FootprintPads)) {
-    for (auto it = scene->getFootprintPads().begin();
-         it != scene->getFootprintPads().end(); it++) {
-      if (netsignals.isEmpty() ||
-          netsignals.contains(it.key()->getCompSigInstNetSignal())) {
-        if ((!cuLayer) || (it.key()->isOnLayer(*cuLayer))) {
-          // Give THT pads high priority to fix
-          // https://github.com/LibrePCB/LibrePCB/issues/1073.
-          const int priority = it.key()->getLibPad().isTht()
-              ? 1
-              : (50 + (it.key()->getMirrored() ? 300 : 100));
-          processItem(it.value(), it.key()->getPosition(), priority, false);
-        }
+    if (auto bgi = dynamic_cast<BGI_FootprintPad*>(graphicsItem)) {
+      BI_FootprintPad& pad = bgi->getPad();
+      if (flags.testFlag(FindFlag::FootprintPads) &&
+          (netsignals.isEmpty() ||
+           netsignals.contains(pad.getCompSigInstNetSignal())) &&
+          ((!cuLayer) || (pad.isOnLayer(*cuLayer)))) {
+        // Give THT pads high priority to fix
+        // https://github.com/LibrePCB/LibrePCB/issues/1073.
+        const int priority = pad.getLibPad().isTht()
+            ? 1
+            : (50 + (pad.getMirrored() ? 300 : 100));
+        processItem(scene->getFootprintPads().value(&pad), pad.getPosition(),
+                    priority, false);
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Polygons)) {
-    for (auto it = scene->getPolygons().begin();
-         it != scene->getPolygons().end(); it++) {
-      processItem(
-          it.value(),
-          it.key()->getData().getPath().calcNearestPointBetweenVertices(pos),
-          60 + priorityFromLayer(it.key()->getData().getLayer()),
-          true);  // Probably large grab area makes sense?
+    if (auto bgi = dynamic_cast<BGI_Polygon*>(graphicsItem)) {
+      BI_Polygon& polygon = bgi->getPolygon();
+      if (flags.testFlag(FindFlag::Polygons)) {
+        processItem(
+            scene->getPolygons().value(&polygon),
+            polygon.getData().getPath().calcNearestPointBetweenVertices(pos),
+            60 + priorityFromLayer(polygon.getData().getLayer()),
+            true);  // Probably large grab area makes sense?
+      }
     }
-  }
 
-  if (flags.testFlag(FindFlag::StrokeTexts)) {
-    for (auto it = scene->getStrokeTexts().begin();
-         it != scene->getStrokeTexts().end(); it++) {
-      processItem(it.value(), it.key()->getData().getPosition(),
-                  60 + priorityFromLayer(it.key()->getData().getLayer()),
-                  false);
+    if (auto bgi = dynamic_cast<BGI_StrokeText*>(graphicsItem)) {
+      BI_StrokeText& text = bgi->getStrokeText();
+      if (flags.testFlag(FindFlag::StrokeTexts)) {
+        processItem(scene->getStrokeTexts().value(&text),
+                    text.getData().getPosition(),
+                    60 + priorityFromLayer(text.getData().getLayer()), false);
+      }
     }
   }
 
@@ -84,6 +84,8 @@ BGI_Device::BGI_Device(BI_Device& device,
     auto i = std::make_shared<PrimitivePathGraphicsItem>(this);
     i->setPath(obj.getPathForRendering().toQPainterPathPx());
     i->setLineWidth(obj.getLineWidth());
+    i->setSimplifiedBelowSizePx(3);  // Draw tiny polygons as rects.
+    i->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
     i->setFlag(QGraphicsItem::ItemStacksBehindParent, true);
     if (obj.isGrabArea()) {
       mShape |= Toolbox::shapeFromPath(obj.getPath().toQPainterPathPx(),
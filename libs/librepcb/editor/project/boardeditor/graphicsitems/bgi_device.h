@@ -74,6 +74,9 @@ public:
   BI_Device& getDevice() noexcept { return mDevice; }
 
   // Inherited from QGraphicsItem
+  QRectF boundingRect() const noexcept override {
+    return mShape.boundingRect();  // Required for the scene's spatial index.
+  }
   QPainterPath shape() const noexcept override;
 
   // Operator Overloadings
@@ -39,6 +39,10 @@
 namespace librepcb {
 namespace editor {
 
+// Above this level of detail, plane fragments are always drawn with all their
+// vertices. Below, they are drawn decimated to about one device pixel.
+static const qreal sFullDetailLod = 16;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -59,6 +63,11 @@ BGI_Plane::BGI_Plane(BI_Plane& plane, const IF_GraphicsLayerProvider& lp,
     mOnLayerEditedSlot(*this, &BGI_Plane::layerEdited) {
   setFlag(QGraphicsItem::ItemIsSelectable, true);
 
+  // Planes are large and complex, but rarely modified. Thus render them only
+  // once per zoom level into a cache and reuse it while panning or editing
+  // other items on top of them.
+  setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
   updateOutlineAndFragments();
   updateLayer();
   updateVisibility();
@@ -180,7 +189,7 @@ void BGI_Plane::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     if (mPlane.isVisible()) {
       painter->setPen(Qt::NoPen);
       painter->setBrush(mLayer->getColor(highlight));
-      foreach (const QPainterPath& area, mAreas) {
+      foreach (const QPainterPath& area, getAreas(lod)) {
         painter->drawPath(area);
       }
     }
@@ -264,6 +273,7 @@ void BGI_Plane::updateOutlineAndFragments() noexcept {
 
   // get areas
   mAreas.clear();
+  mSimplifiedAreas.clear();
   for (const Path& r : mPlane.getFragments()) {
     mAreas.append(r.toQPainterPathPx());
     mBoundingRect = mBoundingRect.united(mAreas.last().boundingRect());
@@ -272,6 +282,47 @@ void BGI_Plane::updateOutlineAndFragments() noexcept {
   updateBoundingRectMargin();
 }
 
+const QVector<QPainterPath>& BGI_Plane::getAreas(qreal lod) noexcept {
+  if (lod >= sFullDetailLod) {
+    return mAreas;
+  }
+
+  // Quantize the level of detail to powers of two to keep the cache small.
+  const int level = qFloor(std::log2(std::max(lod, qreal(1e-6))));
+  auto it = mSimplifiedAreas.find(level);
+  if (it == mSimplifiedAreas.end()) {
+    const qreal tolerancePx = 1 / std::pow(qreal(2), level);
+    QVector<QPainterPath> areas;
+    for (const Path& r : mPlane.getFragments()) {
+      areas.append(simplifyArea(r, tolerancePx));
+    }
+    it = mSimplifiedAreas.insert(level, areas);
+  }
+  return *it;
+}
+
+QPainterPath BGI_Plane::simplifyArea(const Path& path,
+                                     qreal tolerancePx) noexcept {
+  QPolygonF polygon;
+  for (const Vertex& vertex : path.getVertices()) {
+    if (vertex.getAngle() != 0) {
+      return path.toQPainterPathPx();  // Arcs are not supported, keep as-is.
+    }
+    const QPointF pos = vertex.getPos().toPxQPointF();
+    if (polygon.isEmpty() ||
+        (QLineF(polygon.last(), pos).length() >= tolerancePx)) {
+      polygon.append(pos);
+    }
+  }
+  if (polygon.count() < 3) {
+    return QPainterPath();  // Smaller than the tolerance, thus invisible.
+  }
+  QPainterPath p;
+  p.addPolygon(polygon);
+  p.closeSubpath();
+  return p;
+}
+
 void BGI_Plane::updateLayer() noexcept {
   if (mPlane.getLayer() == Layer::topCopper()) {
     setZValue(BoardGraphicsScene::ZValue_PlanesTop);
@@ -101,6 +101,9 @@ private:  // Methods
   void layerEdited(const GraphicsLayer& layer,
                    GraphicsLayer::Event event) noexcept;
   void updateOutlineAndFragments() noexcept;
+  const QVector<QPainterPath>& getAreas(qreal lod) noexcept;
+  static QPainterPath simplifyArea(const Path& path,
+                                   qreal tolerancePx) noexcept;
   void updateLayer() noexcept;
   void updateVisibility() noexcept;
   void updateBoundingRectMargin() noexcept;
@@ -118,6 +121,7 @@ private:  // Data
   QPainterPath mShape;
   QPainterPath mOutline;
   QVector<QPainterPath> mAreas;
+  QHash<int, QVector<QPainterPath>> mSimplifiedAreas;  ///< Key: Zoom level
   qreal mLineWidthPx;
   qreal mVertexHandleRadiusPx;
   struct VertexHandle {
@@ -49,6 +49,7 @@ BGI_Polygon::BGI_Polygon(BI_Polygon& polygon,
     mOnEditedSlot(*this, &BGI_Polygon::polygonEdited) {
   setFlag(QGraphicsItem::ItemHasNoContents, true);
   setFlag(QGraphicsItem::ItemIsSelectable, true);
+  mGraphicsItem->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 
   updateZValue();
   updateEditable();
@@ -60,6 +60,10 @@ BGI_StrokeText::BGI_StrokeText(BI_StrokeText& text,
 
   mOriginCrossGraphicsItem->setSize(UnsignedLength(1000000));
 
+  // At low zoom levels, draw unreadable texts as boxes to save rendering time.
+  mPathGraphicsItem->setSimplifiedBelowSizePx(10);
+  mPathGraphicsItem->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
   updatePosition();
   updateTransform();
   updateLayer();
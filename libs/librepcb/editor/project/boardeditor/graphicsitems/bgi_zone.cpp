@@ -48,6 +48,7 @@ BGI_Zone::BGI_Zone(BI_Zone& zone, const IF_GraphicsLayerProvider& lp) noexcept
     mOnEditedSlot(*this, &BGI_Zone::zoneEdited) {
   setFlag(QGraphicsItem::ItemHasNoContents, true);
   setFlag(QGraphicsItem::ItemIsSelectable, true);
+  mGraphicsItem->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 
   mGraphicsItem->setAllLayers(mZone.getBoard().getCopperLayers());
   mGraphicsItem->setEnabledLayers(mZone.getData().getLayers());
@@ -30,7 +30,7 @@
 
 #include <librepcb/core/application.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
-#include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/erc/projectbackgrounderc.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
@@ -53,6 +53,7 @@ ProjectEditor::ProjectEditor(
   : QObject(nullptr),
     mWorkspace(workspace),
     mProject(project),
+    mBackgroundErc(new ProjectBackgroundErc(this)),
     mHighlightedNetSignals(new QSet<const NetSignal*>()),
     mUndoStack(nullptr),
     mSchematicEditor(nullptr),
@@ -94,9 +95,16 @@ ProjectEditor::ProjectEditor(
     throw;  // ...and rethrow the exception
   }
 
-  // Run the ERC after opening and after every modification.
-  QTimer::singleShot(200, this, &ProjectEditor::runErc);
-  connect(mUndoStack, &UndoStack::stateModified, this, &ProjectEditor::runErc);
+  // Run the ERC after opening and after every modification. To keep the UI
+  // responsive, it runs in a worker thread and is delayed until there were no
+  // more modifications for a moment (e.g. while dragging items around).
+  mErcTimer.setSingleShot(true);
+  connect(&mErcTimer, &QTimer::timeout, this, &ProjectEditor::runErc);
+  connect(mBackgroundErc.data(), &ProjectBackgroundErc::messagesUpdated, this,
+          &ProjectEditor::ercMessagesUpdated);
+  connect(mUndoStack, &UndoStack::stateModified, this,
+          &ProjectEditor::scheduleErc);
+  mErcTimer.start(200);
 
   // setup the timer for automatic backups, if enabled in the settings
   int intervalSecs =
@@ -436,28 +444,33 @@ void ProjectEditor::clearHighlightedNetSignals() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+void ProjectEditor::scheduleErc() noexcept {
+  mBackgroundErc->invalidate();
+  mErcTimer.start(300);
+}
+
 void ProjectEditor::runErc() noexcept {
   try {
-    QElapsedTimer timer;
-    timer.start();
-    ElectricalRuleCheck erc(mProject);
-    mErcMessages = erc.runChecks();
-
-    // Detect disappeared messages & remove their approvals.
-    QSet<SExpression> approvals =
-        RuleCheckMessage::getAllApprovals(mErcMessages);
-    mSupportedErcApprovals |= approvals;
-    mDisappearedErcApprovals = mSupportedErcApprovals - approvals;
-    approvals = mProject.getErcMessageApprovals() - mDisappearedErcApprovals;
-    saveErcMessageApprovals(approvals);
-
-    emit ercFinished(mErcMessages);
-    qDebug() << "ERC succeeded after" << timer.elapsed() << "ms.";
+    mBackgroundErc->start(mProject);  // can throw
   } catch (const Exception& e) {
     qCritical() << "ERC failed:" << e.getMsg();
   }
 }
 
+void ProjectEditor::ercMessagesUpdated(
+    const RuleCheckMessageList& messages) noexcept {
+  mErcMessages = messages;
+
+  // Detect disappeared messages & remove their approvals.
+  QSet<SExpression> approvals = RuleCheckMessage::getAllApprovals(mErcMessages);
+  mSupportedErcApprovals |= approvals;
+  mDisappearedErcApprovals = mSupportedErcApprovals - approvals;
+  approvals = mProject.getErcMessageApprovals() - mDisappearedErcApprovals;
+  saveErcMessageApprovals(approvals);
+
+  emit ercFinished(mErcMessages);
+}
+
 void ProjectEditor::saveErcMessageApprovals(
     const QSet<SExpression>& approvals) noexcept {
   if (mProject.setErcMessageApprovals(approvals)) {
@@ -44,6 +44,7 @@ class FilePath;
 class LengthUnit;
 class NetSignal;
 class Project;
+class ProjectBackgroundErc;
 class Workspace;
 
 namespace editor {
@@ -256,7 +257,9 @@ signals:
   void projectEditorClosed();
 
 private:  // Methods
+  void scheduleErc() noexcept;
   void runErc() noexcept;
+  void ercMessagesUpdated(const RuleCheckMessageList& messages) noexcept;
   void saveErcMessageApprovals(const QSet<SExpression>& approvals) noexcept;
   int getCountOfVisibleEditorWindows() const noexcept;
 
@@ -273,6 +276,8 @@ private:  // Data
   QSet<SExpression> mSupportedErcApprovals;
   QSet<SExpression> mDisappearedErcApprovals;
   RuleCheckMessageList mErcMessages;
+  QScopedPointer<ProjectBackgroundErc> mBackgroundErc;
+  QTimer mErcTimer;  ///< Delays the ERC until modifications are finished
 
   std::shared_ptr<QSet<const NetSignal*>> mHighlightedNetSignals;
 
@@ -144,6 +144,12 @@ QList<std::shared_ptr<QGraphicsItem>> SchematicEditorState::findItemsAtPos(
     posAreaInGrid.addEllipse(pos.toPxQPointF(), gridDistancePx, gridDistancePx);
   }
 
+  // Only items near the cursor need to be checked in detail. Getting them
+  // from the spatial index of the scene is a lot faster than calculating the
+  // grab area of every single item on large schematics.
+  const QSet<QGraphicsItem*> nearbyItems = scene->getItemsInRect(
+      posAreaLarge.boundingRect() | posAreaInGrid.boundingRect());
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -178,7 +184,7 @@ QList<std::shared_ptr<QGraphicsItem>> SchematicEditorState::findItemsAtPos(
                       flags, &except, &addItem, &canSkip](
                          std::shared_ptr<QGraphicsItem> item,
                          const Point& nearestPos, int priority, bool large) {
-    if (except.contains(item)) {
+    if ((!item) || except.contains(item)) {
       return;
     }
     auto prio = std::make_pair(priority, 0);
@@ -216,66 +222,84 @@ QList<std::shared_ptr<QGraphicsItem>> SchematicEditorState::findItemsAtPos(
     }
   };
 
-  if (flags.testFlag(FindFlag::NetPoints)) {
-    for (auto it = scene->getNetPoints().begin();
-         it != scene->getNetPoints().end(); it++) {
-      processItem(it.value(), it.key()->getPosition(),
-                  it.key()->isVisibleJunction() ? 0 : 10, false);
+  // Map the items near the cursor back to their schematic items to filter
+  // them. Note that hidden items are not contained in the spatial index, thus
+  // they are never found.
+  QSet<QGraphicsItem*> nearbyPolygons;
+  foreach (QGraphicsItem* graphicsItem, nearbyItems) {
+    if (auto sgi = dynamic_cast<SGI_NetPoint*>(graphicsItem)) {
+      SI_NetPoint& netPoint = sgi->getNetPoint();
+      if (flags.testFlag(FindFlag::NetPoints)) {
+        processItem(scene->getNetPoints().value(&netPoint),
+                    netPoint.getPosition(),
+                    netPoint.isVisibleJunction() ? 0 : 10, false);
+      }
     }
-  }
 
-  if (flags.testFlag(FindFlag::NetLines)) {
-    for (auto it = scene->getNetLines().begin();
-         it != scene->getNetLines().end(); it++) {
-      processItem(
-          it.value(),
-          Toolbox::nearestPointOnLine(pos.mappedToGrid(getGridInterval()),
-                                      it.key()->getStartPoint().getPosition(),
-                                      it.key()->getEndPoint().getPosition()),
-          20, true);  // Large grab area, better usability!
+    if (auto sgi = dynamic_cast<SGI_NetLine*>(graphicsItem)) {
+      SI_NetLine& netLine = sgi->getNetLine();
+      if (flags.testFlag(FindFlag::NetLines)) {
+        processItem(
+            scene->getNetLines().value(&netLine),
+            Toolbox::nearestPointOnLine(pos.mappedToGrid(getGridInterval()),
+                                        netLine.getStartPoint().getPosition(),
+                                        netLine.getEndPoint().getPosition()),
+            20, true);  // Large grab area, better usability!
+      }
     }
-  }
 
-  if (flags.testFlag(FindFlag::NetLabels)) {
-    for (auto it = scene->getNetLabels().begin();
-         it != scene->getNetLabels().end(); it++) {
-      processItem(it.value(), it.key()->getPosition(), 30, false);
+    if (auto sgi = dynamic_cast<SGI_NetLabel*>(graphicsItem)) {
+      SI_NetLabel& netLabel = sgi->getNetLabel();
+      if (flags.testFlag(FindFlag::NetLabels)) {
+        processItem(scene->getNetLabels().value(&netLabel),
+                    netLabel.getPosition(), 30, false);
+      }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Symbols)) {
-    for (auto it = scene->getSymbols().begin(); it != scene->getSymbols().end();
-         it++) {
-      processItem(it.value(), it.key()->getPosition(), 40, false);
+    if (auto sgi = dynamic_cast<SGI_Symbol*>(graphicsItem)) {
+      SI_Symbol& symbol = sgi->getSymbol();
+      if (flags.testFlag(FindFlag::Symbols)) {
+        processItem(scene->getSymbols().value(&symbol), symbol.getPosition(),
+                    40, false);
+      }
     }
-  }
 
-  if (flags &
-      (FindFlag::SymbolPins | FindFlag::SymbolPinsWithComponentSignal)) {
-    for (auto it = scene->getSymbolPins().begin();
-         it != scene->getSymbolPins().end(); it++) {
+    if (auto sgi = dynamic_cast<SGI_SymbolPin*>(graphicsItem)) {
+      SI_SymbolPin& pin = sgi->getPin();
       if (flags.testFlag(FindFlag::SymbolPins) ||
-          (it.key()->getComponentSignalInstance())) {
-        processItem(it.value(), it.key()->getPosition(), 50, false);
+          (flags.testFlag(FindFlag::SymbolPinsWithComponentSignal) &&
+           pin.getComponentSignalInstance())) {
+        processItem(scene->getSymbolPins().value(&pin), pin.getPosition(), 50,
+                    false);
       }
     }
-  }
 
-  if (flags.testFlag(FindFlag::Polygons)) {
-    for (auto it = scene->getPolygons().begin();
-         it != scene->getPolygons().end(); it++) {
-      processItem(
-          it.value(),
-          it.key()->getPolygon().getPath().calcNearestPointBetweenVertices(pos),
-          60,
-          true);  // Probably large grab area makes sense?
+    if (dynamic_cast<PolygonGraphicsItem*>(graphicsItem)) {
+      nearbyPolygons.insert(graphicsItem);
+    }
+
+    if (auto sgi = dynamic_cast<SGI_Text*>(graphicsItem)) {
+      SI_Text& text = sgi->getText();
+      if (flags.testFlag(FindFlag::Texts)) {
+        processItem(scene->getTexts().value(&text), text.getPosition(), 70,
+                    false);
+      }
     }
   }
 
-  if (flags.testFlag(FindFlag::Texts)) {
-    for (auto it = scene->getTexts().begin(); it != scene->getTexts().end();
-         it++) {
-      processItem(it.value(), it.key()->getPosition(), 70, false);
+  // Polygon graphics items do not know their schematic item, so they are
+  // looked up only if there are any near the cursor.
+  if (flags.testFlag(FindFlag::Polygons) && (!nearbyPolygons.isEmpty())) {
+    for (auto it = scene->getPolygons().begin();
+         it != scene->getPolygons().end(); it++) {
+      if (nearbyPolygons.contains(it.value().get())) {
+        processItem(
+            it.value(),
+            it.key()->getPolygon().getPath().calcNearestPointBetweenVertices(
+                pos),
+            60,
+            true);  // Probably large grab area makes sense?
+      }
     }
   }
 
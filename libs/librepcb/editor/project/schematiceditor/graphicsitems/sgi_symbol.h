@@ -69,6 +69,9 @@ public:
   SI_Symbol& getSymbol() noexcept { return mSymbol; }
 
   // Inherited from QGraphicsItem
+  QRectF boundingRect() const noexcept override {
+    return mShape.boundingRect();  // Required for the scene's spatial index.
+  }
   QPainterPath shape() const noexcept override { return mShape; }
 
   // Operator Overloadings
@@ -0,0 +1,96 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_BENCHMARKS_BENCHMARKHELPERS_H
+#define LIBREPCB_BENCHMARKS_BENCHMARKHELPERS_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Class BenchmarkHelpers
+ ******************************************************************************/
+
+class BenchmarkHelpers final {
+public:
+  BenchmarkHelpers() = delete;
+
+  /**
+   * @brief Measure the average execution time of a function
+   *
+   * @param name        Name of the measurement, printed with the result.
+   * @param iterations  How often the function shall be called.
+   * @param func        The function to measure.
+   *
+   * @return The average execution time in microseconds (at least 1).
+   */
+  static qint64 measure(const QString& name, int iterations,
+                        std::function<void()> func) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+      func();
+    }
+    const qint64 us =
+        std::max(timer.nsecsElapsed() / 1000 / std::max(iterations, 1),
+                 qint64(1));
+    std::cout << "  " << qPrintable(name) << ": " << us << " us" << std::endl;
+    return us;
+  }
+
+  /**
+   * @brief Get the resident memory of the current process
+   *
+   * @note Only implemented on Linux, as it reads `/proc/self/status`.
+   *
+   * @return The resident memory in kB, or -1 if not available.
+   */
+  static qint64 getResidentMemoryKb() {
+    QFile file("/proc/self/status");
+    if (file.open(QIODevice::ReadOnly)) {
+      foreach (const QByteArray& line, file.readAll().split('\n')) {
+        if (line.startsWith("VmRSS:")) {
+          return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+      }
+    }
+    return -1;
+  }
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../benchmarkhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/export/gerberaperturelist.h>
+#include <librepcb/core/export/gerbergenerator.h>
+#include <librepcb/core/types/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class GerberGeneratorBenchmark : public ::testing::Test {
+protected:
+  // 50k pads with 250 different sizes and 4 different rotations, similar to
+  // the copper layer of a large board.
+  static const int sPadCount = 50000;
+
+  static PositiveLength getPadWidth(int i) noexcept {
+    return PositiveLength(100000 + (i % 250) * 1000);
+  }
+
+  static PositiveLength getPadHeight(int i) noexcept {
+    Q_UNUSED(i);
+    return PositiveLength(200000);
+  }
+
+  static Angle getPadRotation(int i) noexcept {
+    return Angle::deg90() * ((i / 250) % 4);
+  }
+};
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+TEST_F(GerberGeneratorBenchmark, addApertures) {
+  const GerberApertureList::Function function =
+      tl::make_optional(GerberAttribute::ApertureFunction::SmdPad);
+  BenchmarkHelpers::measure("150k apertures", 5, [&function]() {
+    GerberApertureList l;
+    for (int i = 0; i < sPadCount; ++i) {
+      const PositiveLength w = getPadWidth(i);
+      const PositiveLength h = getPadHeight(i);
+      const Angle rot = getPadRotation(i);
+      l.addRect(w, h, UnsignedLength(0), rot, function);
+      l.addObround(w, h, rot, function);
+      l.addCircle(positiveToUnsigned(w), tl::nullopt);
+    }
+  });
+}
+
+TEST_F(GerberGeneratorBenchmark, exportPads) {
+  const GerberGenerator::Function function =
+      tl::make_optional(GerberAttribute::ApertureFunction::SmdPad);
+  BenchmarkHelpers::measure("50k pads", 5, [&function]() {
+    GerberGenerator gen(
+        QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4)), "Project Name",
+        Uuid::fromString("bdf7bea5-b88e-41b2-be85-c1604e8ddfca"), "rev-1.0");
+    gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                              GerberGenerator::Polarity::Positive);
+    for (int i = 0; i < sPadCount; ++i) {
+      const QString net = "NET" % QString::number(i % 1000);
+      const QString component = "U" % QString::number(i / 4);
+      const Point pos(i * 10000, (i % 100) * 10000);
+      gen.flashRect(pos, getPadWidth(i), getPadHeight(i), UnsignedLength(0),
+                    getPadRotation(i), function, net, component,
+                    QString::number(i % 4), net);
+    }
+    gen.generate();
+  });
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
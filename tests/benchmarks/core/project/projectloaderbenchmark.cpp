@@ -0,0 +1,87 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../benchmarkhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class ProjectLoaderBenchmark : public ::testing::Test {
+protected:
+  static std::unique_ptr<Project> openProject(const FilePath& fp) {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRO(fp.getParentDir());  // can throw
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(fs)),
+                       fp.getFilename());  // can throw
+  }
+};
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+/**
+ * Measures the load time and the memory used by the loaded project for all
+ * projects in the test data directory.
+ */
+TEST_F(ProjectLoaderBenchmark, openTestDataProjects) {
+  QDirIterator it(TEST_DATA_DIR "/projects", {"*.lpp"}, QDir::Files,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    const FilePath fp(it.next());
+    BenchmarkHelpers::measure(fp.getFilename(), 3,
+                              [&fp]() { openProject(fp); });
+
+    const qint64 before = BenchmarkHelpers::getResidentMemoryKb();
+    std::unique_ptr<Project> project = openProject(fp);
+    const qint64 after = BenchmarkHelpers::getResidentMemoryKb();
+    if ((before >= 0) && (after >= 0)) {
+      std::cout << "    " << (after - before) << " kB resident memory"
+                << std::endl;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../benchmarkhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class SExpressionBenchmark : public ::testing::Test {
+protected:
+  /**
+   * Generate a board with many net segments, similar to real boards.
+   */
+  static QByteArray generateBoard(int netSegments) {
+    QByteArray data =
+        "(librepcb_board 71762d7e-e7f1-403c-8020-db9670c01e9b\n";
+    for (int i = 0; i < netSegments; ++i) {
+      const QByteArray n = QByteArray::number(i);
+      data += " (netsegment 3115f409-5e6c-4023-a8ab-06428ed0720a\n";
+      data += "  (net 06ffbb2b-0c44-4f8c-b4f5-7e8b9a9b9c0d)\n";
+      data += "  (via 2cc45b07-1bef-4340-9292-b54b011c70c5";
+      data += " (from top_cu) (to bot_cu)\n";
+      data += "   (position " + n + ".91989 46.0375) (size 0.7) (drill 0.3)\n";
+      data += "  )\n";
+      data += "  (line 8e2c5de3-b2e1-4e59-9a4b-c3a1d4e2f1a0";
+      data += " (layer top_cu) (width 0.25)\n";
+      data += "   (from (via 2cc45b07-1bef-4340-9292-b54b011c70c5))\n";
+      data += "   (to (junction 0c8f3a1e-7f7b-4c9a-9a56-2e3b1c1f4d5e))\n";
+      data += "  )\n";
+      data += "  (junction 0c8f3a1e-7f7b-4c9a-9a56-2e3b1c1f4d5e";
+      data += " (position 1." + n + " 2.54))\n";
+      data += "  (name \"Segment " + n + " \\\"quoted\\\"\")\n";
+      data += " )\n";
+    }
+    data += ")\n";
+    return data;
+  }
+
+  static void benchmarkParse(const QString& name, const QByteArray& content) {
+    const qint64 us = BenchmarkHelpers::measure(name, 5, [&content]() {
+      SExpression::parse(content, FilePath());  // can throw
+    });
+    std::cout << "    " << content.size() << " bytes, "
+              << (content.size() / us) << " MB/s" << std::endl;
+  }
+};
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+TEST_F(SExpressionBenchmark, parseGeneratedBoard) {
+  benchmarkParse("20k net segments", generateBoard(20000));
+}
+
+TEST_F(SExpressionBenchmark, parseTestDataBoards) {
+  QDirIterator it(TEST_DATA_DIR "/projects", {"board.lp"}, QDir::Files,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    QFile file(it.next());
+    if (file.open(QIODevice::ReadOnly)) {
+      benchmarkParse(file.fileName(), file.readAll());
+    }
+  }
+}
+
+TEST_F(SExpressionBenchmark, serializeGeneratedBoard) {
+  const SExpression root =
+      SExpression::parse(generateBoard(20000), FilePath());  // can throw
+  BenchmarkHelpers::measure("20k net segments", 5,
+                            [&root]() { root.toByteArray(); });
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
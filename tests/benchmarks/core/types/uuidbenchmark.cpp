@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../benchmarkhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/types/uuid.h>
+
+#include <QtCore>
+
+#include <functional>
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmark Class
+ ******************************************************************************/
+
+class UuidBenchmark : public ::testing::Test {
+protected:
+  static const int sCount = 100000;
+  static const int sIterations = 10;
+
+  QVector<Uuid> mUuids;
+  QVector<QString> mStrings;
+
+  UuidBenchmark() {
+    for (int i = 0; i < sCount; ++i) {
+      mUuids.append(Uuid::createRandom());
+      mStrings.append(mUuids.last().toStr());
+    }
+  }
+
+  /**
+   * Measure a function processing all UUIDs, and print the checksum returned
+   * by the function to avoid the compiler optimizing away the work.
+   */
+  static void measure(const QString& name, std::function<qint64()> func) {
+    qint64 sum = 0;
+    const qint64 us = BenchmarkHelpers::measure(
+        name, sIterations, [&func, &sum]() { sum += func(); });
+    std::cout << "    " << (us * 1000 / sCount) << " ns per element (checksum "
+              << sum << ")" << std::endl;
+  }
+};
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+TEST_F(UuidBenchmark, containerLookup) {
+  QMap<Uuid, int> map;
+  QHash<Uuid, int> hash;
+  for (int i = 0; i < mUuids.count(); ++i) {
+    map.insert(mUuids.at(i), i);
+    hash.insert(mUuids.at(i), i);
+  }
+  measure("QMap lookup", [this, &map]() {
+    qint64 sum = 0;
+    foreach (const Uuid& uuid, mUuids) { sum += map.value(uuid); }
+    return sum;
+  });
+  measure("QHash lookup", [this, &hash]() {
+    qint64 sum = 0;
+    foreach (const Uuid& uuid, mUuids) { sum += hash.value(uuid); }
+    return sum;
+  });
+}
+
+TEST_F(UuidBenchmark, stringConversion) {
+  measure("fromString()", [this]() {
+    qint64 sum = 0;
+    foreach (const QString& str, mStrings) {
+      sum += (Uuid::fromString(str) == mUuids.first()) ? 1 : 0;
+    }
+    return sum;
+  });
+  measure("toStr()", [this]() {
+    qint64 sum = 0;
+    foreach (const Uuid& uuid, mUuids) { sum += uuid.toStr().length(); }
+    return sum;
+  });
+}
+
+TEST_F(UuidBenchmark, memory) {
+  const qint64 before = BenchmarkHelpers::getResidentMemoryKb();
+  QVector<Uuid> copies;
+  copies.reserve(sCount * sIterations);
+  for (int i = 0; i < sIterations; ++i) {
+    foreach (const QString& str, mStrings) {
+      copies.append(Uuid::fromString(str));
+    }
+  }
+  const qint64 after = BenchmarkHelpers::getResidentMemoryKb();
+  std::cout << "  sizeof(Uuid): " << sizeof(Uuid) << " bytes" << std::endl;
+  if ((before >= 0) && (after >= 0)) {
+    std::cout << "  " << copies.count() << " parsed UUIDs: "
+              << (after - before) << " kB resident memory" << std::endl;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
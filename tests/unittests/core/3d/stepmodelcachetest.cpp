@@ -0,0 +1,165 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/3d/stepmodelcache.h>
+#include <librepcb/core/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StepModelCacheTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  StepModelCacheTest() { mTmpDir = FilePath::getRandomTempPath(); }
+
+  virtual ~StepModelCacheTest() {
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+
+  static StepModelCache::Model createModel() {
+    StepModelCache::Model model;
+    model.insert(OccModel::Color(0.1, 0.2, 0.3),
+                 {QVector3D(1, 2, 3), QVector3D(-4.5, 5.5, 6.25),
+                  QVector3D(0, 0, 0)});
+    model.insert(OccModel::Color(1, 1, 1), {});
+    return model;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StepModelCacheTest, testSerializeDeserialize) {
+  const StepModelCache::Model model = createModel();
+  const tl::optional<StepModelCache::Model> result =
+      StepModelCache::deserialize(StepModelCache::serialize(model));
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(model, *result);
+}
+
+TEST_F(StepModelCacheTest, testSerializeDeserializeEmpty) {
+  const tl::optional<StepModelCache::Model> result =
+      StepModelCache::deserialize(
+          StepModelCache::serialize(StepModelCache::Model()));
+  ASSERT_TRUE(result.has_value());
+  EXPECT_TRUE(result->isEmpty());
+}
+
+TEST_F(StepModelCacheTest, testDeserializeInvalid) {
+  const QByteArray data = StepModelCache::serialize(createModel());
+  EXPECT_FALSE(StepModelCache::deserialize(QByteArray()).has_value());
+  EXPECT_FALSE(StepModelCache::deserialize("foo bar").has_value());
+  EXPECT_FALSE(
+      StepModelCache::deserialize(data.left(data.size() - 1)).has_value());
+  EXPECT_FALSE(StepModelCache::deserialize(data + "x").has_value());
+}
+
+TEST_F(StepModelCacheTest, testLoadNotCached) {
+  StepModelCache cache(mTmpDir, 1000000);
+  EXPECT_FALSE(cache.load("foo").has_value());
+}
+
+TEST_F(StepModelCacheTest, testStoreAndLoad) {
+  const StepModelCache::Model model = createModel();
+  {
+    StepModelCache cache(mTmpDir, 1000000);
+    cache.store("foo", model);
+  }
+  StepModelCache cache(mTmpDir, 1000000);
+  const tl::optional<StepModelCache::Model> result = cache.load("foo");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(model, *result);
+  EXPECT_FALSE(cache.load("bar").has_value());
+}
+
+TEST_F(StepModelCacheTest, testStoreAndLoadEmpty) {
+  StepModelCache cache(mTmpDir, 1000000);
+  cache.store("", createModel());
+  EXPECT_FALSE(cache.load("").has_value());
+  EXPECT_EQ(0, QDir(mTmpDir.toStr()).entryList(QDir::Files).count());
+}
+
+TEST_F(StepModelCacheTest, testPrune) {
+  const qint64 fileSize = StepModelCache::serialize(createModel()).size();
+  StepModelCache cache(mTmpDir, fileSize * 4);
+  cache.store("1", createModel());
+  cache.store("2", createModel());
+  cache.store("3", createModel());
+  cache.store("4", createModel());
+  EXPECT_EQ(4, QDir(mTmpDir.toStr()).entryList(QDir::Files).count());
+
+  // Exceeding the maximum size removes files until only 75% of it is used.
+  cache.store("5", createModel());
+  EXPECT_EQ(3, QDir(mTmpDir.toStr()).entryList(QDir::Files).count());
+  EXPECT_TRUE(cache.load("5").has_value());
+
+  // Thus the next file fits into the cache without pruning.
+  cache.store("6", createModel());
+  EXPECT_EQ(4, QDir(mTmpDir.toStr()).entryList(QDir::Files).count());
+  EXPECT_TRUE(cache.load("6").has_value());
+}
+
+TEST_F(StepModelCacheTest, testPruneFilesOfOtherInstances) {
+  const qint64 fileSize = StepModelCache::serialize(createModel()).size();
+  {
+    StepModelCache cache(mTmpDir, fileSize * 4);
+    cache.store("1", createModel());
+    cache.store("2", createModel());
+    cache.store("3", createModel());
+    cache.store("4", createModel());
+  }
+
+  // The existing files are taken into account on the first store().
+  StepModelCache cache(mTmpDir, fileSize * 4);
+  cache.store("5", createModel());
+  EXPECT_EQ(3, QDir(mTmpDir.toStr()).entryList(QDir::Files).count());
+  EXPECT_TRUE(cache.load("5").has_value());
+}
+
+TEST_F(StepModelCacheTest, testLoadCorruptFile) {
+  StepModelCache cache(mTmpDir, 1000000);
+  cache.store("foo", createModel());
+  const QStringList files = QDir(mTmpDir.toStr()).entryList(QDir::Files);
+  ASSERT_EQ(1, files.count());
+  FileUtils::writeFile(mTmpDir.getPathTo(files.first()), "corrupt");
+  EXPECT_FALSE(cache.load("foo").has_value());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -344,6 +344,28 @@ TEST_F(GerberApertureListTest, testAttributesGetDeletedAtEnd) {
   EXPECT_EQ(expected, l.generateString().toStdString());
 }
 
+// Test if existing apertures are found again when there are many of them,
+// with different properties and attributes.
+TEST_F(GerberApertureListTest, testManyApertures) {
+  GerberApertureList l;
+  const GerberApertureList::Function function =
+      tl::make_optional(GerberAttribute::ApertureFunction::ComponentPad);
+
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int i = 0; i < 500; ++i) {
+      const PositiveLength size((i + 1) * 1000);
+      EXPECT_EQ(10 + i * 4, l.addCircle(positiveToUnsigned(size), function));
+      EXPECT_EQ(11 + i * 4, l.addCircle(positiveToUnsigned(size), tl::nullopt));
+      EXPECT_EQ(12 + i * 4,
+                l.addRect(size, size, UnsignedLength(0), Angle::deg0(),
+                          function));
+      EXPECT_EQ(13 + i * 4,
+                l.addRect(size, size, UnsignedLength(0), Angle::deg0(),
+                          tl::nullopt));
+    }
+  }
+}
+
 // Test if a circle of size 0 (which is allowed) is exported according specs.
 TEST_F(GerberApertureListTest, testCircleDiameterZero) {
   GerberApertureList l;
@@ -234,6 +234,46 @@ TEST_F(GerberGeneratorTest, testDoesNotContainZeroSizeApertures) {
   ASSERT_GE(checkedCircles, 3);  // Sanity check if test works.
 }
 
+// Check if coordinates are formatted exactly as before, i.e. as plain
+// integers in nanometers, including negative and large values.
+TEST_F(GerberGeneratorTest, testCoordinateFormat) {
+  GerberGenerator gen(QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4)),
+                      "Project Name",
+                      Uuid::fromString("bdf7bea5-b88e-41b2-be85-c1604e8ddfca"),
+                      "rev-1.0");
+  Path path({Vertex(Point(0, -1), Angle::deg0()),
+             Vertex(Point(-1234567890, 987654321), Angle::deg0()),
+             Vertex(Point(10, 20), Angle::deg180()),
+             Vertex(Point(30, 20), Angle::deg0())});
+  gen.drawPathOutline(path, UnsignedLength(100000), tl::nullopt, tl::nullopt,
+                      QString());
+  gen.generate();
+  const QString s = gen.toStr();
+  EXPECT_TRUE(s.contains("D10*\n"
+                         "X0Y-1D02*\n"
+                         "X-1234567890Y987654321D01*\n"
+                         "X10Y20D01*\n"
+                         "G03*\n"
+                         "X30Y20I10J0D01*\n"
+                         "G01*\n"))
+      << s.toStdString();
+}
+
+// Check if the MD5 checksum is calculated over the whole content except the
+// line breaks.
+TEST_F(GerberGeneratorTest, testMd5Checksum) {
+  QString s = generateEverything();
+  const int md5Pos = s.indexOf("TF.MD5,");
+  ASSERT_GT(md5Pos, 0);
+  const int lineStart = s.lastIndexOf('\n', md5Pos) + 1;
+  QString content = s.left(lineStart);
+  content.remove('\n');
+  const QString md5 = QString(
+      QCryptographicHash::hash(content.toUtf8(), QCryptographicHash::Md5)
+          .toHex());
+  EXPECT_EQ(md5.toStdString(), s.mid(md5Pos + 7, 32).toStdString());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
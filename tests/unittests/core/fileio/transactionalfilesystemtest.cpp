@@ -750,6 +750,62 @@ TEST_F(TransactionalFileSystemTest, testCheckForModifications) {
   EXPECT_EQ(0, fs.checkForModifications().count());
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteUnmodifiedContent) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  ASSERT_EQ("1", fs.read("1.txt"));
+  fs.write("1.txt", "new 1");
+  EXPECT_EQ(QStringList{"1.txt"}, fs.checkForModifications());
+
+  // Writing the same content as on the disk is no modification.
+  fs.write("1.txt", "1");
+  EXPECT_EQ(0, fs.checkForModifications().count());
+  EXPECT_EQ("1", fs.read("1.txt"));
+
+  // Same for files written by the file system itself.
+  fs.write("x/y/z", "z");
+  fs.save();
+  fs.write("x/y/z", "z");
+  EXPECT_EQ(0, fs.checkForModifications().count());
+}
+
+TEST_F(TransactionalFileSystemTest, testWriteContentModifiedOnDisk) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  ASSERT_EQ("1", fs.read("1.txt"));
+
+  // If the file was modified by someone else, writing the content which was
+  // read before must overwrite that modification.
+  FileUtils::writeFile(fs.getAbsPath("1.txt"), "modified");
+  fs.write("1.txt", "1");
+  EXPECT_EQ(QStringList{"1.txt"}, fs.checkForModifications());
+  fs.save();
+  EXPECT_EQ("1", FileUtils::readFile(fs.getAbsPath("1.txt")));
+}
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
+TEST_F(TransactionalFileSystemTest, testWriteContentModifiedWithSameMetadata) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("x", "content");
+  fs.save();
+
+  // On file systems with coarse timestamps, a modification right after
+  // saving might neither change the file size nor its modification time.
+  const FilePath fp = fs.getAbsPath("x");
+  const QDateTime lastModified = QFileInfo(fp.toStr()).lastModified();
+  FileUtils::writeFile(fp, "CONTENT");
+  QFile file(fp.toStr());
+  ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+  ASSERT_TRUE(
+      file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+  file.close();
+
+  // Thus writing the saved content must still overwrite that modification.
+  fs.write("x", "content");
+  EXPECT_EQ(QStringList{"x"}, fs.checkForModifications());
+  fs.save();
+  EXPECT_EQ("content", FileUtils::readFile(fp));
+}
+#endif
+
 TEST_F(TransactionalFileSystemTest, testReleaseLock) {
   const FilePath lockFp = mPopulatedDir.getPathTo(".lock");
 
@@ -0,0 +1,138 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/font/strokefont.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/types/alignment.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontTest : public ::testing::Test {
+protected:
+  struct Result {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+  };
+
+  static Result stroke(const QString& text, const PositiveLength& height,
+                       const Length& letterSpacing, const Length& lineSpacing,
+                       const Alignment& align) {
+    Result r;
+    r.paths = Application::getDefaultStrokeFont().stroke(
+        text, height, letterSpacing, lineSpacing, align, r.bottomLeft,
+        r.topRight);
+    return r;
+  }
+
+  static Result strokeDefault() {
+    return stroke("Hello\nWorld 123", PositiveLength(1000000), Length(100000),
+                  Length(1500000),
+                  Alignment(HAlign::left(), VAlign::bottom()));
+  }
+
+  static void expectEqual(const Result& a, const Result& b) {
+    EXPECT_EQ(a.paths, b.paths);
+    EXPECT_EQ(a.bottomLeft, b.bottomLeft);
+    EXPECT_EQ(a.topRight, b.topRight);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontTest, testStrokeTwiceGivesSameResult) {
+  const Result first = strokeDefault();
+  const Result second = strokeDefault();  // Probably from cache.
+  EXPECT_FALSE(first.paths.isEmpty());
+  EXPECT_NE(first.bottomLeft, first.topRight);
+  expectEqual(first, second);
+}
+
+TEST_F(StrokeFontTest, testDifferentHeightGivesDifferentResult) {
+  const Result first = strokeDefault();
+  const Result other =
+      stroke("Hello\nWorld 123", PositiveLength(2000000), Length(100000),
+             Length(1500000), Alignment(HAlign::left(), VAlign::bottom()));
+  EXPECT_NE(first.paths, other.paths);
+  EXPECT_NE(first.topRight, other.topRight);
+  expectEqual(first, strokeDefault());
+}
+
+TEST_F(StrokeFontTest, testDifferentLetterSpacingGivesDifferentResult) {
+  const Result first = strokeDefault();
+  const Result other =
+      stroke("Hello\nWorld 123", PositiveLength(1000000), Length(500000),
+             Length(1500000), Alignment(HAlign::left(), VAlign::bottom()));
+  EXPECT_NE(first.paths, other.paths);
+  EXPECT_NE(first.topRight, other.topRight);
+  expectEqual(first, strokeDefault());
+}
+
+TEST_F(StrokeFontTest, testDifferentLineSpacingGivesDifferentResult) {
+  const Result first = strokeDefault();
+  const Result other =
+      stroke("Hello\nWorld 123", PositiveLength(1000000), Length(100000),
+             Length(3000000), Alignment(HAlign::left(), VAlign::bottom()));
+  EXPECT_NE(first.paths, other.paths);
+  EXPECT_NE(first.topRight, other.topRight);
+  expectEqual(first, strokeDefault());
+}
+
+TEST_F(StrokeFontTest, testDifferentAlignmentGivesDifferentResult) {
+  const Result first = strokeDefault();
+  const Result other =
+      stroke("Hello\nWorld 123", PositiveLength(1000000), Length(100000),
+             Length(1500000), Alignment(HAlign::center(), VAlign::center()));
+  EXPECT_NE(first.paths, other.paths);
+  EXPECT_NE(first.bottomLeft, other.bottomLeft);
+  expectEqual(first, strokeDefault());
+}
+
+TEST_F(StrokeFontTest, testDifferentTextGivesDifferentResult) {
+  const Result first = strokeDefault();
+  const Result other =
+      stroke("Hello\nWorld 124", PositiveLength(1000000), Length(100000),
+             Length(1500000), Alignment(HAlign::left(), VAlign::bottom()));
+  EXPECT_NE(first.paths, other.paths);
+  expectEqual(first, strokeDefault());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -399,6 +399,15 @@ TEST_F(PathTest, testOctagonRoundedCornersSaturation) {
   EXPECT_EQ(str(expected), str(actual));
 }
 
+TEST_F(PathTest, testObroundWithLength) {
+  const Point p1(1000, 2000);
+  const Point p2(5000, -3000);
+  EXPECT_EQ(str(Path::obround(p1, p2, PositiveLength(300))),
+            str(Path::obround(p1, p2, Length(300))));
+  EXPECT_EQ(str(Path()), str(Path::obround(p1, p2, Length(0))));
+  EXPECT_EQ(str(Path()), str(Path::obround(p1, p2, Length(-300))));
+}
+
 // Test to reproduce https://github.com/LibrePCB/LibrePCB/issues/974
 TEST_F(PathTest, testFlatArc) {
   Path expected = Path({
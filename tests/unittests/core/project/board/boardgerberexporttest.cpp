@@ -87,7 +87,11 @@ TEST(BoardGerberExportTest, test) {
   config.setOutputBasePath(testDataDir.getPathTo("actual").toStr() %
                            "/{{PROJECT}}");
   BoardGerberExport grbExport(*board);
+  QVector<FilePath> callbackFiles;
+  grbExport.setBeforeWriteCallback(
+      [&callbackFiles](const FilePath& fp) { callbackFiles.append(fp); });
   grbExport.exportPcbLayers(config);
+  EXPECT_EQ(grbExport.getWrittenFiles(), callbackFiles);
   grbExport.exportComponentLayer(
       BoardGerberExport::BoardSide::Top,
       project->getCircuit().getAssemblyVariants().first()->getUuid(),
@@ -106,6 +106,56 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testUnmodifiedPlanesAreReused) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+  ASSERT_GE(board->getPlanes().count(), 2);
+
+  // build planes and remember the results
+  BoardPlaneFragmentsBuilder builder;
+  builder.runSynchronously(*board);  // can throw
+  QMap<Uuid, QVector<Path>> fragments;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    EXPECT_FALSE(plane->getFragmentsHash().isEmpty());
+    fragments[plane->getUuid()] = plane->getFragments();
+  }
+
+  // clear the fragments but keep the hashes, so a rebuild must not
+  // calculate them again
+  foreach (BI_Plane* plane, board->getPlanes()) {
+    plane->setCalculatedFragments({}, plane->getFragmentsHash());
+  }
+  builder.runSynchronously(*board);  // can throw
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    EXPECT_TRUE(plane->getFragments().isEmpty());
+  }
+
+  // without the hashes, all fragments have to be calculated again
+  foreach (BI_Plane* plane, board->getPlanes()) {
+    plane->setCalculatedFragments({});
+  }
+  builder.runSynchronously(*board);  // can throw
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    EXPECT_EQ(fragments[plane->getUuid()], plane->getFragments());
+  }
+
+  // modifying a plane must lead to a different hash
+  BI_Plane* plane = board->getPlanes().first();
+  const QByteArray hash = plane->getFragmentsHash();
+  plane->setMinClearance(UnsignedLength(plane->getMinClearance() + 1000));
+  builder.runSynchronously(*board);  // can throw
+  EXPECT_NE(hash.toHex().toStdString(),
+            plane->getFragmentsHash().toHex().toStdString());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
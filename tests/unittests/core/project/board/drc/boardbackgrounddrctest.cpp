@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../../testhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/drc/boardbackgrounddrc.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
+#include <librepcb/core/project/board/items/bi_device.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardBackgroundDrcTest : public ::testing::Test {
+protected:
+  static std::unique_ptr<Project> openProject() {
+    FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());  // can throw
+  }
+
+  static QStringList runFullCheck(Board& board) {
+    BoardDesignRuleCheck drc(board, board.getDrcSettings());
+    drc.execute(false);  // can throw
+    QStringList messages;
+    foreach (const auto& msg, drc.getMessages()) {
+      if (msg->as<DrcMsgCopperCopperClearanceViolation>()) {
+        messages.append(str(*msg));
+      }
+    }
+    return messages;
+  }
+
+  static QStringList runBackgroundCheck(BoardBackgroundDrc& drc,
+                                        Board& board) {
+    QStringList messages;
+    bool finished = false;
+    QMetaObject::Connection connection = QObject::connect(
+        &drc, &BoardBackgroundDrc::messagesUpdated,
+        [&](Board& b, const RuleCheckMessageList& list) {
+          EXPECT_EQ(&board, &b);
+          foreach (const auto& msg, list) {
+            messages.append(str(*msg));
+          }
+          finished = true;
+        });
+    drc.start(board);  // can throw
+    EXPECT_TRUE(TestHelpers::waitFor([&]() { return finished; }));
+    QObject::disconnect(connection);
+    return messages;
+  }
+
+  static QString str(const RuleCheckMessage& msg) {
+    QStringList locations;
+    foreach (const Path& path, msg.getLocations()) {
+      SExpression node = SExpression::createList("path");
+      path.serialize(node);
+      locations.append(QString::fromUtf8(node.toByteArray()));
+    }
+    return msg.getMessage() + " " +
+        QString::fromUtf8(msg.getApproval().toByteArray()) + " " +
+        locations.join(" ");
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardBackgroundDrcTest, testSameResultAsFullCheck) {
+  std::unique_ptr<Project> project = openProject();
+  Board* board = project->getBoards().first();
+  const QStringList expected = runFullCheck(*board);
+  BoardBackgroundDrc drc;
+  EXPECT_EQ(expected, runBackgroundCheck(drc, *board));
+
+  // Second run is incremental without any modifications.
+  drc.invalidate();
+  EXPECT_EQ(expected, runBackgroundCheck(drc, *board));
+}
+
+TEST_F(BoardBackgroundDrcTest, testIncrementalCheckAfterModification) {
+  std::unique_ptr<Project> project = openProject();
+  Board* board = project->getBoards().first();
+  runFullCheck(*board);  // Rebuild planes.
+  BoardBackgroundDrc drc;
+  runBackgroundCheck(drc, *board);
+
+  // Move some devices to create or remove violations.
+  int i = 0;
+  foreach (BI_Device* device, board->getDeviceInstances()) {
+    if ((i++ % 3) == 0) {
+      device->setPosition(device->getPosition() + Point(1000000, 500000));
+    }
+  }
+
+  // The full check also rebuilds the planes, so the incremental check will
+  // see modified devices as well as modified planes.
+  const QStringList expected = runFullCheck(*board);
+  drc.invalidate();
+  EXPECT_EQ(expected, runBackgroundCheck(drc, *board));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
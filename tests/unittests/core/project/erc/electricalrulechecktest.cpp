@@ -0,0 +1,173 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../testhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/erc/projectbackgrounderc.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ElectricalRuleCheckTest : public ::testing::Test {
+protected:
+  typedef ElectricalRuleCheck::Data Data;
+
+  static std::unique_ptr<Project> openProject() {
+    FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());  // can throw
+  }
+
+  static std::shared_ptr<Data> createData() {
+    const Uuid net1 = Uuid::createRandom();
+    const Uuid net2 = Uuid::createRandom();
+    std::shared_ptr<Data> data = std::make_shared<Data>();
+    data->netClasses.append(
+        ElectricalRuleCheck::NetClassData{Uuid::createRandom(), "A", true});
+    data->netClasses.append(
+        ElectricalRuleCheck::NetClassData{Uuid::createRandom(), "B", false});
+    data->netSignals.append(ElectricalRuleCheck::NetSignalData{net1, "N1", 2});
+    data->netSignals.append(ElectricalRuleCheck::NetSignalData{net2, "N2", 1});
+    for (int i = 0; i < 3; ++i) {
+      ElectricalRuleCheck::ComponentData cmp{
+          Uuid::createRandom(), QString("U%1").arg(i), {}, {}};
+      cmp.componentSignals.append(ElectricalRuleCheck::ComponentSignalData{
+          Uuid::createRandom(), "VCC", true, false, QString(), false,
+          QString()});
+      cmp.gates.append(ElectricalRuleCheck::GateData{Uuid::createRandom(),
+                                                     "A", true, true});
+      data->components.append(cmp);
+    }
+    for (int i = 0; i < 2; ++i) {
+      ElectricalRuleCheck::SchematicData schematic{Uuid::createRandom(), {},
+                                                   {}};
+      schematic.netSegments.append(ElectricalRuleCheck::NetSegmentData{
+          Uuid::createRandom(), (i == 0) ? net1 : net2, (i == 0) ? "N1" : "N2",
+          false, true, {}});
+      data->schematics.append(schematic);
+    }
+    return data;
+  }
+
+  static QStringList str(const RuleCheckMessageList& messages) {
+    QStringList list;
+    foreach (const auto& msg, messages) {
+      list.append(msg->getMessage() + " " +
+                  QString::fromUtf8(msg->getApproval().toByteArray()));
+    }
+    return list;
+  }
+
+  static QStringList runBackgroundCheck(ProjectBackgroundErc& erc,
+                                        const Project& project) {
+    QStringList messages;
+    bool finished = false;
+    QMetaObject::Connection connection = QObject::connect(
+        &erc, &ProjectBackgroundErc::messagesUpdated,
+        [&](const RuleCheckMessageList& list) {
+          messages = str(list);
+          finished = true;
+        });
+    erc.start(project);  // can throw
+    EXPECT_TRUE(TestHelpers::waitFor([&]() { return finished; }));
+    QObject::disconnect(connection);
+    return messages;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ElectricalRuleCheckTest, testFullCheck) {
+  auto result = ElectricalRuleCheck::run(createData(), nullptr);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(7, result->checkedObjects);
+  // Unused net class, open net, 3 unconnected signals, 1 open wire (the other
+  // one is in the open net).
+  EXPECT_EQ(6, result->messages.count());
+}
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalCheckWithoutModifications) {
+  std::shared_ptr<Data> data = createData();
+  auto previous = ElectricalRuleCheck::run(data, nullptr);
+  auto result = ElectricalRuleCheck::run(std::make_shared<Data>(*data),
+                                         previous);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(0, result->checkedObjects);
+  EXPECT_EQ(str(previous->messages), str(result->messages));
+}
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalCheckAfterModification) {
+  std::shared_ptr<Data> data = createData();
+  auto previous = ElectricalRuleCheck::run(data, nullptr);
+
+  // Connect a signal of one component, and fix the open net. The latter
+  // affects the schematic containing a segment of that net as well.
+  std::shared_ptr<Data> modified = std::make_shared<Data>(*data);
+  modified->components[1].componentSignals[0].hasNet = true;
+  modified->components[1].componentSignals[0].netName = "N2";
+  modified->netSignals[1].realComponentSignalCount = 2;
+  auto result = ElectricalRuleCheck::run(modified, previous);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(3, result->checkedObjects);
+  EXPECT_EQ(str(ElectricalRuleCheck::run(modified, nullptr)->messages),
+            str(result->messages));
+}
+
+TEST_F(ElectricalRuleCheckTest, testBackgroundCheckSameResultAsFullCheck) {
+  std::unique_ptr<Project> project = openProject();
+  const QStringList expected =
+      str(ElectricalRuleCheck(*project).runChecks());
+  ProjectBackgroundErc erc;
+  EXPECT_EQ(expected, runBackgroundCheck(erc, *project));
+
+  // Second run is incremental without any modifications.
+  erc.invalidate();
+  EXPECT_EQ(expected, runBackgroundCheck(erc, *project));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
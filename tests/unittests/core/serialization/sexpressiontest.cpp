@@ -100,6 +100,35 @@ TEST(SExpressionTest, testParseStringWithBackslash) {
   EXPECT_EQ("foo\\bar", s.getChild("@0").getValue());
 }
 
+TEST(SExpressionTest, testParseStringWithUnicode) {
+  const QString input = "(test \"Ω 5µm\\n°C\") ; ümlaut comment";
+  SExpression s = SExpression::parse(input.toUtf8(), FilePath());
+  EXPECT_EQ(QString("Ω 5µm\n°C").toStdString(),
+            s.getChild("@0").getValue().toStdString());
+}
+
+TEST(SExpressionTest, testParseStringWithLegacyEscapeSequences) {
+  SExpression s =
+      SExpression::parse("(test \"\\'\\?\\a\\b\\f\\r\\t\\v\")", FilePath());
+  EXPECT_EQ("'?\a\b\f\r\t\v", s.getChild("@0").getValue().toStdString());
+}
+
+TEST(SExpressionTest, testParseStringWithIllegalEscapeSequence) {
+  EXPECT_THROW(SExpression::parse("(test \"foo\\x\")", FilePath()),
+               RuntimeError);
+}
+
+TEST(SExpressionTest, testParseNonAsciiToken) {
+  EXPECT_THROW(SExpression::parse(QString("(test µ)").toUtf8(), FilePath()),
+               RuntimeError);
+}
+
+TEST(SExpressionTest, testParseWithByteOrderMark) {
+  SExpression s = SExpression::parse("\xEF\xBB\xBF(test foo)\n", FilePath());
+  EXPECT_EQ("test", s.getName().toStdString());
+  EXPECT_EQ("foo", s.getChild("@0").getValue().toStdString());
+}
+
 TEST(SExpressionTest, testParseExpressionWithChildrenAndComments) {
   QByteArray input =
       "; (This whole line is a comment with CRLF line ending)\r\n"
@@ -216,6 +245,72 @@ TEST(SExpressionTest, testGetChildSkipsLineBreaks) {
   EXPECT_EQ("2", s.getChild("child/@2").getValue().toStdString());
 }
 
+TEST(SExpressionTest, testGetChildWithChildPath) {
+  const SExpression s = SExpression::parse(
+      "(root (grid (type lines) (interval 0.15875)) (name \"foo\"))",
+      FilePath());
+  const SExpression::ChildPath path("grid/interval/@0");
+  EXPECT_EQ("grid/interval/@0", path.toString().toStdString());
+  EXPECT_EQ("0.15875", s.getChild(path).getValue().toStdString());
+  EXPECT_EQ("foo", s.getChild(SExpression::ChildPath("name/@0"))
+                       .getValue()
+                       .toStdString());
+  EXPECT_EQ(nullptr, s.tryGetChild(SExpression::ChildPath("grid/@2")));
+  EXPECT_EQ(nullptr, s.tryGetChild(SExpression::ChildPath("grid/@x")));
+  EXPECT_EQ(nullptr, s.tryGetChild(SExpression::ChildPath("grid/foo")));
+  EXPECT_THROW(s.getChild(SExpression::ChildPath("bar")), RuntimeError);
+}
+
+TEST(SExpressionTest, testGetChildOfLargeList) {
+  // Create a list large enough to get indexed.
+  QByteArray input = "(root\n";
+  for (int i = 0; i < 100; ++i) {
+    input += " (item " + QByteArray::number(i) + ")\n";
+    input += " (other " + QByteArray::number(i) + ")\n";
+  }
+  input += ")\n";
+  const SExpression s = SExpression::parse(input, FilePath());
+  EXPECT_EQ(100, s.getChildren("item").count());
+  EXPECT_EQ("42", s.getChildren("item").at(42)->getChild("@0").getValue());
+  EXPECT_EQ("0", s.getChild("other/@0").getValue().toStdString());
+  EXPECT_EQ("item", s.getChild("@0").getName().toStdString());
+  EXPECT_EQ("other", s.getChild("@199").getName().toStdString());
+  EXPECT_EQ(nullptr, s.tryGetChild("@200"));
+  EXPECT_EQ(nullptr, s.tryGetChild("foo"));
+
+  // Modifications must be taken into account.
+  SExpression copy = s;
+  copy.getChild("@0").setName("foo");
+  copy.appendChild("item", SExpression::createToken("100"));
+  EXPECT_EQ(100, copy.getChildren("item").count());
+  EXPECT_EQ("1", copy.getChild("item/@0").getValue().toStdString());
+  EXPECT_EQ("0", copy.getChild("foo/@0").getValue().toStdString());
+  EXPECT_EQ(100, s.getChildren("item").count());
+  EXPECT_EQ("0", s.getChild("item/@0").getValue().toStdString());
+}
+
+TEST(SExpressionTest, testModifyChildOfIndexedList) {
+  QByteArray input = "(root\n";
+  for (int i = 0; i < 100; ++i) {
+    input += " (item " + QByteArray::number(i) + ")\n";
+  }
+  input += ")\n";
+  SExpression s = SExpression::parse(input, FilePath());
+
+  // Children obtained before the parent gets indexed by a const lookup must
+  // still be safe to modify afterwards.
+  SExpression& first = s.getChild("@0");
+  SExpression& last = s.getChild("@99");
+  const SExpression& constS = s;
+  EXPECT_EQ(100, constS.getChildren("item").count());
+  first.setName("foo");
+  last = SExpression::createLineBreak();
+  EXPECT_EQ(98, constS.getChildren("item").count());
+  EXPECT_EQ("0", constS.getChild("foo/@0").getValue().toStdString());
+  EXPECT_EQ("1", constS.getChild("item/@0").getValue().toStdString());
+  EXPECT_EQ(nullptr, constS.tryGetChild("@99"));
+}
+
 TEST(SExpressionTest, testRemoveChild) {
   const QByteArray input =
       "(test value\n"
@@ -145,6 +145,20 @@ TEST_P(UuidTest, testOperatorComparisons) {
   }
 }
 
+TEST_P(UuidTest, testQHash) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    Uuid uuid1 = Uuid::fromString(data.uuid);
+    Uuid uuid2 = Uuid::fromString(data.uuid);
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+    EXPECT_EQ(qHash(tl::make_optional(uuid1), 42), qHash(uuid2, 42));
+    QHash<Uuid, int> hash;
+    hash.insert(uuid1, 1);
+    EXPECT_TRUE(hash.contains(uuid2));
+  }
+}
+
 TEST(UuidTest, testCreateRandom) {
   for (int i = 0; i < 1000; i++) {
     Uuid uuid = Uuid::createRandom();
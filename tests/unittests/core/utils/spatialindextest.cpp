@@ -0,0 +1,144 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/spatialindex.h>
+
+#include <QtCore>
+
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SpatialIndexTest : public ::testing::Test {
+protected:
+  static QVector<SpatialIndex::Rect> createRandomRects(int count,
+                                                       quint32 seed) {
+    std::mt19937 rng(seed);
+    QVector<SpatialIndex::Rect> rects;
+    for (int i = 0; i < count; ++i) {
+      if ((i % 50) == 7) {
+        rects.append(SpatialIndex::emptyRect());
+      } else {
+        const qint64 x = static_cast<qint64>(rng() % 100000) - 50000;
+        const qint64 y = static_cast<qint64>(rng() % 100000) - 50000;
+        const qint64 w = static_cast<qint64>(rng() % 2000);
+        const qint64 h = static_cast<qint64>(rng() % 2000);
+        rects.append(SpatialIndex::Rect{x, y, x + w, y + h});
+      }
+    }
+    return rects;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SpatialIndexTest, testEmpty) {
+  const SpatialIndex index;
+  EXPECT_EQ(0, index.getCount());
+  EXPECT_EQ(QVector<int>{}, index.find(SpatialIndex::Rect{-10, -10, 10, 10}));
+  EXPECT_TRUE(index.findIntersectingPairs().isEmpty());
+}
+
+TEST_F(SpatialIndexTest, testBoundingRect) {
+  const ClipperLib::Paths paths = {
+      {ClipperLib::IntPoint(10, 20), ClipperLib::IntPoint(-5, 30)},
+      {},
+      {ClipperLib::IntPoint(0, -40)},
+  };
+  const SpatialIndex::Rect rect = SpatialIndex::boundingRect(paths);
+  EXPECT_EQ(-5, rect.left);
+  EXPECT_EQ(-40, rect.top);
+  EXPECT_EQ(10, rect.right);
+  EXPECT_EQ(30, rect.bottom);
+  EXPECT_TRUE(
+      SpatialIndex::isEmpty(SpatialIndex::boundingRect(ClipperLib::Paths())));
+}
+
+TEST_F(SpatialIndexTest, testTouchingRectsIntersect) {
+  const SpatialIndex index(QVector<SpatialIndex::Rect>{
+      SpatialIndex::Rect{0, 0, 10, 10},
+      SpatialIndex::Rect{10, 10, 20, 20},
+      SpatialIndex::Rect{21, 21, 30, 30},
+  });
+  EXPECT_EQ((QVector<int>{0, 1}), index.find(ClipperLib::IntPoint(10, 10)));
+  EXPECT_EQ((QVector<int>{2}), index.find(ClipperLib::IntPoint(25, 25)));
+  const QVector<std::pair<int, int>> expected = {std::make_pair(0, 1)};
+  EXPECT_EQ(expected, index.findIntersectingPairs());
+}
+
+TEST_F(SpatialIndexTest, testEmptyRectsNeverIntersect) {
+  const SpatialIndex index(QVector<SpatialIndex::Rect>{
+      SpatialIndex::emptyRect(),
+      SpatialIndex::Rect{0, 0, 10, 10},
+  });
+  EXPECT_EQ((QVector<int>{1}), index.find(SpatialIndex::Rect{-5, -5, 5, 5}));
+  EXPECT_EQ(QVector<int>{}, index.find(SpatialIndex::emptyRect()));
+  EXPECT_TRUE(index.findIntersectingPairs().isEmpty());
+}
+
+TEST_F(SpatialIndexTest, testFindMatchesBruteForce) {
+  const QVector<SpatialIndex::Rect> rects = createRandomRects(3000, 42);
+  const SpatialIndex index(rects);
+  const QVector<SpatialIndex::Rect> queries = createRandomRects(100, 1337);
+  foreach (const SpatialIndex::Rect& query, queries) {
+    QVector<int> expected;
+    for (int i = 0; i < rects.count(); ++i) {
+      if (SpatialIndex::intersects(rects.at(i), query)) {
+        expected.append(i);
+      }
+    }
+    EXPECT_EQ(expected, index.find(query));
+  }
+}
+
+TEST_F(SpatialIndexTest, testFindIntersectingPairsMatchesBruteForce) {
+  const QVector<SpatialIndex::Rect> rects = createRandomRects(3000, 42);
+  QVector<std::pair<int, int>> expected;
+  for (int i = 0; i < rects.count(); ++i) {
+    for (int k = i + 1; k < rects.count(); ++k) {
+      if (SpatialIndex::intersects(rects.at(i), rects.at(k))) {
+        expected.append(std::make_pair(i, k));
+      }
+    }
+  }
+  EXPECT_FALSE(expected.isEmpty());
+  EXPECT_EQ(expected, SpatialIndex(rects).findIntersectingPairs());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
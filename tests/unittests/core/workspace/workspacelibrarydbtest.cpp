@@ -94,6 +94,22 @@ protected:
 
   FilePath toAbs(const QString& fp) { return mWsDir.getPathTo(fp); }
 
+  bool hasFullTextIndex() {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT COUNT(*) FROM sqlite_master "
+        "WHERE type = 'table' AND name = 'parts_fts'");
+    mDb->exec(query);
+    return query.next() && (query.value(0).toInt() > 0);
+  }
+
+  bool hasTrigramIndex() {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT sql FROM sqlite_master "
+        "WHERE type = 'table' AND name = 'parts_fts'");
+    mDb->exec(query);
+    return query.next() && query.value(0).toString().contains("trigram");
+  }
+
   Uuid uuid(int index = -1) {
     static QHash<int, Uuid> cache;
     if (index >= 0) {
@@ -311,6 +327,86 @@ TEST_F(WorkspaceLibraryDbTest, testGetLatest) {
   EXPECT_EQ(str(toAbs("sym3")), str(mWsDb->getLatest<Symbol>(uuid(0))));
 }
 
+/*******************************************************************************
+ *  Tests for getLatestInfos()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testGetLatestInfosEmptyDb) {
+  EXPECT_EQ(0, mWsDb->getLatestInfos<Symbol>({uuid()}, {}).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetLatestInfos) {
+  int sym = mWriter->addElement<Symbol>(0, toAbs("sym1"), uuid(0),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("old"), "", "");
+  sym = mWriter->addElement<Symbol>(0, toAbs("sym2"), uuid(0), version("0.2"),
+                                    true);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("default"), "", "");
+  mWriter->addTranslation<Symbol>(sym, "de_CH", ElementName("german"), "", "");
+  sym = mWriter->addElement<Symbol>(0, toAbs("sym3"), uuid(1), version("0.1"),
+                                    false);
+  mWriter->addElement<Symbol>(0, toAbs("sym4"), uuid(2), version("0.1"),
+                              false);
+
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+      mWsDb->getLatestInfos<Symbol>({uuid(0), uuid(1), uuid()}, {"de_CH"});
+  EXPECT_EQ(str(QSet<Uuid>{uuid(0), uuid(1)}), str(infos.keys().toSet()));
+  EXPECT_EQ(str(toAbs("sym2")), str(infos[uuid(0)].filePath));
+  EXPECT_EQ("german", infos[uuid(0)].name.toStdString());
+  EXPECT_TRUE(infos[uuid(0)].deprecated);
+  EXPECT_FALSE(infos[uuid(0)].componentUuid);
+  EXPECT_FALSE(infos[uuid(0)].packageUuid);
+  EXPECT_EQ(str(toAbs("sym3")), str(infos[uuid(1)].filePath));
+  EXPECT_EQ("", infos[uuid(1)].name.toStdString());
+  EXPECT_FALSE(infos[uuid(1)].deprecated);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetLatestInfosEqualVersions) {
+  // The element with the lowest filepath wins, independent of insert order.
+  mWriter->addElement<Symbol>(0, toAbs("b/sym"), uuid(0), version("0.1"),
+                              false);
+  mWriter->addElement<Symbol>(0, toAbs("a/sym"), uuid(0), version("0.1"),
+                              false);
+  mWriter->addElement<Symbol>(0, toAbs("c/sym"), uuid(0), version("0.1"),
+                              false);
+  mWriter->addElement<Symbol>(0, toAbs("a/sym2"), uuid(1), version("0.1"),
+                              false);
+  mWriter->addElement<Symbol>(0, toAbs("b/sym2"), uuid(1), version("0.1"),
+                              false);
+
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+      mWsDb->getLatestInfos<Symbol>({uuid(0), uuid(1)}, {});
+  ASSERT_EQ(2, infos.count());
+  EXPECT_EQ(str(toAbs("a/sym")), str(infos[uuid(0)].filePath));
+  EXPECT_EQ(str(toAbs("a/sym2")), str(infos[uuid(1)].filePath));
+  EXPECT_EQ(str(toAbs("a/sym")), str(mWsDb->getLatest<Symbol>(uuid(0))));
+  EXPECT_EQ(str(toAbs("a/sym2")), str(mWsDb->getLatest<Symbol>(uuid(1))));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetLatestInfosOfDevice) {
+  int dev = mWriter->addDevice(0, toAbs("dev"), uuid(0), version("0.1"), false,
+                               uuid(1), uuid(2));
+  mWriter->addTranslation<Device>(dev, "", ElementName("foo"), "", "");
+
+  const QHash<Uuid, WorkspaceLibraryDb::ElementInfo> infos =
+      mWsDb->getLatestInfos<Device>({uuid(0)}, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(str(toAbs("dev")), str(infos[uuid(0)].filePath));
+  EXPECT_EQ("foo", infos[uuid(0)].name.toStdString());
+  EXPECT_EQ(str(uuid(1)), str(*infos[uuid(0)].componentUuid));
+  EXPECT_EQ(str(uuid(2)), str(*infos[uuid(0)].packageUuid));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetLatestInfosManyElements) {
+  QList<Uuid> uuids;
+  for (int i = 0; i < 1200; ++i) {
+    uuids.append(uuid());
+    mWriter->addElement<Package>(0, toAbs(QString("pkg%1").arg(i)),
+                                 uuids.last(), version("0.1"), false);
+  }
+  EXPECT_EQ(uuids.count(), mWsDb->getLatestInfos<Package>(uuids, {}).count());
+}
+
 /*******************************************************************************
  *  Tests for find()
  ******************************************************************************/
@@ -405,6 +501,144 @@ TEST_F(WorkspaceLibraryDbTest, testFindWithMultipleTranslations) {
             str(mWsDb->find<Symbol>("sym1 en_US name")));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testFindSubstring) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym1 name"),
+                                  "the sym1 desc", "the sym1 keywords");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym2 name"),
+                                  "the sym2 desc", "the sym2 keywords");
+
+  // Not the beginning of a word, thus requires the substring search.
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("ym2 nam")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->find<Symbol>("eyword")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindSubstringAfterWordMatches) {
+  if (!hasTrigramIndex()) {
+    GTEST_SKIP();
+  }
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int pkg = mWriter->addElement<Package>(lib, toAbs("pkg1"), uuid(1),
+                                         version("0.1"), false);
+  mWriter->addTranslation<Package>(pkg, "", ElementName("R0603"), "", "");
+  pkg = mWriter->addElement<Package>(lib, toAbs("pkg2"), uuid(2),
+                                     version("0.1"), false);
+  mWriter->addTranslation<Package>(pkg, "", ElementName("0603"), "", "");
+
+  // Elements containing the keyword not at the beginning of a word must be
+  // found even if other elements contain it at the beginning of a word. This
+  // requires the trigram index since the search without index is used only
+  // if the index did not find anything.
+  EXPECT_EQ(str(QList<Uuid>{uuid(2), uuid(1)}),
+            str(mWsDb->find<Package>("0603")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindByUuid) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym1 name"),
+                                  "the sym1 desc", "the sym1 keywords");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym2 name"),
+                                  "the sym2 desc", "the sym2 keywords");
+
+  // UUIDs are not contained in the index, thus requires the search without
+  // index.
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}),
+            str(mWsDb->find<Symbol>(uuid(2).toStr())));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindWordsInAnyOrder) {
+  if (!hasFullTextIndex()) {
+    GTEST_SKIP();
+  }
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym1 name"),
+                                  "the sym1 desc", "the sym1 keywords");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym2 name"),
+                                  "the sym2 desc", "the sym2 keywords");
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("NAM SYM2")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Symbol>("key, sym1")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindSortedByRelevance) {
+  if (!hasFullTextIndex()) {
+    GTEST_SKIP();
+  }
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("Capacitor"), "",
+                                  "resistor");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("Resistor"), "", "");
+
+  // Matches in names are more relevant than matches in keywords.
+  EXPECT_EQ(str(QList<Uuid>{uuid(2), uuid(1)}),
+            str(mWsDb->find<Symbol>("resistor")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindAfterRemovingElement) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym1 name"),
+                                  "the sym1 desc", "the sym1 keywords");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym2 name"),
+                                  "the sym2 desc", "the sym2 keywords");
+  mWriter->removeElement<Symbol>(toAbs("sym1"));
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("name")));
+}
+
+/*******************************************************************************
+ *  Tests for findDevicesOfParts()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testFindDevicesOfParts) {
+  int dev1 = mWriter->addDevice(0, toAbs("dev1"), uuid(1), version("0.1"),
+                                false, uuid(), uuid());
+  mWriter->addTranslation<Device>(dev1, "", ElementName("dev1"), "", "");
+  mWriter->addPart(dev1, "LM317", "Texas Instruments");
+  int dev2 = mWriter->addDevice(0, toAbs("dev2"), uuid(2), version("0.1"),
+                                false, uuid(), uuid());
+  mWriter->addTranslation<Device>(dev2, "", ElementName("dev2"), "", "");
+  mWriter->addPart(dev2, "LM358", "Texas Instruments");
+  mWriter->addPart(dev2, "NE555", "STMicroelectronics");
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->findDevicesOfParts("lm31")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->findDevicesOfParts("lm3")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->findDevicesOfParts("317")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->findDevicesOfParts("m3")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->findDevicesOfParts("texas")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->findDevicesOfParts("555")));
+  EXPECT_EQ(str(QList<Uuid>{}), str(mWsDb->findDevicesOfParts("foo")));
+}
+
 /*******************************************************************************
  *  Tests for getTranslations()
  ******************************************************************************/
@@ -1012,6 +1246,48 @@ TEST_F(WorkspaceLibraryDbTest, testGetComponentDevicesDuplicates) {
   EXPECT_EQ(str(QSet<Uuid>{uuid(1)}), str(mWsDb->getComponentDevices(uuid(0))));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testGetComponentDevicesOfMultipleComponents) {
+  mWriter->addDevice(0, toAbs("dev1"), uuid(1), version("0.1"), false, uuid(0),
+                     uuid());
+  mWriter->addDevice(0, toAbs("dev2"), uuid(2), version("0.1"), false, uuid(0),
+                     uuid());
+  mWriter->addDevice(0, toAbs("dev3"), uuid(3), version("0.1"), false, uuid(4),
+                     uuid());
+  mWriter->addDevice(0, toAbs("dev4"), uuid(5), version("0.1"), false, uuid(),
+                     uuid());
+
+  const QHash<Uuid, QSet<Uuid>> devices =
+      mWsDb->getComponentDevices(QList<Uuid>{uuid(0), uuid(4), uuid(6)});
+  EXPECT_EQ(str(QSet<Uuid>{uuid(0), uuid(4)}), str(devices.keys().toSet()));
+  EXPECT_EQ(str(QSet<Uuid>{uuid(1), uuid(2)}), str(devices.value(uuid(0))));
+  EXPECT_EQ(str(QSet<Uuid>{uuid(3)}), str(devices.value(uuid(4))));
+}
+
+/*******************************************************************************
+ *  Tests for WorkspaceLibraryDbWriter::setElementFingerprint()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testSetElementFingerprint) {
+  int sym1 = mWriter->addElement<Symbol>(0, toAbs("sym1"), uuid(),
+                                         version("0.1"), false);
+  int sym2 = mWriter->addElement<Symbol>(0, toAbs("sym2"), uuid(),
+                                         version("0.1"), false);
+  mWriter->setElementFingerprint<Symbol>(sym2, "fingerprint", "hash");
+
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT id, fingerprint, content_hash FROM symbols ORDER BY id");
+  mDb->exec(query);
+  ASSERT_TRUE(query.next());
+  EXPECT_EQ(sym1, query.value(0).toInt());
+  EXPECT_TRUE(query.value(1).isNull());
+  EXPECT_TRUE(query.value(2).isNull());
+  ASSERT_TRUE(query.next());
+  EXPECT_EQ(sym2, query.value(0).toInt());
+  EXPECT_EQ("fingerprint", query.value(1).toString().toStdString());
+  EXPECT_EQ("hash", query.value(2).toString().toStdString());
+  EXPECT_FALSE(query.next());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,180 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../testhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/library.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/sqlitedatabase.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacelibraryscanner.h>
+
+#include <QSignalSpy>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryScannerTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  FilePath mLibDir;
+  std::unique_ptr<WorkspaceLibraryDb> mWsDb;
+  std::unique_ptr<WorkspaceLibraryScanner> mScanner;
+
+  WorkspaceLibraryScannerTest()
+    : mWsDir(FilePath::getRandomTempPath()),
+      mLibDir(mWsDir.getPathTo("local/Test.lplib")) {
+    FileUtils::makePath(mWsDir);
+    // Note: The database object creates the database file with all tables.
+    mWsDb.reset(new WorkspaceLibraryDb(mWsDir));
+    mScanner.reset(new WorkspaceLibraryScanner(mWsDir, mWsDb->getFilePath()));
+
+    // Create an empty library.
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(mLibDir);
+    TransactionalDirectory dir(fs);
+    Library lib(Uuid::createRandom(), Version::fromString("0.1"), "",
+                ElementName("Test"), "", "");
+    lib.saveTo(dir);
+    fs->save();
+  }
+
+  virtual ~WorkspaceLibraryScannerTest() {
+    mScanner.reset();
+    mWsDb.reset();
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  FilePath createSymbol(const Uuid& uuid, const QString& name) {
+    const FilePath fp = mLibDir.getPathTo("sym/" % uuid.toStr());
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(fp);
+    TransactionalDirectory dir(fs);
+    Symbol sym(uuid, Version::fromString("0.1"), "", ElementName(name), "",
+               "");
+    sym.saveTo(dir);
+    fs->save();
+    return fp;
+  }
+
+  void renameSymbol(const FilePath& fp, const QString& name) {
+    std::unique_ptr<Symbol> sym = Symbol::open(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(fp))));
+    sym->setNames(LocalizedNameMap(ElementName(name)));
+    sym->save();
+    sym->getDirectory().getFileSystem()->save();
+  }
+
+  void setNameInDb(const FilePath& fp, const QString& name) {
+    SQLiteDatabase db(mWsDb->getFilePath());
+    QSqlQuery query = db.prepareQuery(
+        "UPDATE symbols_tr SET name = :name WHERE element_id = "
+        "(SELECT id FROM symbols WHERE filepath = :filepath)");
+    query.bindValue(":name", name);
+    query.bindValue(":filepath", fp.toRelative(mWsDir));
+    db.exec(query);
+  }
+
+  std::string getNameFromDb(const FilePath& fp) {
+    QString name;
+    mWsDb->getTranslations<Symbol>(fp, {}, &name);
+    return name.toStdString();
+  }
+
+  int scan() {
+    QSignalSpy spySucceeded(mScanner.get(), SIGNAL(scanSucceeded(int)));
+    QSignalSpy spyFinished(mScanner.get(), SIGNAL(scanFinished()));
+    mScanner->startScan();
+    EXPECT_TRUE(
+        TestHelpers::waitFor([&]() { return !spyFinished.isEmpty(); }, 30000));
+    EXPECT_EQ(1, spyFinished.count());
+    EXPECT_EQ(1, spySucceeded.count());
+    return spySucceeded.isEmpty() ? -1 : spySucceeded.first()[0].toInt();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryScannerTest, testAddedElementsAreAdded) {
+  const FilePath sym1 = createSymbol(Uuid::createRandom(), "Symbol 1");
+  const FilePath sym2 = createSymbol(Uuid::createRandom(), "Symbol 2");
+  EXPECT_EQ(2, scan());
+  EXPECT_EQ(2, mWsDb->getAll<Symbol>().count());
+  EXPECT_EQ("Symbol 1", getNameFromDb(sym1));
+  EXPECT_EQ("Symbol 2", getNameFromDb(sym2));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testUnchangedElementsAreSkipped) {
+  const FilePath sym = createSymbol(Uuid::createRandom(), "Symbol");
+  EXPECT_EQ(1, scan());
+
+  // If the element gets parsed again, the name in the database is restored.
+  setNameInDb(sym, "Not parsed again");
+  EXPECT_EQ(1, scan());
+  EXPECT_EQ("Not parsed again", getNameFromDb(sym));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testModifiedElementsAreParsedAgain) {
+  const FilePath sym1 = createSymbol(Uuid::createRandom(), "Symbol 1");
+  const FilePath sym2 = createSymbol(Uuid::createRandom(), "Symbol 2");
+  EXPECT_EQ(2, scan());
+
+  setNameInDb(sym2, "Not parsed again");
+  renameSymbol(sym1, "Modified Symbol 1");
+  EXPECT_EQ(2, scan());
+  EXPECT_EQ(2, mWsDb->getAll<Symbol>().count());
+  EXPECT_EQ("Modified Symbol 1", getNameFromDb(sym1));
+  EXPECT_EQ("Not parsed again", getNameFromDb(sym2));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testRemovedElementsAreRemoved) {
+  const FilePath sym1 = createSymbol(Uuid::createRandom(), "Symbol 1");
+  const FilePath sym2 = createSymbol(Uuid::createRandom(), "Symbol 2");
+  EXPECT_EQ(2, scan());
+
+  FileUtils::removeDirRecursively(sym1);
+  EXPECT_EQ(1, scan());
+  EXPECT_EQ(1, mWsDb->getAll<Symbol>().count());
+  EXPECT_EQ("", getNameFromDb(sym1));
+  EXPECT_EQ("Symbol 2", getNameFromDb(sym2));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb